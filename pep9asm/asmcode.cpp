@@ -652,6 +652,71 @@ QString BlankLine::getAssemblerSource() const
     return "";
 }
 
+AsmCode *UnaryInstruction::cloneAsmCode() const
+{
+    return new UnaryInstruction(*this);
+}
+
+AsmCode *NonUnaryInstruction::cloneAsmCode() const
+{
+    return new NonUnaryInstruction(*this);
+}
+
+AsmCode *DotAddrss::cloneAsmCode() const
+{
+    return new DotAddrss(*this);
+}
+
+AsmCode *DotAlign::cloneAsmCode() const
+{
+    return new DotAlign(*this);
+}
+
+AsmCode *DotAscii::cloneAsmCode() const
+{
+    return new DotAscii(*this);
+}
+
+AsmCode *DotBlock::cloneAsmCode() const
+{
+    return new DotBlock(*this);
+}
+
+AsmCode *DotBurn::cloneAsmCode() const
+{
+    return new DotBurn(*this);
+}
+
+AsmCode *DotByte::cloneAsmCode() const
+{
+    return new DotByte(*this);
+}
+
+AsmCode *DotEnd::cloneAsmCode() const
+{
+    return new DotEnd(*this);
+}
+
+AsmCode *DotEquate::cloneAsmCode() const
+{
+    return new DotEquate(*this);
+}
+
+AsmCode *DotWord::cloneAsmCode() const
+{
+    return new DotWord(*this);
+}
+
+AsmCode *CommentOnly::cloneAsmCode() const
+{
+    return new CommentOnly(*this);
+}
+
+AsmCode *BlankLine::cloneAsmCode() const
+{
+    return new BlankLine(*this);
+}
+
 quint16 UnaryInstruction::objectCodeLength() const
 {
     return 1;
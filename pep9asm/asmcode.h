@@ -67,6 +67,9 @@ public:
     virtual void setBreakpoint(bool) {}
     virtual bool hasSymbolicOperand() const {return false;}
     virtual QSharedPointer<const SymbolEntry> getSymbolicOperand() const { return nullptr;}
+    // Return a copy of this line of code, which shares its arguments with this line.
+    // Arguments are never modified once created, so they may be shared.
+    virtual AsmCode* cloneAsmCode() const = 0;
 protected:
     int sourceCodeLine, memAddress =-1;
     QSharedPointer<SymbolEntry> symbolEntry;
@@ -90,6 +93,7 @@ public:
     // AsmCode interface
     virtual QString getAssemblerListing() const override;
     virtual QString getAssemblerSource() const override;
+    virtual AsmCode* cloneAsmCode() const override;
     virtual quint16 objectCodeLength() const override;
     virtual bool hasBreakpoint() const override;
     virtual void setBreakpoint(bool b) override;
@@ -112,6 +116,7 @@ public:
     // AsmCode interface
     virtual QString getAssemblerListing() const override;
     virtual QString getAssemblerSource() const override;
+    virtual AsmCode* cloneAsmCode() const override;
     virtual quint16 objectCodeLength() const override;
     virtual bool hasBreakpoint() const override;
     virtual void setBreakpoint(bool b) override;
@@ -132,6 +137,7 @@ public:
     // AsmCode interface
     virtual QString getAssemblerListing() const override;
     virtual QString getAssemblerSource() const override;
+    virtual AsmCode* cloneAsmCode() const override;
     virtual quint16 objectCodeLength() const override;
     bool hasSymbolicOperand() const override;
     QSharedPointer<const SymbolEntry> getSymbolicOperand() const override;
@@ -150,6 +156,7 @@ public:
     // AsmCode interface
     virtual QString getAssemblerListing() const override;
     virtual QString getAssemblerSource() const override;
+    virtual AsmCode* cloneAsmCode() const override;
     virtual quint16 objectCodeLength() const override;
 
 };
@@ -166,6 +173,7 @@ public:
     // AsmCode interface
     virtual QString getAssemblerListing() const override;
     virtual QString getAssemblerSource() const override;
+    virtual AsmCode* cloneAsmCode() const override;
     virtual quint16 objectCodeLength() const override;
 };
 
@@ -180,6 +188,7 @@ public:
     // AsmCode interface
     virtual QString getAssemblerListing() const override;
     virtual QString getAssemblerSource() const override;
+    virtual AsmCode* cloneAsmCode() const override;
     virtual quint16 objectCodeLength() const override;
 };
 
@@ -193,6 +202,7 @@ public:
     // AsmCode interface
     virtual QString getAssemblerListing() const override;
     virtual QString getAssemblerSource() const override;
+    virtual AsmCode* cloneAsmCode() const override;
 };
 
 class DotByte: public AsmCode
@@ -207,6 +217,7 @@ public:
     // AsmCode interface
     virtual QString getAssemblerListing() const override;
     virtual QString getAssemblerSource() const override;
+    virtual AsmCode* cloneAsmCode() const override;
     virtual quint16 objectCodeLength() const override;
 };
 
@@ -218,6 +229,7 @@ public:
     // AsmCode interface
     virtual QString getAssemblerListing() const override;
     virtual QString getAssemblerSource() const override;
+    virtual AsmCode* cloneAsmCode() const override;
 };
 
 class DotEquate: public AsmCode
@@ -230,6 +242,7 @@ public:
     // AsmCode interface
     virtual QString getAssemblerListing() const override;
     virtual QString getAssemblerSource() const override;
+    virtual AsmCode* cloneAsmCode() const override;
 };
 
 class DotWord: public AsmCode
@@ -242,6 +255,7 @@ public:
     // AsmCode interface
     virtual QString getAssemblerListing() const override;
     virtual QString getAssemblerSource() const override;
+    virtual AsmCode* cloneAsmCode() const override;
     virtual quint16 objectCodeLength() const override;
 };
 
@@ -253,6 +267,7 @@ public:
     // AsmCode interface
     virtual QString getAssemblerListing() const override;
     virtual QString getAssemblerSource() const override;
+    virtual AsmCode* cloneAsmCode() const override;
 };
 
 class BlankLine: public AsmCode
@@ -263,6 +278,7 @@ public:
     // AsmCode interface
     virtual QString getAssemblerListing() const override;
     virtual QString getAssemblerSource() const override;
+    virtual AsmCode* cloneAsmCode() const override;
 };
 
 #endif // CODE_H
@@ -27,6 +27,7 @@
 #include <QtGlobal>
 #include "acpumodel.h"
 #include "interfaceisacpu.h"
+#include "simulationsnapshot.h"
 
 AsmCpuPane::AsmCpuPane(QWidget *parent) :
         QWidget(parent),
@@ -88,21 +89,43 @@ void AsmCpuPane::init(QSharedPointer<ACPUModel> cpu, QSharedPointer<InterfaceISA
 }
 
 void AsmCpuPane::updateCpu() {
-    Enu::EAddrMode addrMode = Pep::decodeAddrMode[acpu->getCPURegByteCurrent(Enu::CPURegisters::IS)];
-
-    ui->nLabel->setText(acpu->getStatusBitCurrent(Enu::EStatusBit::STATUS_N) ? "1" : "0");
-    ui->zLabel->setText(acpu->getStatusBitCurrent(Enu::EStatusBit::STATUS_Z) ? "1" : "0");
-    ui->vLabel->setText(acpu->getStatusBitCurrent(Enu::EStatusBit::STATUS_V) ? "1" : "0");
-    ui->cLabel->setText(acpu->getStatusBitCurrent(Enu::EStatusBit::STATUS_C) ? "1" : "0");
-
-    quint16 acc, idx, sp, pc, opsc;
-    quint8 is;
-    acc = acpu->getCPURegWordCurrent(Enu::CPURegisters::A);
-    idx = acpu->getCPURegWordCurrent(Enu::CPURegisters::X);
-    sp = acpu->getCPURegWordCurrent(Enu::CPURegisters::SP);
-    pc = acpu->getCPURegWordCurrent(Enu::CPURegisters::PC);
-    opsc = acpu->getCPURegWordCurrent(Enu::CPURegisters::OS);
-    is = acpu->getCPURegByteCurrent(Enu::CPURegisters::IS);
+    quint8 statusBits = 0;
+    for(auto bit : {Enu::EStatusBit::STATUS_N, Enu::EStatusBit::STATUS_Z, Enu::EStatusBit::STATUS_V, Enu::EStatusBit::STATUS_C}) {
+        if(acpu->getStatusBitCurrent(bit)) statusBits |= 1 << bit;
+    }
+    quint8 is = acpu->getCPURegByteCurrent(Enu::CPURegisters::IS);
+    setRegisterLabels(statusBits,
+                      acpu->getCPURegWordCurrent(Enu::CPURegisters::A),
+                      acpu->getCPURegWordCurrent(Enu::CPURegisters::X),
+                      acpu->getCPURegWordCurrent(Enu::CPURegisters::SP),
+                      acpu->getCPURegWordCurrent(Enu::CPURegisters::PC),
+                      acpu->getCPURegWordCurrent(Enu::CPURegisters::OS),
+                      is);
+
+    if(!Pep::isUnaryMap[Pep::decodeMnemonic[is]]) {
+        quint16 opVal = isacpu->getOperandValue();
+
+        if(Pep::operandDisplayFieldWidth(Pep::decodeMnemonic[is]) == 2) {
+            opVal &= 0xff;
+        }
+
+        ui->oprndHexLabel->setText(QString("0x") + QString("%1").arg(opVal,
+                                                     Pep::operandDisplayFieldWidth(Pep::decodeMnemonic[is]),
+                                                     16, QLatin1Char('0')).toUpper());
+        ui->oprndDecLabel->setText(QString("%1").arg(static_cast<qint16>(opVal)));
+    }
+}
+
+void AsmCpuPane::setRegisterLabels(quint8 statusBits, quint16 acc, quint16 idx, quint16 sp,
+                                   quint16 pc, quint16 opsc, quint8 is)
+{
+    Enu::EAddrMode addrMode = Pep::decodeAddrMode[is];
+
+    ui->nLabel->setText(statusBits & (1 << Enu::EStatusBit::STATUS_N) ? "1" : "0");
+    ui->zLabel->setText(statusBits & (1 << Enu::EStatusBit::STATUS_Z) ? "1" : "0");
+    ui->vLabel->setText(statusBits & (1 << Enu::EStatusBit::STATUS_V) ? "1" : "0");
+    ui->cLabel->setText(statusBits & (1 << Enu::EStatusBit::STATUS_C) ? "1" : "0");
+
     ui->accHexLabel->setText(QString("0x") + QString("%1").arg(acc, 4, 16, QLatin1Char('0')).toUpper());
     ui->accDecLabel->setText(QString("%1").arg(static_cast<qint16>(acc)));
 
@@ -137,17 +160,6 @@ void AsmCpuPane::updateCpu() {
         ui->oprndSpecHexLabel->setText(QString("0x") + QString("%1").arg(opsc, 4,
                                                                          16, QLatin1Char('0')).toUpper());
         ui->oprndSpecDecLabel->setText(QString("%1").arg(static_cast<qint16>(opsc)));
-
-        quint16 opVal = isacpu->getOperandValue();
-
-        if(Pep::operandDisplayFieldWidth(Pep::decodeMnemonic[is]) == 2) {
-            opVal &= 0xff;
-        }
-
-        ui->oprndHexLabel->setText(QString("0x") + QString("%1").arg(opVal,
-                                                     Pep::operandDisplayFieldWidth(Pep::decodeMnemonic[is]),
-                                                     16, QLatin1Char('0')).toUpper());
-        ui->oprndDecLabel->setText(QString("%1").arg(static_cast<qint16>(opVal)));
     }
 }
 
@@ -199,4 +211,23 @@ void AsmCpuPane::onSimulationUpdate()
     updateCpu();
 }
 
+void AsmCpuPane::onSimulationSnapshot(const SimulationSnapshot &snapshot)
+{
+    quint8 statusBits = 0;
+    for(auto bit : {Enu::EStatusBit::STATUS_N, Enu::EStatusBit::STATUS_Z, Enu::EStatusBit::STATUS_V, Enu::EStatusBit::STATUS_C}) {
+        if(snapshot.getStatusBit(bit)) statusBits |= 1 << bit;
+    }
+    quint8 is = snapshot.getRegisterByte(Enu::CPURegisters::IS);
+    setRegisterLabels(statusBits,
+                      snapshot.getRegisterWord(Enu::CPURegisters::A),
+                      snapshot.getRegisterWord(Enu::CPURegisters::X),
+                      snapshot.getRegisterWord(Enu::CPURegisters::SP),
+                      snapshot.getRegisterWord(Enu::CPURegisters::PC),
+                      snapshot.getRegisterWord(Enu::CPURegisters::OS),
+                      is);
+    // The decoded operand is only known to the CPU, so it is not part of a snapshot.
+    ui->oprndHexLabel->setText("");
+    ui->oprndDecLabel->setText("");
+}
+
 
@@ -30,6 +30,7 @@ namespace Ui {
 }
 class ACPUModel;
 class InterfaceISACPU;
+class SimulationSnapshot;
 class AsmCpuPane : public QWidget {
     Q_OBJECT
     Q_DISABLE_COPY(AsmCpuPane)
@@ -58,12 +59,17 @@ public:
 
 public slots:
     void onSimulationUpdate();
+    // Display the registers published by a CPU running on another thread.
+    void onSimulationSnapshot(const SimulationSnapshot& snapshot);
 
 private:
     Ui::AsmCpuPane *ui;
     QSharedPointer<ACPUModel> acpu;
     QSharedPointer<InterfaceISACPU> isacpu;
     bool inSimulation;
+    // Status bits are |'ed together as 1 << Enu::EStatusBit.
+    void setRegisterLabels(quint8 statusBits, quint16 acc, quint16 idx, quint16 sp,
+                           quint16 pc, quint16 opsc, quint8 is);
 
 };
 
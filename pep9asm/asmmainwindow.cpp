@@ -63,6 +63,7 @@
 #include "updatechecker.h"
 #include "redefinemnemonicsdialog.h"
 #include "registerfile.h"
+#include "simulationworker.h"
 #include "symboltable.h"
 
 AsmMainWindow::AsmMainWindow(QWidget *parent) :
@@ -70,7 +71,8 @@ AsmMainWindow::AsmMainWindow(QWidget *parent) :
     ui(new Ui::AsmMainWindow), debugState(DebugState::DISABLED), codeFont(QFont(Pep::codeFont, Pep::codeFontSize)),
     updateChecker(new UpdateChecker()), isInDarkMode(false),
     memDevice(new MainMemory(nullptr)), controlSection(new IsaCpu(AsmProgramManager::getInstance(), memDevice)),
-    redefineMnemonicsDialog(new RedefineMnemonicsDialog(this)),programManager(AsmProgramManager::getInstance())
+    simulationWorker(new SimulationWorker(controlSection, this)), redefineMnemonicsDialog(new RedefineMnemonicsDialog(this)),programManager(AsmProgramManager::getInstance()),
+    afterAssembly(AfterAssembly::NOTHING)
 
 {
     // Initialize the memory subsystem
@@ -134,6 +136,7 @@ AsmMainWindow::AsmMainWindow(QWidget *parent) :
     // Connect Undo / Redo events
     connect(ui->assemblerPane, &AssemblerPane::undoAvailable, this, &AsmMainWindow::setUndoability);
     connect(ui->assemblerPane, &AssemblerPane::redoAvailable, this, &AsmMainWindow::setRedoability);
+    connect(ui->assemblerPane, &AssemblerPane::programAssembled, this, &AsmMainWindow::onProgramAssembled);
     connect(ui->ioWidget, &IOWidget::undoAvailable, this, &AsmMainWindow::setUndoability);
     connect(ui->ioWidget, &IOWidget::redoAvailable, this, &AsmMainWindow::setRedoability);
 
@@ -154,6 +157,19 @@ AsmMainWindow::AsmMainWindow(QWidget *parent) :
     connect(this, &AsmMainWindow::simulationStarted, ui->ioWidget, &IOWidget::onClear);
     connect(this, &AsmMainWindow::simulationStarted, ui->ioWidget, &IOWidget::onSimulationStart);
 
+    // While the CPU runs on the simulation worker, views are refreshed from published snapshots.
+    IsaCpu* cpu = controlSection.get();
+    simulationWorker->setCaptureHook([cpu](SimulationSnapshot& snapshot) {
+        snapshot.instructionCount = cpu->getInstructionCount();
+    });
+    connect(simulationWorker, &SimulationWorker::snapshotPublished, ui->asmCpuPane, &AsmCpuPane::onSimulationSnapshot);
+    connect(simulationWorker, &SimulationWorker::snapshotPublished, ui->memoryWidget, &MemoryDumpPane::onSimulationSnapshot);
+    connect(simulationWorker, &SimulationWorker::snapshotPublished, ui->memoryTracePane, &NewMemoryTracePane::onSimulationSnapshot);
+    connect(simulationWorker, &SimulationWorker::snapshotPublished, this, [this](const SimulationSnapshot& snapshot) {
+        ui->statusBar->showMessage(QString("Running: %1 instructions executed").arg(snapshot.instructionCount));
+    });
+    connect(simulationWorker, &SimulationWorker::runFinished, this, &AsmMainWindow::onBackgroundRunFinished);
+
     // Post finished events to the event queue so that they are processed after simulation updates.
     connect(this, &AsmMainWindow::simulationFinished, controlSection.get(), &IsaCpu::onSimulationFinished, Qt::QueuedConnection);
     connect(this, &AsmMainWindow::simulationFinished, ui->memoryWidget, &MemoryDumpPane::onSimulationFinished, Qt::QueuedConnection);
@@ -353,6 +369,8 @@ void AsmMainWindow::readSettings()
 
     //Restore last used file path
     curPath = settings.value("filePath", QDir::homePath()).toString();
+    // Restore execution engine choice. Setting the check state will update the CPU.
+    ui->actionBuild_Fast_Execution->setChecked(settings.value("fastExecution", false).toBool());
     // Restore dark mode state
     onDarkModeChanged();
     settings.endGroup();
@@ -368,6 +386,7 @@ void AsmMainWindow::writeSettings()
     settings.setValue("geometry", saveGeometry());
     settings.setValue("font", codeFont);
     settings.setValue("filePath", curPath);
+    settings.setValue("fastExecution", ui->actionBuild_Fast_Execution->isChecked());
     settings.endGroup();
 
     //Handle writing for all children
@@ -1084,9 +1103,48 @@ void AsmMainWindow::on_actionEdit_Reset_font_to_Default_triggered()
 }
 
 //Build Events
-bool AsmMainWindow::on_actionBuild_Assemble_triggered()
+void AsmMainWindow::on_actionBuild_Assemble_triggered()
+{
+    assembleProgramThen(AfterAssembly::NOTHING);
+}
+
+void AsmMainWindow::assembleProgramThen(AfterAssembly then)
 {
+    afterAssembly = then;
+    ui->statusBar->showMessage("Assembling...");
     ui->assemblerPane->assembleAsProgram();
+    // Prevent building or starting a program until the assembly finishes, unless it already has.
+    handleDebugButtons();
+}
+
+void AsmMainWindow::onProgramAssembled()
+{
+    AfterAssembly then = afterAssembly;
+    afterAssembly = AfterAssembly::NOTHING;
+    // The assembly was abandoned, such as by opening a different file.
+    if(ui->assemblerPane->getAssemblerOutput().isNull()) {
+        ui->statusBar->clearMessage();
+        handleDebugButtons();
+        return;
+    }
+    else if(!installAssembledProgram()) return;
+    switch(then) {
+    case AfterAssembly::RUN:
+        runAssembledProgram();
+        break;
+    case AfterAssembly::DEBUG:
+        debugAssembledProgram();
+        break;
+    case AfterAssembly::DEBUG_LOADER:
+        debugAssembledProgramWithLoader();
+        break;
+    default:
+        break;
+    }
+}
+
+bool AsmMainWindow::installAssembledProgram()
+{
     if(ui->assemblerPane->getAssemblerOutput()->success){
         programManager->setUserProgram(ui->assemblerPane->getAssemblerOutput()->prog);
         ui->asmProgramTracePane->onRemoveAllBreakpoints();
@@ -1106,6 +1164,7 @@ bool AsmMainWindow::on_actionBuild_Assemble_triggered()
         // ui->pepCodeTraceTab->setCurrentIndex(0); // Make source code pane visible
         loadObjectCodeProgram();
         ui->statusBar->showMessage("Assembly failed", 4000);
+        handleDebugButtons();
         return false;
     }
 
@@ -1129,6 +1188,7 @@ void AsmMainWindow::on_actionBuild_Execute_triggered()
         ui->memoryWidget->clearHighlight();
         ui->memoryWidget->refreshMemory();
         controlSection->onSimulationStarted();
+        if(startBackgroundRun()) return;
         controlSection->onRun();
         connectViewUpdate();
     }
@@ -1151,7 +1211,11 @@ void AsmMainWindow::on_actionBuild_Execute_triggered()
 
 void AsmMainWindow::on_actionBuild_Run_triggered()
 {
-    if(!on_actionBuild_Assemble_triggered()) return;
+    assembleProgramThen(AfterAssembly::RUN);
+}
+
+void AsmMainWindow::runAssembledProgram()
+{
     loadOperatingSystem();
     loadObjectCodeProgram();
     debugState = DebugState::RUN;
@@ -1164,6 +1228,7 @@ void AsmMainWindow::on_actionBuild_Run_triggered()
         ui->memoryWidget->updateMemory();
         ui->memoryTracePane->updateTrace();
         controlSection->onSimulationStarted();
+        if(startBackgroundRun()) return;
         controlSection->onRun();
         connectViewUpdate();
 
@@ -1194,6 +1259,12 @@ void AsmMainWindow::on_actionBuild_Run_Object_triggered()
     }
 }
 
+void AsmMainWindow::on_actionBuild_Fast_Execution_toggled(bool checked)
+{
+    // Only affects runs, since the CPU always uses the full engine while debugging.
+    controlSection->setFastExecution(checked);
+}
+
 // Debug slots
 
 void AsmMainWindow::handleDebugButtons()
@@ -1220,6 +1291,11 @@ void AsmMainWindow::handleDebugButtons()
         enabledButtons |= DebugButtons::BUILD_ASM;
         enabledButtons |= DebugButtons::OPEN_NEW | DebugButtons::INSTALL_OS;
         enabledButtons |= DebugButtons::CLEAR;
+        // Wait for the program being assembled before building, loading, or starting a program.
+        if(ui->assemblerPane->isAssemblingProgram()) {
+            enabledButtons &= ~(DebugButtons::RUN | DebugButtons::RUN_OBJECT | DebugButtons::DEBUG | DebugButtons::DEBUG_OBJECT
+                                | DebugButtons::DEBUG_LOADER | DebugButtons::BUILD_ASM | DebugButtons::INSTALL_OS);
+        }
         break;
     case DebugState::RUN:
         enabledButtons = DebugButtons::STOP | DebugButtons::INTERRUPT;
@@ -1239,16 +1315,18 @@ void AsmMainWindow::handleDebugButtons()
     debugButtonEnableHelper(enabledButtons);
 }
 
-bool AsmMainWindow::on_actionDebug_Start_Debugging_triggered()
-{  
-    if(!on_actionBuild_Assemble_triggered()) return false;
+void AsmMainWindow::on_actionDebug_Start_Debugging_triggered()
+{
+    assembleProgramThen(AfterAssembly::DEBUG);
+}
+
+void AsmMainWindow::debugAssembledProgram()
+{
     // The function on_actionDebug_Start_Debugging_Object_triggered() does not switch to
     // the debugger tab. This is intentional, since object code does not necessarily
     // correspond to the last assembled program.
-    else if(!on_actionDebug_Start_Debugging_Object_triggered()) return false;
+    if(!on_actionDebug_Start_Debugging_Object_triggered()) return;
     ui->tabWidget->setCurrentIndex(ui->tabWidget->indexOf(ui->debuggerTab));
-    return true;
-
 }
 
 bool AsmMainWindow::on_actionDebug_Start_Debugging_Object_triggered()
@@ -1284,9 +1362,13 @@ bool AsmMainWindow::on_actionDebug_Start_Debugging_Object_triggered()
     return false;
 }
 
-bool AsmMainWindow::on_actionDebug_Start_Debugging_Loader_triggered()
+void AsmMainWindow::on_actionDebug_Start_Debugging_Loader_triggered()
+{
+    assembleProgramThen(AfterAssembly::DEBUG_LOADER);
+}
+
+void AsmMainWindow::debugAssembledProgramWithLoader()
 {
-    if(!on_actionBuild_Assemble_triggered()) return false;
     memDevice->clearMemory();
     loadOperatingSystem();
     // Copy object code to batch input pane and make it the active input pane
@@ -1295,7 +1377,7 @@ bool AsmMainWindow::on_actionDebug_Start_Debugging_Loader_triggered()
     objcode = objcode.replace('\n', ' ');
     ui->ioWidget->setBatchInput(objcode);
     ui->ioWidget->setActivePane(Enu::EPane::EBatchIO);
-    if(!on_actionDebug_Start_Debugging_Object_triggered()) return false;
+    if(!on_actionDebug_Start_Debugging_Object_triggered()) return;
     ui->tabWidget->setCurrentIndex(ui->tabWidget->indexOf(ui->debuggerTab));
     quint16 sp, pc;
     memDevice->readWord(programManager->getOperatingSystem()->getBurnValue() - 9, sp);
@@ -1310,11 +1392,16 @@ bool AsmMainWindow::on_actionDebug_Start_Debugging_Loader_triggered()
     // start hitting "return" to trigger single steps.
     ui->asmProgramTracePane->setFocus(Qt::FocusReason::MouseFocusReason);
     emit simulationUpdate();
-    return true;
 }
 
 void AsmMainWindow::on_actionDebug_Stop_Debugging_triggered()
 {
+    // Stopping the worker will finish the simulation, which stops debugging.
+    if(simulationWorker->isRunning()) {
+        controlSection->requestCancel();
+        simulationWorker->waitForFinished();
+        return;
+    }
     connectViewUpdate();
     highlightActiveLines();
     debugState = DebugState::DISABLED;
@@ -1347,8 +1434,17 @@ void AsmMainWindow::on_actionDebug_Single_Step_Assembler_triggered()
 void AsmMainWindow::on_actionDebug_Interupt_Execution_triggered()
 {
     // Enable debugging in CPU and then temporarily pause execution.
-    controlSection->enableDebugging();
-    controlSection->forceBreakpoint(Enu::BreakpointTypes::ASSEMBLER);
+    if(simulationWorker->isRunning()) {
+        // The worker may only be interrupted between steps, so wait for it to pause.
+        controlSection->requestInterrupt(Enu::BreakpointTypes::ASSEMBLER);
+        simulationWorker->waitForFinished();
+        // The program may have terminated before the interrupt was honored.
+        if(debugState == DebugState::DISABLED) return;
+    }
+    else {
+        controlSection->enableDebugging();
+        controlSection->forceBreakpoint(Enu::BreakpointTypes::ASSEMBLER);
+    }
     connectViewUpdate();
     debugState = DebugState::DEBUG_ISA;
     highlightActiveLines();
@@ -1494,6 +1590,9 @@ void AsmMainWindow::redefine_Mnemonics_closed()
 
 void AsmMainWindow::onSimulationFinished()
 {
+    // The CPU signals completion from the worker thread before it is done running.
+    // Wait for onBackgroundRunFinished(), which is only called once the worker is idle.
+    if(simulationWorker->isRunning()) return;
     QString errorString;
     on_actionDebug_Stop_Debugging_triggered();
 
@@ -1508,6 +1607,33 @@ void AsmMainWindow::onSimulationFinished()
 
 }
 
+bool AsmMainWindow::startBackgroundRun()
+{
+    // Interactive input must be answered by the UI before a read completes,
+    // so only runs using batch input are executed off of the UI thread.
+    if(!ui->ioWidget->inBatchMode()) return false;
+    memDevice->setAbortOnMissingInput(true);
+    simulationWorker->start();
+    return true;
+}
+
+void AsmMainWindow::onBackgroundRunFinished()
+{
+    memDevice->setAbortOnMissingInput(false);
+    connectViewUpdate();
+    // If the simulator finished, then propogate that information to connect components.
+    if(controlSection->getExecutionFinished()) {
+        debugState = DebugState::DISABLED;
+        onSimulationFinished();
+    }
+    // Otherwise, the simulator paused execution, so don't explicitly terminate
+    // the simulator.
+    else {
+        handleDebugButtons();
+        emit simulationUpdate();
+    }
+}
+
 void AsmMainWindow::onDarkModeChanged()
 {
     isInDarkMode = inDarkMode();
@@ -46,6 +46,7 @@ class RedefineMnemonicsDialog;
 //WIP classes
 class IsaCpu;
 class MainMemory;
+class SimulationWorker;
 
 /*
  * The set of possible states for the debugger.
@@ -86,6 +87,8 @@ private:
     // Main Memory
     QSharedPointer<MainMemory> memDevice;
     QSharedPointer<IsaCpu> controlSection;
+    // Runs the CPU off of the UI thread when no interaction is needed.
+    SimulationWorker *simulationWorker;
 
     // Dialogues
     AsmHelpDialog *helpDialog;
@@ -98,6 +101,24 @@ private:
     // Disconnecting these events allow for faster execution when running or continuing.
     void connectViewUpdate();
     void disconnectViewUpdate();
+    // Run on the simulation worker if the run needs no input from the UI.
+    // Returns false if the run must instead be executed on the UI thread.
+    bool startBackgroundRun();
+
+    // What to do once the program started by a build or debug action has been assembled.
+    enum class AfterAssembly
+    {
+        NOTHING, RUN, DEBUG, DEBUG_LOADER
+    };
+    AfterAssembly afterAssembly;
+    // Start assembling the source program in the background, and perform then once it has been assembled.
+    void assembleProgramThen(AfterAssembly then);
+    // Make the output of the assembler pane the user program. Returns true if assembly succeeded.
+    bool installAssembledProgram();
+    // Continuations of Run, Start Debugging, and Start Debugging Loader once the program has been assembled.
+    void runAssembledProgram();
+    void debugAssembledProgram();
+    void debugAssembledProgramWithLoader();
 
     // Methods to persist & restore class to file.
     void readSettings();
@@ -178,18 +199,22 @@ private slots:
     void on_actionEdit_Reset_font_to_Default_triggered();
 
     // Build
-    bool on_actionBuild_Assemble_triggered(); //Returns true if assembly succeded.
+    void on_actionBuild_Assemble_triggered();
+    // Install the assembled program and continue the action that requested the assembly.
+    void onProgramAssembled();
     void on_actionBuild_Load_Object_triggered();
     void on_actionBuild_Execute_triggered();
     void on_actionBuild_Run_triggered();
     void on_actionBuild_Run_Object_triggered();
+    // Select the stripped down execution engine for runs without debugging.
+    void on_actionBuild_Fast_Execution_toggled(bool checked);
 
 
     //Debug Events
     void handleDebugButtons();
-    bool on_actionDebug_Start_Debugging_triggered();
+    void on_actionDebug_Start_Debugging_triggered();
     bool on_actionDebug_Start_Debugging_Object_triggered();
-    bool on_actionDebug_Start_Debugging_Loader_triggered();
+    void on_actionDebug_Start_Debugging_Loader_triggered();
 
     void on_actionDebug_Interupt_Execution_triggered();
     void on_actionDebug_Continue_triggered();
@@ -236,6 +261,7 @@ private slots:
 
     //Run events
     void onSimulationFinished();
+    void onBackgroundRunFinished();
 
     // Byte converter
     void slotByteConverterDecEdited(const QString &);
@@ -23,6 +23,7 @@
 #include "asmcode.h"
 #include "symboltable.h"
 #include "symbolentry.h"
+#include "symbolvalue.h"
 
 StaticTraceInfo::StaticTraceInfo(): staticTraceError(false), hadTraceTags(false), dynamicAllocSymbolTypes(), staticAllocSymbolTypes(),
     instrToSymlist(), hasHeapMalloc(), heapPtr(), mallocPtr()
@@ -31,14 +32,15 @@ StaticTraceInfo::StaticTraceInfo(): staticTraceError(false), hadTraceTags(false)
 }
 
 AsmProgram::AsmProgram(): program(), indexToMemAddress(), memAddressToIndex(), symTable(QSharedPointer<SymbolTable>(new SymbolTable())),
-    traceInfo(), burn(false), burnAddress(0), burnValue(0)
+    traceInfo(), numericSymbolNames(), addressSymbolNames(), burn(false), burnAddress(0), burnValue(0)
 {
 
 }
 
 AsmProgram::AsmProgram(QList<QSharedPointer<AsmCode> > programList, QSharedPointer<SymbolTable> symbolTable,
                        QSharedPointer<const StaticTraceInfo> traceInfo): program(programList),
-    indexToMemAddress(), memAddressToIndex(), symTable(symbolTable), traceInfo(traceInfo), burn(false), burnAddress(0), burnValue(0)
+    indexToMemAddress(), memAddressToIndex(), symTable(symbolTable), traceInfo(traceInfo),
+    numericSymbolNames(), addressSymbolNames(), burn(false), burnAddress(0), burnValue(0)
 {
     programByteLength = 0;
     int start = -1;
@@ -49,18 +51,20 @@ AsmProgram::AsmProgram(QList<QSharedPointer<AsmCode> > programList, QSharedPoint
         programByteLength += programList[it]->objectCodeLength();
     }
     programBounds = {static_cast<quint16>(start), static_cast<quint16>(start-1+programByteLength)};
+    buildSymbolNameIndices();
 }
 
 AsmProgram::AsmProgram(QList<QSharedPointer<AsmCode> > programList, QSharedPointer<SymbolTable> symbolTable,
                        QSharedPointer<const StaticTraceInfo> traceInfo, quint16 burnAddress, quint16 burnValue) : program(programList),
     indexToMemAddress(), memAddressToIndex(), symTable(symbolTable), traceInfo(traceInfo),
-    burn(true), burnAddress(burnAddress), burnValue(burnValue)
+    numericSymbolNames(), addressSymbolNames(), burn(true), burnAddress(burnAddress), burnValue(burnValue)
 {
     programByteLength = burnValue - burnAddress;
 
     // We are given program bounds by the burn address and burn val, so no need
     // to calculate like above constructor.
     programBounds = {static_cast<quint16>(burnAddress), static_cast<quint16>(burnValue)};
+    buildSymbolNameIndices();
 }
 
 AsmProgram::~AsmProgram()
@@ -152,6 +156,16 @@ QSharedPointer<const StaticTraceInfo> AsmProgram::getTraceInfo() const
     return traceInfo;
 }
 
+QString AsmProgram::getNumericSymbolName(quint16 value) const
+{
+    return numericSymbolNames.value(value);
+}
+
+QString AsmProgram::getAddressSymbolName(quint16 address) const
+{
+    return addressSymbolNames.value(address);
+}
+
 QString AsmProgram::getFormattedSourceCode() const
 {
     QStringList retVal;
@@ -178,3 +192,25 @@ QString AsmProgram::getProgramListing() const
     QString header = "      Object\nAddr  code   Symbol   Mnemon  Operand     Comment\n";
     return line % header % line % getProgramListingCode() % line % "\n";
 }
+
+void AsmProgram::buildSymbolNameIndices()
+{
+    // Record name as the only symbol with value, or mark value as ambiguous.
+    auto record = [](QHash<quint16, QString>& index, quint16 value, QString name) {
+        auto it = index.find(value);
+        if(it == index.end()) index.insert(value, name);
+        else *it = QString();
+    };
+    for(auto symbol : symTable->getSymbolEntries()) {
+        qint32 value = symbol->getValue();
+        // Traces only ever look up 16 bit values.
+        if(value < 0 || value > 0xFFFF) continue;
+        SymbolType type = symbol->getRawValue()->getSymbolType();
+        if(type != SymbolType::ADDRESS) {
+            record(numericSymbolNames, static_cast<quint16>(value), symbol->getName());
+        }
+        if(type != SymbolType::NUMERIC_CONSTANT) {
+            record(addressSymbolNames, static_cast<quint16>(value), symbol->getName());
+        }
+    }
+}
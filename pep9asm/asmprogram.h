@@ -79,6 +79,13 @@ public:
     QPair<quint16, quint16> getProgramBounds() const;
     QSharedPointer<const StaticTraceInfo> getTraceInfo() const;
 
+    // If exactly one symbol that is not an address has value as its value, return its name.
+    // Otherwise, return a null string. Used to replace operand specifiers in traces.
+    QString getNumericSymbolName(quint16 value) const;
+    // If exactly one symbol that is not a numeric constant has address as its value, return its name.
+    // Otherwise, return a null string. Used to replace memory addresses in traces.
+    QString getAddressSymbolName(quint16 address) const;
+
 
     // Get code properly formatted for the source code pane
     QString getFormattedSourceCode() const;
@@ -96,9 +103,15 @@ private:
     quint16 programByteLength;
     QSharedPointer<SymbolTable> symTable;
     QSharedPointer<const StaticTraceInfo> traceInfo;
+    // Reverse lookups from a value to the name of the only symbol of each kind with that value,
+    // so that traces need not search the symbol table. Values shared by multiple symbols
+    // map to a null string, since they can't be replaced unambiguously.
+    QHash<quint16, QString> numericSymbolNames, addressSymbolNames;
 
     bool burn;
     quint16 burnAddress, burnValue;
+    // Must be called once the symbol table has its final values.
+    void buildSymbolNameIndices();
 };
 
 #endif // ASMPROGRAM_H
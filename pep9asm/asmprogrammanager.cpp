@@ -23,7 +23,6 @@
 #include <QSharedPointer>
 #include "asmcode.h"
 #include "symbolentry.h"
-AsmProgramManager* AsmProgramManager::instance = nullptr;
 AsmProgramManager::AsmProgramManager(QObject *parent): QObject(parent), operatingSystem(nullptr), userProgram(nullptr)
 {
     userProgram.clear();
@@ -32,7 +31,9 @@ AsmProgramManager::AsmProgramManager(QObject *parent): QObject(parent), operatin
 
 AsmProgramManager *AsmProgramManager::getInstance()
 {
-    if(instance == nullptr) instance = new AsmProgramManager();
+    // Function-local statics are initialized exactly once, even if several
+    // threads (e.g. batch workers) race to fetch the instance.
+    static AsmProgramManager* instance = new AsmProgramManager();
     return instance;
 }
 
@@ -170,10 +171,10 @@ QSharedPointer<AsmProgramManager::AsmOutput> AsmProgramManager::assembleOS(QStri
     return out;
 }
 
-QSharedPointer<AsmProgramManager::AsmOutput> AsmProgramManager::assembleProgram(QString sourceCode)
+QSharedPointer<AsmProgramManager::AsmOutput> AsmProgramManager::assembleProgram(QString sourceCode, IsaLineCache *lineCache)
 {
     QSharedPointer<AsmProgramManager::AsmOutput> out = QSharedPointer<AsmProgramManager::AsmOutput>::create();
-    IsaAsm assembler(*this);
+    IsaAsm assembler(*this, lineCache);
     // List of errors and warnings and the lines on which they occured
     bool success = assembler.assembleUserProgram(sourceCode, out->prog, out->errors);
     // Add all warnings and errors to source files
@@ -44,7 +44,8 @@ public:
         bool success;
     };
     QSharedPointer<AsmOutput> assembleOS(QString sourceCode, bool forceBurnAt0xFFFF);
-    QSharedPointer<AsmOutput> assembleProgram(QString sourceCode);
+    // If lineCache is present, lines parsed by an earlier assembly with the same cache are not parsed again.
+    QSharedPointer<AsmOutput> assembleProgram(QString sourceCode, IsaLineCache* lineCache = nullptr);
     /*
      * The Pep/9 virtual machine specifies multiple address at the bottom of memory
      * that contain useful addresses.
@@ -57,6 +58,8 @@ public:
      */
     static quint16 getMemoryVectorOffset(MemoryVectors which);
 
+    // Once the operating system has been installed, the manager may be shared
+    // read-only between threads through its const methods.
     static AsmProgramManager* getInstance();
     // Get or set operating system code
     QSharedPointer<AsmProgram> getOperatingSystem();
@@ -88,7 +91,6 @@ signals:
 
 private:
     AsmProgramManager(QObject* parent = nullptr);
-    static AsmProgramManager* instance;
     QSharedPointer<AsmProgram> operatingSystem;
     QSharedPointer<AsmProgram> userProgram;
 
@@ -26,11 +26,13 @@
 #include <QPainter>
 #include <QSyntaxHighlighter>
 #include <QFontDialog>
+#include <QHelpEvent>
 #include <QKeyEvent>
 #include <QPlainTextDocumentLayout>
 #include <QScrollBar>
 #include <QPaintEvent>
 #include <QSharedPointer>
+#include <QToolTip>
 
 #include "asmsourcecodepane.h"
 #include "ui_asmsourcecodepane.h"
@@ -58,6 +60,7 @@ AsmSourceCodePane::AsmSourceCodePane(QWidget *parent) :
 
     connect(ui->textEdit, &QPlainTextEdit::undoAvailable, this, &AsmSourceCodePane::undoAvailable);
     connect(ui->textEdit, &QPlainTextEdit::redoAvailable, this, &AsmSourceCodePane::redoAvailable);
+    connect(ui->textEdit, &QPlainTextEdit::textChanged, this, &AsmSourceCodePane::textChanged);
 
     ui->label->setFont(QFont(Pep::labelFont, Pep::labelFontSize));
     ui->textEdit->setFont(QFont(Pep::codeFont, Pep::codeFontSize));
@@ -237,6 +240,11 @@ void AsmSourceCodePane::appendMessagesInSourceCodePane(QList<QPair<int, QString>
     cursor.endEditBlock();
 }
 
+void AsmSourceCodePane::setDiagnostics(QList<QPair<int, QString> > errList)
+{
+    ui->textEdit->setDiagnostics(errList);
+}
+
 void AsmSourceCodePane::setSourceCodePaneText(QString string)
 {
     ui->textEdit->setPlainText(string);
@@ -625,6 +633,16 @@ bool AsmSourceTextEdit::lineHasBreakpoint(int line) const
     return this->blockToIndex.contains(line) && breakpoints.contains(blockToIndex[line]);
 }
 
+void AsmSourceTextEdit::setDiagnostics(QList<QPair<int, QString> > errList)
+{
+    diagnostics.clear();
+    for(auto pair : errList) {
+        // Messages are formatted as comments, but the tool tip need not show the leading semicolon.
+        diagnostics[pair.first].append(pair.second.mid(pair.second.startsWith(";") ? 1 : 0));
+    }
+    highlightDiagnostics();
+}
+
 void AsmSourceTextEdit::onRemoveAllBreakpoints()
 {
     breakpoints.clear();
@@ -645,6 +663,7 @@ void AsmSourceTextEdit::onDarkModeChanged(bool darkMode)
 {
     if(darkMode) colors = PepColors::darkMode;
     else colors = PepColors::lightMode;
+    highlightDiagnostics();
 }
 
 void AsmSourceTextEdit::updateBreakpointAreaWidth(int)
@@ -695,6 +714,42 @@ void AsmSourceTextEdit::resizeEvent(QResizeEvent *evt)
     breakpointArea->setGeometry(QRect(cr.left(), cr.top(), breakpointAreaWidth(), cr.height()));
 }
 
+bool AsmSourceTextEdit::viewportEvent(QEvent *event)
+{
+    if(event->type() != QEvent::ToolTip) return QPlainTextEdit::viewportEvent(event);
+    QHelpEvent* helpEvent = static_cast<QHelpEvent*>(event);
+    int line = cursorForPosition(helpEvent->pos()).blockNumber();
+    if(diagnostics.contains(line)) {
+        QToolTip::showText(helpEvent->globalPos(), diagnostics[line].join("\n"), viewport());
+    }
+    else {
+        QToolTip::hideText();
+        event->ignore();
+    }
+    return true;
+}
+
+void AsmSourceTextEdit::highlightDiagnostics()
+{
+    QList<QTextEdit::ExtraSelection> extraSelections;
+    for(auto it = diagnostics.constBegin(); it != diagnostics.constEnd(); ++it) {
+        QTextBlock block = document()->findBlockByNumber(it.key());
+        // Diagnostics may arrive after the offending line has been deleted.
+        if(!block.isValid()) continue;
+        bool isError = false;
+        for(const QString& message : it.value()) {
+            if(message.startsWith("ERROR")) isError = true;
+        }
+        QTextEdit::ExtraSelection selection;
+        selection.format.setUnderlineStyle(QTextCharFormat::WaveUnderline);
+        selection.format.setUnderlineColor(isError ? colors.errorHighlight : colors.warningHighlight);
+        selection.cursor = QTextCursor(block);
+        selection.cursor.movePosition(QTextCursor::EndOfBlock, QTextCursor::KeepAnchor);
+        extraSelections.append(selection);
+    }
+    setExtraSelections(extraSelections);
+}
+
 AsmSourceBreakpointArea::~AsmSourceBreakpointArea()
 {
     // Need out-of-line destructor to prevent vtable from
@@ -54,6 +54,9 @@ public:
     void breakpointAreaMousePress(QMouseEvent* event);
     const QSet<quint16> getBreakpoints() const;
     bool lineHasBreakpoint(int line) const;
+    // Underline each line with an error or warning, and show its messages as a tool tip.
+    // Unlike AsmSourceCodePane::appendMessagesInSourceCodePane(), the text is not modified.
+    void setDiagnostics(QList<QPair<int, QString>> errList);
 
 public slots:
     void onRemoveAllBreakpoints();
@@ -67,6 +70,9 @@ private slots:
     void onTextChanged();
     void resizeEvent(QResizeEvent *evt) override;
 
+protected:
+    bool viewportEvent(QEvent *event) override;
+
 signals:
     void breakpointAdded(quint16 line);
     void breakpointRemoved(quint16 line);
@@ -76,6 +82,9 @@ private:
     AsmSourceBreakpointArea* breakpointArea;
     QSet<quint16> breakpoints;
     QMap<quint16, quint16> blockToIndex;
+    // Map of line numbers to the errors and warnings on that line.
+    QMap<int, QStringList> diagnostics;
+    void highlightDiagnostics();
 };
 
 class AsmProgram;
@@ -120,6 +129,10 @@ public:
     // Post: For each <line #, message> pair, on the line => append error message.
     // Post: Returns immediately if given an empty error list.
 
+    void setDiagnostics(QList<QPair<int, QString> > errList);
+    // Post: For each <line #, message> pair, the line is underlined and message is shown as a tool tip.
+    // Post: The source code is not modified, so may be called while the user is typing.
+
     void setSourceCodePaneText(QString string);
     // Post: Sets text in source code pane to string.
 
@@ -216,6 +229,8 @@ private slots:
 signals:
     void undoAvailable(bool);
     void redoAvailable(bool);
+    // Propogates textChanged() from AsmSourceTextEdit
+    void textChanged();
 
     // Propogates event from AsmSourceTextEdit
     void breakpointAdded(quint16 address);
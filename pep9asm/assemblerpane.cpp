@@ -1,11 +1,17 @@
 #include "assemblerpane.h"
 #include "ui_assemblerpane.h"
 #include "asmprogram.h"
+#include "backgroundassembler.h"
 AssemblerPane::AssemblerPane(QWidget *parent) :
     QWidget(parent),
-    ui(new Ui::AssemblerPane), manager(nullptr), output(nullptr)
+    ui(new Ui::AssemblerPane), manager(nullptr), output(nullptr), lineCache(),
+    liveAssembler(nullptr), liveCheckTimer(), liveSource(), programPending(false), programSource()
 {
     ui->setupUi(this);
+    liveCheckTimer.setSingleShot(true);
+    liveCheckTimer.setInterval(liveCheckDelayMS);
+    connect(&liveCheckTimer, &QTimer::timeout, this, &AssemblerPane::onLiveCheckTimeout);
+    connect(ui->sourcePane, &AsmSourceCodePane::textChanged, this, &AssemblerPane::onSourceChanged);
     //Connect assembler pane widgets
     connect(ui->sourcePane, &AsmSourceCodePane::labelDoubleClicked, this, &AssemblerPane::doubleClickedCodeLabel);
     connect(ui->objectPane, &AsmObjectCodePane::labelDoubleClicked, this, &AssemblerPane::doubleClickedCodeLabel);
@@ -25,6 +31,9 @@ AssemblerPane::~AssemblerPane()
 void AssemblerPane::init(AsmProgramManager *manager)
 {
     this->manager = manager;
+    delete liveAssembler;
+    liveAssembler = new BackgroundAssembler(manager, this);
+    connect(liveAssembler, &BackgroundAssembler::assembled, this, &AssemblerPane::onLiveCheckAssembled);
 }
 
 void AssemblerPane::newProject()
@@ -39,6 +48,17 @@ void AssemblerPane::newProject()
     // Set output to nullptr, as a new project does
     // not have any output until assembled.
     output.clear();
+    lineCache.clear();
+    liveCheckTimer.stop();
+    if(liveAssembler != nullptr) liveAssembler->cancel();
+    liveSource.clear();
+    ui->sourcePane->setDiagnostics({});
+    // The new project has nothing to do with a program that was being assembled.
+    if(programPending) {
+        programPending = false;
+        programSource.clear();
+        emit programAssembled();
+    }
 }
 
 void AssemblerPane::loadSourceFile(QString fileName, QString code)
@@ -59,7 +79,7 @@ void AssemblerPane::loadObjectFile(QString fileName, QString code)
 
 void AssemblerPane::formatAssemblerCode()
 {
-    auto tempOutput = manager->assembleProgram(getPaneContents(Enu::EPane::ESource));
+    auto tempOutput = manager->assembleProgram(getPaneContents(Enu::EPane::ESource), &lineCache);
     if(!tempOutput->success) {
         ui->sourcePane->appendMessagesInSourceCodePane(tempOutput->errors);
         return;
@@ -232,7 +252,35 @@ void AssemblerPane::assembleAsProgram()
 {
     // Clean up any global state from previous compilation attempts
     removeErrorMessages();
-    output = manager->assembleProgram(ui->sourcePane->toPlainText());
+    QString sourceCode = ui->sourcePane->toPlainText();
+    output.clear();
+    programPending = true;
+    programSource = sourceCode;
+    // If the live check has already assembled this exact text, use its output
+    // rather than assembling the program a second time.
+    auto liveOutput = liveAssembler->takeOutput(sourceCode);
+    if(!liveOutput.isNull()) {
+        finishAssembleAsProgram(liveOutput);
+        return;
+    }
+    // Otherwise, wait for the live check to deliver this text through onLiveCheckAssembled(...).
+    liveCheckTimer.stop();
+    if(!liveAssembler->isAssembling(sourceCode)) {
+        liveSource = sourceCode;
+        liveAssembler->assemble(sourceCode);
+    }
+}
+
+bool AssemblerPane::isAssemblingProgram() const
+{
+    return programPending;
+}
+
+void AssemblerPane::finishAssembleAsProgram(QSharedPointer<AsmProgramManager::AsmOutput> programOutput)
+{
+    programPending = false;
+    programSource.clear();
+    output = programOutput;
     if(output->success) {
         setPanesFromProgram(*output);
     }
@@ -241,6 +289,36 @@ void AssemblerPane::assembleAsProgram()
         clearPane(Enu::EPane::EObject);
         clearPane(Enu::EPane::EListing);
     }
+    emit programAssembled();
+}
+
+void AssemblerPane::onSourceChanged()
+{
+    // Restart the timer on every keystroke, so that nothing is assembled while typing.
+    if(liveAssembler != nullptr) liveCheckTimer.start();
+}
+
+void AssemblerPane::onLiveCheckTimeout()
+{
+    // Checking newer text would supersede the program being assembled, so wait for it to finish.
+    if(programPending) {
+        liveCheckTimer.start();
+        return;
+    }
+    QString sourceCode = ui->sourcePane->toPlainText();
+    // Changes in formatting or error messages removed and re-inserted
+    // may leave the text the same as the last check.
+    if(sourceCode == liveSource) return;
+    liveSource = sourceCode;
+    liveAssembler->assemble(sourceCode);
+}
+
+void AssemblerPane::onLiveCheckAssembled(QSharedPointer<const AsmProgramManager::AsmOutput> liveOutput)
+{
+    ui->sourcePane->setDiagnostics(liveOutput->errors);
+    if(!programPending) return;
+    auto programOutput = liveAssembler->takeOutput(programSource);
+    if(!programOutput.isNull()) finishAssembleAsProgram(programOutput);
 }
 
 void AssemblerPane::rebuildHighlightingRules()
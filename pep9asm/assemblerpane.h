@@ -24,7 +24,11 @@
 #include "enu.h"
 #include <QWidget>
 #include <QSettings>
+#include <QTimer>
 #include <asmprogrammanager.h>
+#include "isaasm.h"
+
+class BackgroundAssembler;
 namespace Ui {
 class AssemblerPane;
 }
@@ -61,7 +65,12 @@ public:
     void setModified(Enu::EPane which, bool val);
 
     void assembleAsOS(bool forceBurnAt0xFFFF = false);
+    // Assemble the source code on a worker thread and return immediately. programAssembled()
+    // is emitted once the output is available, which may happen before this method returns
+    // if the live check has already assembled the source code.
     void assembleAsProgram();
+    // Returns true if an assembly started by assembleAsProgram() has not finished.
+    bool isAssemblingProgram() const;
 
     void rebuildHighlightingRules();
     void highlightOnFocus();
@@ -95,6 +104,9 @@ public:
 signals:
     void undoAvailable(bool);
     void redoAvailable(bool);
+    // Emitted when an assembly started by assembleAsProgram() finishes, or is abandoned
+    // by newProject(). If it was abandoned, getAssemblerOutput() returns nullptr.
+    void programAssembled();
 
 public slots:
     void onFontChanged(QFont font);
@@ -107,6 +119,11 @@ public slots:
     void onBreakpointRemoved(quint16 address);
 
 private slots:
+    // Start checking the source program on a worker thread once typing pauses.
+    void onSourceChanged();
+    void onLiveCheckTimeout();
+    // Show diagnostics, and finish assembleAsProgram() if it was waiting on this output.
+    void onLiveCheckAssembled(QSharedPointer<const AsmProgramManager::AsmOutput> liveOutput);
     void doubleClickedCodeLabel(Enu::EPane which);
     void onChildUndoAvailable(bool);
     void onChildRedoAvailable(bool);
@@ -115,6 +132,22 @@ private:
     Ui::AssemblerPane *ui;
     AsmProgramManager* manager;
     QSharedPointer<AsmProgramManager::AsmOutput> output;
+    // Parsed source lines from the last time the source was formatted, so that only edited lines are parsed again.
+    IsaLineCache lineCache;
+    // Assembles the source program in the background while the user types,
+    // so that errors can be shown without blocking the UI thread.
+    BackgroundAssembler* liveAssembler;
+    QTimer liveCheckTimer;
+    // Source code most recently given to the live assembler.
+    QString liveSource;
+    // Source code being assembled by assembleAsProgram(), which is waiting for the live assembler.
+    bool programPending;
+    QString programSource;
+    // Time after the last keystroke before the live assembler is started.
+    static const int liveCheckDelayMS = 400;
+
+    // Display the output of assembleAsProgram() and emit programAssembled().
+    void finishAssembleAsProgram(QSharedPointer<AsmProgramManager::AsmOutput> programOutput);
 };
 
 #endif // ASSEMBLERPANE_H
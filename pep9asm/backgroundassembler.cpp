@@ -0,0 +1,131 @@
+// File: backgroundassembler.cpp
+/*
+    Pep9 is a virtual machine for writing machine language and assembly
+    language programs.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "backgroundassembler.h"
+
+#include <QtConcurrent>
+
+#include "asmprogram.h"
+#include "isaasm.h"
+
+BackgroundAssembler::BackgroundAssembler(AsmProgramManager *manager, QObject *parent): QObject(parent),
+    manager(manager), lineCache(), cancelRequested(false), watcher(), running(false), hasPending(false),
+    runningSource(), pendingSource(), output(nullptr), outputSource()
+{
+    connect(&watcher, &QFutureWatcher<QSharedPointer<AsmProgramManager::AsmOutput>>::finished,
+            this, &BackgroundAssembler::onWorkerFinished);
+}
+
+BackgroundAssembler::~BackgroundAssembler()
+{
+    // The worker thread references the line cache and cancellation flag,
+    // so it must stop before either is destroyed.
+    cancel();
+    watcher.waitForFinished();
+}
+
+void BackgroundAssembler::assemble(QString sourceCode)
+{
+    if(running) {
+        // Wait for the running assembly to be cancelled before starting the next,
+        // since the line cache may only be used by one assembly at a time.
+        pendingSource = sourceCode;
+        hasPending = true;
+        cancelRequested.store(true, std::memory_order_relaxed);
+    }
+    else {
+        startWorker(sourceCode);
+    }
+}
+
+void BackgroundAssembler::cancel()
+{
+    hasPending = false;
+    pendingSource.clear();
+    if(running) cancelRequested.store(true, std::memory_order_relaxed);
+}
+
+bool BackgroundAssembler::isAssembling(const QString &sourceCode) const
+{
+    return running && !hasPending && !cancelRequested.load(std::memory_order_relaxed)
+            && runningSource == sourceCode;
+}
+
+void BackgroundAssembler::waitForFinished()
+{
+    // Finishing a cancelled run may start the pending one, which must be waited on too.
+    while(running) {
+        watcher.waitForFinished();
+        finishRun();
+    }
+}
+
+QSharedPointer<AsmProgramManager::AsmOutput> BackgroundAssembler::takeOutput(const QString &sourceCode)
+{
+    if(output.isNull() || outputSource != sourceCode) return nullptr;
+    QSharedPointer<AsmProgramManager::AsmOutput> taken = output;
+    output.clear();
+    outputSource.clear();
+    return taken;
+}
+
+void BackgroundAssembler::onWorkerFinished()
+{
+    finishRun();
+}
+
+void BackgroundAssembler::startWorker(QString sourceCode)
+{
+    running = true;
+    runningSource = sourceCode;
+    cancelRequested.store(false, std::memory_order_relaxed);
+    // Capture the operating system on the UI thread, where it is modified.
+    QSharedPointer<const AsmProgram> os = manager->getOperatingSystem();
+    AsmProgramManager* programManager = manager;
+    IsaLineCache* cache = &lineCache;
+    const std::atomic<bool>* cancelFlag = &cancelRequested;
+    watcher.setFuture(QtConcurrent::run([programManager, cache, cancelFlag, os, sourceCode]() {
+        auto out = QSharedPointer<AsmProgramManager::AsmOutput>::create();
+        IsaAsm assembler(*programManager, cache);
+        assembler.setOperatingSystem(os);
+        assembler.setCancelFlag(cancelFlag);
+        out->success = assembler.assembleUserProgram(sourceCode, out->prog, out->errors);
+        return out;
+    }));
+}
+
+void BackgroundAssembler::finishRun()
+{
+    // The watcher signals completion even if waitForFinished() already handled the run.
+    if(!running) return;
+    running = false;
+    bool cancelled = cancelRequested.load(std::memory_order_relaxed);
+    if(hasPending) {
+        hasPending = false;
+        startWorker(pendingSource);
+        pendingSource.clear();
+        return;
+    }
+    else if(cancelled) return;
+    // Only replace the output once the new output is complete.
+    output = watcher.result();
+    outputSource = runningSource;
+    emit assembled(output);
+}
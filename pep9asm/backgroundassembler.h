@@ -0,0 +1,92 @@
+// File: backgroundassembler.h
+/*
+    Pep9 is a virtual machine for writing machine language and assembly
+    language programs.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BACKGROUNDASSEMBLER_H
+#define BACKGROUNDASSEMBLER_H
+
+#include <atomic>
+
+#include <QFutureWatcher>
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+
+#include "asmprogrammanager.h"
+#include "isaasm.h"
+
+/*
+ * Assembles user programs on a worker thread, so that a source program can be checked
+ * while it is being typed, and so that large programs do not freeze the UI.
+ *
+ * Each call to assemble() supersedes the previous one. A running assembly is cancelled
+ * between lines, and only the output of the newest request is delivered. Outputs are
+ * swapped in on the UI thread once complete, and are not modified after being delivered
+ * through assembled(). A caller that wants to modify an output (e.g. to set breakpoints)
+ * must take ownership of it through takeOutput().
+ *
+ * The worker resolves charIn and charOut against the operating system installed when the
+ * request was made, so the operating system may be replaced while an assembly is running.
+ */
+class BackgroundAssembler : public QObject
+{
+    Q_OBJECT
+public:
+    explicit BackgroundAssembler(AsmProgramManager* manager, QObject *parent = nullptr);
+    virtual ~BackgroundAssembler() override;
+
+    // Assemble sourceCode as a user program on a worker thread and return immediately.
+    void assemble(QString sourceCode);
+    // Cancel any running or requested assembly. Its output will not be delivered.
+    void cancel();
+    // Returns true if sourceCode is being assembled, and no newer assembly has been requested.
+    bool isAssembling(const QString& sourceCode) const;
+    // Block until the worker thread is idle, including any assembly that was waiting for
+    // a cancelled one. The newest requested output is delivered before this method returns.
+    void waitForFinished();
+    // If the newest output was assembled from exactly sourceCode, transfer it to the caller.
+    // Otherwise, returns nullptr.
+    QSharedPointer<AsmProgramManager::AsmOutput> takeOutput(const QString& sourceCode);
+
+signals:
+    // Emitted on the UI thread when the newest requested assembly finishes.
+    void assembled(QSharedPointer<const AsmProgramManager::AsmOutput> output);
+
+private slots:
+    void onWorkerFinished();
+
+private:
+    AsmProgramManager* manager;
+    // Only used by the worker thread, which runs one assembly at a time.
+    IsaLineCache lineCache;
+    std::atomic<bool> cancelRequested;
+    QFutureWatcher<QSharedPointer<AsmProgramManager::AsmOutput>> watcher;
+    bool running, hasPending;
+    // Text of the running assembly, and of the assembly waiting for it to be cancelled.
+    QString runningSource, pendingSource;
+    // Newest delivered output, and the text it was assembled from.
+    QSharedPointer<AsmProgramManager::AsmOutput> output;
+    QString outputSource;
+
+    void startWorker(QString sourceCode);
+    // Finish the current run on the UI thread. Safe to call more than once.
+    void finishRun();
+};
+
+#endif // BACKGROUNDASSEMBLER_H
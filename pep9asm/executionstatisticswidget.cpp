@@ -95,13 +95,15 @@ void ExecutionStatisticsWidget::onSimulationFinished()
     // Use locale so that strings have commas in them.
     ui->lineEdit_Cycles->setText(QLocale::system().toString(cpu->getCycleCount()));
     ui->lineEdit_Instructions->setText(QLocale::system().toString(cpu->getInstructionCount()));
-    fillModel(cpu->getInstructionHistogram());
+    fillModel(cpu->getInstructionHistogram(), cpu->getInstructionCycleHistogram());
 }
 
 // POD class to help aggregate statistics.
 struct lookup {
     // How many times an instruction was referenced.
     quint32 tally;
+    // How many cycles were spent executing the instruction.
+    quint64 cycles;
     // At what operand specifier does the instruction start.
     quint8 start;
     // How many addressing modes does this instruction have?
@@ -109,11 +111,16 @@ struct lookup {
     quint8 addrModes;
 };
 
-void ExecutionStatisticsWidget::fillModel(const QVector<quint32> histogram)
+void ExecutionStatisticsWidget::fillModel(const QVector<quint32> histogram, const QVector<quint64> cycleHistogram)
 {
     // Make sure the model has no existing items.
     // Model will make sure to delete any extra items
     model->removeRows(0, model->rowCount());
+    // Only show cycles if the CPU tracked them for every opcode.
+    bool showCycles = cycleHistogram.length() >= 256;
+    if(showCycles) model->setHorizontalHeaderLabels({"Instruction", "Frequency", "Cycles"});
+    else model->setHorizontalHeaderLabels({"Instruction", "Frequency"});
+    model->setColumnCount(showCycles ? 3 : 2);
 
     Enu::EMnemonic mnemon;
     QMap<Enu::EMnemonic, lookup> mnemonicMap;
@@ -130,6 +137,7 @@ void ExecutionStatisticsWidget::fillModel(const QVector<quint32> histogram)
         // If the instruction exists, update the data in place
         if(mnemonicMap.contains(mnemon)) {
             mnemonicMap[mnemon].tally += histogram[it];
+            if(showCycles) mnemonicMap[mnemon].cycles += cycleHistogram[it];
             // If the item already exists, then it must be a non-unary instruction.
             // Therefore, the first loop iteration was an addressing mode,
             // and we must adjust the address mode counter to compensate.
@@ -142,6 +150,7 @@ void ExecutionStatisticsWidget::fillModel(const QVector<quint32> histogram)
             lookup entry;
             entry.start = it;
             entry.tally = histogram[it];
+            entry.cycles = showCycles ? cycleHistogram[it] : 0;
             // Assume a mnemonic is unary until otherwise proven.
             entry.addrModes = 0;
             mnemonicMap[mnemon] = entry;
@@ -164,7 +173,13 @@ void ExecutionStatisticsWidget::fillModel(const QVector<quint32> histogram)
         QStandardItem* instrCount = new QStandardItem();
         // Make a variant from an int type to ensure that sorting works correctly.
         instrCount->setData(QVariant(tuple.tally), Qt::DisplayRole);
-        model->insertRow(model->rowCount(), {instrName, instrCount});
+        QList<QStandardItem*> instrRow = {instrName, instrCount};
+        if(showCycles) {
+            QStandardItem* instrCycles = new QStandardItem();
+            instrCycles->setData(QVariant(tuple.cycles), Qt::DisplayRole);
+            instrRow.append(instrCycles);
+        }
+        model->insertRow(model->rowCount(), instrRow);
 
         for(int offset = 0;  offset < tuple.addrModes; offset++) {
             // If the addressing mode was not used, do not insert the entry.
@@ -175,8 +190,14 @@ void ExecutionStatisticsWidget::fillModel(const QVector<quint32> histogram)
             QStandardItem* addrName = new QStandardItem(QString(addrMetaenum.valueToKey((int) addr)).toLower());
             QStandardItem* addrCount = new QStandardItem();
             addrCount->setData(QVariant(histogram[tuple.start + offset]), Qt::DisplayRole);
-
-            instrName->appendRow({addrName, addrCount});
+            QList<QStandardItem*> addrRow = {addrName, addrCount};
+            if(showCycles) {
+                QStandardItem* addrCycles = new QStandardItem();
+                addrCycles->setData(QVariant(cycleHistogram[tuple.start + offset]), Qt::DisplayRole);
+                addrRow.append(addrCycles);
+            }
+
+            instrName->appendRow(addrRow);
         }
     }
 
@@ -54,7 +54,8 @@ private:
     Ui::ExecutionStatisticsWidget *ui;
     QSharedPointer<InterfaceISACPU> cpu;
     QStandardItemModel* model;
-    void fillModel(const QVector<quint32> histogram);
+    // If cycleHistogram is not empty, it is displayed alongside the instruction frequencies.
+    void fillModel(const QVector<quint32> histogram, const QVector<quint64> cycleHistogram);
 };
 
 #endif // EXECUTIONSTATISTICSWIDGET_H
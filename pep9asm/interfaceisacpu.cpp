@@ -86,6 +86,11 @@ void InterfaceISACPU::setDebugBreakpoints(bool doDebug) noexcept
     this->doDebug = doDebug;
 }
 
+const QVector<quint64> InterfaceISACPU::getInstructionCycleHistogram()
+{
+    return QVector<quint64>();
+}
+
 void InterfaceISACPU::doISAStepWhile(std::function<bool ()> condition)
 {
     do{
@@ -95,11 +100,11 @@ void InterfaceISACPU::doISAStepWhile(std::function<bool ()> condition)
 
 void InterfaceISACPU::calculateStackChangeStart(quint8 instr)
 {
-    if(Pep::isTrapMap[Pep::decodeMnemonic[instr]]) {
+    if(Pep::isTrapMap.value(Pep::decodeMnemonic.at(instr))) {
         isTrapped = true;
         activeActions = &osActions;
     }
-    else if(Pep::decodeMnemonic[instr] == Enu::EMnemonic::RETTR) {
+    else if(Pep::decodeMnemonic.at(instr) == Enu::EMnemonic::RETTR) {
         isTrapped = false;
         memTrace->activeStack = &memTrace->userStack;
         activeActions = &userActions;
@@ -127,7 +132,7 @@ void InterfaceISACPU::calculateStackChangeEnd(quint8 instr, quint16 opspec, quin
     if(!memTrace->activeStack->isStackIntact() || this->manager->getProgramAt(pc) == nullptr
             // For now, only allow tracing of user programs
             || this->manager->getUserProgram() != this->manager->getProgramAt(pc)) return;
-    Enu::EMnemonic mnemon = Pep::decodeMnemonic[instr];
+    Enu::EMnemonic mnemon = Pep::decodeMnemonic.at(instr);
     quint16 size = 0;
     bool mallocPreError = false;
     switch(mnemon) {
@@ -86,6 +86,9 @@ public:
     virtual quint64 getInstructionCount() = 0;
     // Returns a 256 element vector that indicates how many times each opcode was used.
     virtual const QVector<quint32> getInstructionHistogram() = 0;
+    // Returns a 256 element vector that indicates how many cycles each opcode used,
+    // or an empty vector if the CPU does not track cycles per opcode.
+    virtual const QVector<quint64> getInstructionCycleHistogram();
 protected:
     // Execute a single ISA instruction.
     virtual void onISAStep() = 0;
@@ -23,23 +23,15 @@
 #include "asmcode.h"
 #include "asmprogram.h"
 #include "asmprogrammanager.h"
+#include "isalexer.h"
 #include "mainmemory.h"
 #include "symboltable.h"
 #include "symbolentry.h"
 #include "symbolvalue.h"
 #include "typetags.h"
+#include <limits>
 #include <QRegularExpression>
 #include <QRegularExpressionMatch>
-// Regular expressions for lexical analysis
-QRegExp IsaParserHelper::rxAddrMode("^((,)(\\s*)(i|d|x|n|s(?![fx])|sx(?![f])|sf|sfx){1}){1}");
-QRegExp IsaParserHelper::rxCharConst("^((\')(?![\'])(([^\'\\\\]){1}|((\\\\)([\'|b|f|n|r|t|v|\"|\\\\]))|((\\\\)(([x|X])([0-9|A-F|a-f]{2}))))(\'))");
-QRegExp IsaParserHelper::rxComment("^((;{1})(.)*)");
-QRegExp IsaParserHelper::rxDecConst("^((([+|-]{0,1})([0-9]+))|^(([1-9])([0-9]*)))");
-QRegExp IsaParserHelper::rxDotCommand("^((.)(([A-Z|a-z]{1})(\\w)*))");
-QRegExp IsaParserHelper::rxHexConst("^((0(?![x|X]))|((0)([x|X])([0-9|A-F|a-f])+)|((0)([0-9]+)))");
-QRegExp IsaParserHelper::rxIdentifier("^((([A-Z|a-z|_]{1})(\\w*))(:){0,1})");
-QRegExp IsaParserHelper::rxStringConst("^((\")((([^\"\\\\])|((\\\\)([\'|b|f|n|r|t|v|\"|\\\\]))|((\\\\)(([x|X])([0-9|A-F|a-f]{2}))))*)(\"))");
-
 // Regular expressions for trace tag analysis
 QRegExp IsaParserHelper::rxFormatTag("(#((1c)|(1d)|(1h)|(2d)|(2h))((\\d)+a)?(\\s|$))");
 QRegExp IsaParserHelper::rxArrayTag("(#((1c)|(1d)|(1h)|(2d)|(2h))(\\d)+a)(\\s|$)?");
@@ -54,7 +46,54 @@ const QString noEquate(";WARNING: Looked for existing symbol not defined in .EQU
 const QString noSymbol(";WARNING: Trace tag with no symbol declaration");
 const QString illegalAddrMode(";WARNING: Stack trace not possible unless immediate addressing is specified.");
 
-IsaAsm::IsaAsm(AsmProgramManager &manager): manager(manager)
+namespace {
+    // Returns true if text, a dot command without its period, is name in any case.
+    inline bool isDotCommand(QStringView text, QStringView name)
+    {
+        return text.compare(name, Qt::CaseInsensitive) == 0;
+    }
+}
+
+IsaLineCache::IsaLineCache(): current(), previous()
+{
+
+}
+
+bool IsaLineCache::find(const QString &line, IsaParsedLine &parsed)
+{
+    auto it = current.constFind(line);
+    if(it != current.constEnd()) {
+        parsed = *it;
+        return true;
+    }
+    // Move lines used by the previous assembly into the current one, so that they are retained.
+    auto prev = previous.find(line);
+    if(prev == previous.end()) return false;
+    parsed = *prev;
+    previous.erase(prev);
+    current.insert(line, parsed);
+    return true;
+}
+
+void IsaLineCache::insert(const QString &line, const IsaParsedLine &parsed)
+{
+    current.insert(line, parsed);
+}
+
+void IsaLineCache::beginAssembly()
+{
+    previous.swap(current);
+    current.clear();
+}
+
+void IsaLineCache::clear()
+{
+    current.clear();
+    previous.clear();
+}
+
+IsaAsm::IsaAsm(AsmProgramManager &manager, IsaLineCache *lineCache): manager(manager), lineCache(lineCache),
+    operatingSystem(nullptr), cancelFlag(nullptr)
 {
 
 }
@@ -64,6 +103,16 @@ IsaAsm::~IsaAsm()
 
 }
 
+void IsaAsm::setOperatingSystem(QSharedPointer<const AsmProgram> os)
+{
+    operatingSystem = os;
+}
+
+void IsaAsm::setCancelFlag(const std::atomic<bool> *flag)
+{
+    cancelFlag = flag;
+}
+
 bool IsaAsm::assembleUserProgram(const QString &progText, QSharedPointer<AsmProgram> &progOut, QList<QPair<int, QString> > &errList)
 {
     bool dotEndDetected = false, success = true;
@@ -79,7 +128,12 @@ bool IsaAsm::assembleUserProgram(const QString &progText, QSharedPointer<AsmProg
     // Contains information about the address of a .BURN, and the size of memory burned.
     BURNInfo info;
     QSharedPointer<StaticTraceInfo> traceInfo = QSharedPointer<StaticTraceInfo>::create();
+    if(lineCache != nullptr) lineCache->beginAssembly();
     while (lineNum < sourceCodeList.size() && !dotEndDetected) {
+        if(cancelFlag != nullptr && cancelFlag->load(std::memory_order_relaxed)) {
+            errList.append(QPair<int,QString>{lineNum, ";ERROR: Assembly was cancelled."});
+            return false;
+        }
         sourceLine = sourceCodeList[lineNum];
         if (!IsaAsm::processSourceLine(symTable.data(), info, *traceInfo, byteCount,
                                        sourceLine, lineNum, code,
@@ -98,6 +152,8 @@ bool IsaAsm::assembleUserProgram(const QString &progText, QSharedPointer<AsmProg
 
     // Insert charIn, charOut symbols if they have not been previously defined.
     quint16 chin, chout;
+    QSharedPointer<const AsmProgram> os = operatingSystem;
+    if(os.isNull()) os = manager.getOperatingSystem();
     if(symTable->exists("charIn") && symTable->getValue("charIn")->isUndefined()) {
         // According to the OS memory map vector, the location of chicharIn is
         // stored in the 6th and 7th bytes from the end of the operating system.
@@ -107,7 +163,7 @@ bool IsaAsm::assembleUserProgram(const QString &progText, QSharedPointer<AsmProg
         // loaded in memory. Instead, diretly querry the operating system's symbol
         // table for the value of the symbol.
         chin = static_cast<quint16>(
-                    manager.getOperatingSystem()->getSymbolTable()->getValue("charIn")->getValue());
+                    os->getSymbolTable()->getValue("charIn")->getValue());
         symTable->setValue("charIn", QSharedPointer<SymbolValueNumeric>::create(chin));
     }
     if(symTable->exists("charOut") && symTable->getValue("charOut")->isUndefined()) {
@@ -119,7 +175,7 @@ bool IsaAsm::assembleUserProgram(const QString &progText, QSharedPointer<AsmProg
         // loaded in memory. Instead, diretly querry the operating system's symbol
         // table for the value of the symbol.
         chout = static_cast<quint16>(
-                    manager.getOperatingSystem()->getSymbolTable()->getValue("charOut")->getValue());
+                    os->getSymbolTable()->getValue("charOut")->getValue());
         symTable->setValue("charOut", QSharedPointer<SymbolValueNumeric>::create(chout));
     }
 
@@ -175,6 +231,7 @@ bool IsaAsm::assembleOperatingSystem(const QString &progText, bool forceBurnAt0x
     int byteCount = 0;
     BURNInfo info;
     QSharedPointer<StaticTraceInfo> traceInfo = QSharedPointer<StaticTraceInfo>::create();
+    if(lineCache != nullptr) lineCache->beginAssembly();
     while (lineNum < fileLines.size() && !dotEndDetected) {
         sourceLine = fileLines[lineNum];
         if (!IsaAsm::processSourceLine(symTable.data(), info, *traceInfo.get(),
@@ -588,10 +645,25 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
                                int& byteCount, QString sourceLine, int lineNum, AsmCode *&code,
                                QString &errorString, bool &dotEndDetected, bool hasBreakpoint)
 {
-    IsaParserHelper::ELexicalToken token; // Passed to getToken.
-    QString tokenString; // Passed to getToken.
-    QString localSymbolDef = ""; // Saves symbol definition for processing in the following state.
+    IsaParsedLine parsed;
+    if (lineCache == nullptr || !lineCache->find(sourceLine, parsed)) {
+        if (!parseSourceLine(sourceLine, parsed, errorString)) {
+            return false;
+        }
+        if (lineCache != nullptr) lineCache->insert(sourceLine, parsed);
+    }
+    return placeSourceLine(symTable, info, traceInfo, byteCount, parsed, lineNum, code,
+                           errorString, dotEndDetected, hasBreakpoint);
+}
+
+bool IsaAsm::parseSourceLine(const QString &sourceLine, IsaParsedLine &parsed, QString &errorString)
+{
+    IsaLexer lexer(sourceLine);
+    IsaToken lexedToken; // Passed to lexer.
+    IsaParserHelper::ELexicalToken token; // Type of lexedToken.
+    QStringView tokenString; // Text of lexedToken, only copied where it is stored.
     Enu::EMnemonic localEnumMnemonic; // Key to Pep:: table lookups.
+    AsmCode *code = nullptr;
 
     // The concrete code objects asssigned to code.
     UnaryInstruction *unaryInstruction = nullptr;
@@ -607,34 +679,30 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
     DotWord *dotWord = nullptr;
     CommentOnly *commentOnly = nullptr;
     BlankLine *blankLine = nullptr;
-    dotEndDetected = false;
+    parsed = IsaParsedLine();
     IsaParserHelper::ParseState state = IsaParserHelper::PS_START;
     do {
-        if (!getToken(sourceLine, token, tokenString)) {
-            errorString = tokenString;
+        if (!lexer.nextToken(lexedToken, errorString)) {
             return false;
         }
+        token = lexedToken.type;
+        tokenString = lexer.text(lexedToken);
         switch (state) {
         case IsaParserHelper::PS_START:
             if (token == IsaParserHelper::LT_IDENTIFIER) {
-                if (Pep::mnemonToEnumMap.contains(tokenString.toUpper())) {
-                    localEnumMnemonic = Pep::mnemonToEnumMap.value(tokenString.toUpper());
+                if (IsaParserHelper::stringToMnemonic(tokenString, localEnumMnemonic)) {
                     if (Pep::isUnaryMap.value(localEnumMnemonic)) {
                         unaryInstruction = new UnaryInstruction;
                         unaryInstruction->mnemonic = localEnumMnemonic;
-                        unaryInstruction->breakpoint = hasBreakpoint;
                         code = unaryInstruction;
-                        code->memAddress = byteCount;
-                        byteCount += 1; // One byte generated for unary instruction.
+                        parsed.byteLength += 1; // One byte generated for unary instruction.
                         state = IsaParserHelper::PS_CLOSE;
                     }
                     else {
                         nonUnaryInstruction = new NonUnaryInstruction;
                         nonUnaryInstruction->mnemonic = localEnumMnemonic;
-                        nonUnaryInstruction->breakpoint = hasBreakpoint;
                         code = nonUnaryInstruction;
-                        code->memAddress = byteCount;
-                        byteCount += 3; // Three bytes generated for nonunary instruction.
+                        parsed.byteLength += 3; // Three bytes generated for nonunary instruction.
                         state = IsaParserHelper::PS_INSTRUCTION;
                     }
                 }
@@ -644,62 +712,50 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
                 }
             }
             else if (token == IsaParserHelper::LT_DOT_COMMAND) {
-                tokenString.remove(0, 1); // Remove the period
-                tokenString = tokenString.toUpper();
-                if (tokenString == "ADDRSS") {
+                QStringView dotCommand = tokenString.mid(1); // Remove the period
+                if (isDotCommand(dotCommand, u"ADDRSS")) {
                     dotAddrss = new DotAddrss;
                     code = dotAddrss;
-                    code->memAddress = byteCount;
                     state = IsaParserHelper::PS_DOT_ADDRSS;
                 }
-                else if (tokenString == "ALIGN") {
+                else if (isDotCommand(dotCommand, u"ALIGN")) {
                     dotAlign = new DotAlign;
                     code = dotAlign;
-                    code->memAddress = byteCount;
                     state = IsaParserHelper::PS_DOT_ALIGN;
                 }
-                else if (tokenString == "ASCII") {
+                else if (isDotCommand(dotCommand, u"ASCII")) {
                     dotAscii = new DotAscii;
                     code = dotAscii;
-                    code->memAddress = byteCount;
                     state = IsaParserHelper::PS_DOT_ASCII;
                 }
-                else if (tokenString == "BLOCK") {
+                else if (isDotCommand(dotCommand, u"BLOCK")) {
                     dotBlock = new DotBlock;
                     code = dotBlock;
-                    code->memAddress = byteCount;
                     state = IsaParserHelper::PS_DOT_BLOCK;
                 }
-                else if (tokenString == "BURN") {
+                else if (isDotCommand(dotCommand, u"BURN")) {
                     dotBurn = new DotBurn;
                     code = dotBurn;
-                    code->memAddress = byteCount;
                     state = IsaParserHelper::PS_DOT_BURN;
                 }
-                else if (tokenString == "BYTE") {
+                else if (isDotCommand(dotCommand, u"BYTE")) {
                     dotByte = new DotByte;
                     code = dotByte;
-                    code->memAddress = byteCount;
                     state = IsaParserHelper::PS_DOT_BYTE;
                 }
-                else if (tokenString == "END") {
+                else if (isDotCommand(dotCommand, u"END")) {
                     dotEnd = new DotEnd;
                     code = dotEnd;
-                    // End symbol does not have a memory address
-                    code->memAddress = byteCount;
-                    dotEndDetected = true;
                     state = IsaParserHelper::PS_DOT_END;
                 }
-                else if (tokenString == "EQUATE") {
+                else if (isDotCommand(dotCommand, u"EQUATE")) {
                     dotEquate = new DotEquate;
                     code = dotEquate;
-                    code->memAddress = byteCount;
                     state = IsaParserHelper::PS_DOT_EQUATE;
                 }
-                else if (tokenString == "WORD") {
+                else if (isDotCommand(dotCommand, u"WORD")) {
                     dotWord = new DotWord;
                     code = dotWord;
-                    code->memAddress = byteCount;
                     state = IsaParserHelper::PS_DOT_WORD;
                 }
                 else {
@@ -708,26 +764,18 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
                 }
             }
             else if (token == IsaParserHelper::LT_SYMBOL_DEF) {
-                tokenString.chop(1); // Remove the colon
-                if (tokenString.length() > 8) {
-                    errorString = ";ERROR: Symbol " + tokenString + " cannot have more than eight characters.";
-                    return false;
-                }
-                // If the symbol is already defined, then there is an compilation error.
-                if (symTable->exists(tokenString) && symTable->getValue(tokenString)->isDefined()) {
-                    symTable->getValue(tokenString)->setMultiplyDefined();
-                    errorString = ";ERROR: Symbol " + tokenString + " was previously defined.";
+                QStringView symbol = tokenString.chopped(1); // Remove the colon
+                if (symbol.length() > 8) {
+                    errorString = ";ERROR: Symbol " + symbol.toString() + " cannot have more than eight characters.";
                     return false;
                 }
-                localSymbolDef = tokenString;
-                if(!symTable->exists(tokenString)) symTable->insertSymbol(tokenString);
-                symTable->setValue(localSymbolDef, QSharedPointer<SymbolValueLocation>::create(byteCount));
+                parsed.symbolDef = symbol.toString();
                 state = IsaParserHelper::PS_SYMBOL_DEF;
             }
             else if (token == IsaParserHelper::LT_COMMENT) {
                 commentOnly = new CommentOnly;
                 commentOnly->hasCom = true;
-                commentOnly->comment = tokenString;
+                commentOnly->comment = tokenString.toString();
                 code = commentOnly;
                 // Comments don't have a memory address
                 code->memAddress = -1;
@@ -738,7 +786,6 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
                 code = blankLine;
                 // Neither do empty lines
                 code->memAddress = -1;
-                code->sourceCodeLine = lineNum;
                 state = IsaParserHelper::PS_FINISH;
             }
             else {
@@ -749,26 +796,19 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
 
         case IsaParserHelper::PS_SYMBOL_DEF:
             if (token == IsaParserHelper::LT_IDENTIFIER){
-                if (Pep::mnemonToEnumMap.contains(tokenString.toUpper())) {
-                    localEnumMnemonic = Pep::mnemonToEnumMap.value(tokenString.toUpper());
+                if (IsaParserHelper::stringToMnemonic(tokenString, localEnumMnemonic)) {
                     if (Pep::isUnaryMap.value(localEnumMnemonic)) {
                         unaryInstruction = new UnaryInstruction;
-                        unaryInstruction->symbolEntry = symTable->getValue(localSymbolDef);
                         unaryInstruction->mnemonic = localEnumMnemonic;
-                        unaryInstruction->breakpoint = hasBreakpoint;
                         code = unaryInstruction;
-                        code->memAddress = byteCount;
-                        byteCount += 1; // One byte generated for unary instruction.
+                        parsed.byteLength += 1; // One byte generated for unary instruction.
                         state = IsaParserHelper::PS_CLOSE;
                     }
                     else {
                         nonUnaryInstruction = new NonUnaryInstruction;
-                        nonUnaryInstruction->symbolEntry = symTable->getValue(localSymbolDef);
                         nonUnaryInstruction->mnemonic = localEnumMnemonic;
-                        nonUnaryInstruction->breakpoint = hasBreakpoint;
                         code = nonUnaryInstruction;
-                        code->memAddress = byteCount;
-                        byteCount += 3; // Three bytes generated for unary instruction.
+                        parsed.byteLength += 3; // Three bytes generated for unary instruction.
                         state = IsaParserHelper::PS_INSTRUCTION;
                     }
                 }
@@ -778,63 +818,45 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
                 }
             }
             else if (token == IsaParserHelper::LT_DOT_COMMAND) {
-                tokenString.remove(0, 1); // Remove the period
-                tokenString = tokenString.toUpper();
-                if (tokenString == "ADDRSS") {
+                QStringView dotCommand = tokenString.mid(1); // Remove the period
+                if (isDotCommand(dotCommand, u"ADDRSS")) {
                     dotAddrss = new DotAddrss;
-                    dotAddrss->symbolEntry = symTable->getValue(localSymbolDef);
                     code = dotAddrss;
-                    code->memAddress = byteCount;
                     state = IsaParserHelper::PS_DOT_ADDRSS;
                 }
-                else if (tokenString == "ASCII") {
+                else if (isDotCommand(dotCommand, u"ASCII")) {
                     dotAscii = new DotAscii;
-                    dotAscii->symbolEntry = symTable->getValue(localSymbolDef);
                     code = dotAscii;
-                    code->memAddress = byteCount;
                     state = IsaParserHelper::PS_DOT_ASCII;
                 }
-                else if (tokenString == "BLOCK") {
+                else if (isDotCommand(dotCommand, u"BLOCK")) {
                     dotBlock = new DotBlock;
-                    dotBlock->symbolEntry = symTable->getValue(localSymbolDef);
                     code = dotBlock;
-                    code->memAddress = byteCount;
                     state = IsaParserHelper::PS_DOT_BLOCK;
                 }
-                else if (tokenString == "BURN") {
+                else if (isDotCommand(dotCommand, u"BURN")) {
                     dotBurn = new DotBurn;
-                    dotBurn->symbolEntry = symTable->getValue(localSymbolDef);
                     code = dotBurn;
-                    code->memAddress = byteCount;
                     state = IsaParserHelper::PS_DOT_BURN;
                 }
-                else if (tokenString == "BYTE") {
+                else if (isDotCommand(dotCommand, u"BYTE")) {
                     dotByte = new DotByte;
-                    dotByte->symbolEntry = symTable->getValue(localSymbolDef);
                     code = dotByte;
-                    code->memAddress = byteCount;
                     state = IsaParserHelper::PS_DOT_BYTE;
                 }
-                else if (tokenString == "END") {
+                else if (isDotCommand(dotCommand, u"END")) {
                     dotEnd = new DotEnd;
-                    dotEnd->symbolEntry = symTable->getValue(localSymbolDef);
                     code = dotEnd;
-                    code->memAddress = byteCount;
-                    dotEndDetected = true;
                     state = IsaParserHelper::PS_DOT_END;
                 }
-                else if (tokenString == "EQUATE") {
+                else if (isDotCommand(dotCommand, u"EQUATE")) {
                     dotEquate = new DotEquate;
-                    dotEquate->symbolEntry = symTable->getValue(localSymbolDef);
                     code = dotEquate;
-                    code->memAddress = byteCount;
                     state = IsaParserHelper::PS_DOT_EQUATE;
                 }
-                else if (tokenString == "WORD") {
+                else if (isDotCommand(dotCommand, u"WORD")) {
                     dotWord = new DotWord;
-                    dotWord->symbolEntry = symTable->getValue(localSymbolDef);
                     code = dotWord;
-                    code->memAddress = byteCount;
                     state = IsaParserHelper::PS_DOT_WORD;
                 }
                 else {
@@ -851,11 +873,11 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
         case IsaParserHelper::PS_INSTRUCTION:
             if (token == IsaParserHelper::LT_IDENTIFIER) {
                 if (tokenString.length() > 8) {
-                    errorString = ";ERROR: Symbol " + tokenString + " cannot have more than eight characters.";
+                    errorString = ";ERROR: Symbol " + tokenString.toString() + " cannot have more than eight characters.";
                     return false;
                 }
-                if(!symTable->exists(tokenString)) symTable->insertSymbol(tokenString);
-                nonUnaryInstruction->argument = new SymbolRefArgument(symTable->getValue(tokenString));
+                // The argument refers to the program's symbol table, so it is created when the line is placed.
+                parsed.symbolRef = tokenString.toString();
                 state = IsaParserHelper::PS_ADDRESSING_MODE;
             }
             else if (token == IsaParserHelper::LT_STRING_CONSTANT) {
@@ -863,13 +885,12 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
                     errorString = ";ERROR: String operands must have length at most two.";
                     return false;
                 }
-                nonUnaryInstruction->argument = new StringArgument(tokenString);
+                nonUnaryInstruction->argument = new StringArgument(tokenString.toString());
                 state = IsaParserHelper::PS_ADDRESSING_MODE;
             }
             else if (token == IsaParserHelper::LT_HEX_CONSTANT) {
-                tokenString.remove(0, 2); // Remove "0x" prefix.
                 bool ok;
-                int value = tokenString.toInt(&ok, 16);
+                int value = IsaParserHelper::stringToInt(tokenString.mid(2), 16, &ok); // Skip "0x" prefix.
                 if (value < 65536) {
                     nonUnaryInstruction->argument = new HexArgument(value);
                     state = IsaParserHelper::PS_ADDRESSING_MODE;
@@ -881,7 +902,7 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
             }
             else if (token == IsaParserHelper::LT_DEC_CONSTANT) {
                 bool ok;
-                int value = tokenString.toInt(&ok, 10);
+                int value = IsaParserHelper::stringToInt(tokenString, 10, &ok);
                 if ((-32768 <= value) && (value <= 65535)) {
                     if (value < 0) {
                         value += 65536; // Stored as two-byte unsigned.
@@ -898,7 +919,7 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
                 }
             }
             else if (token == IsaParserHelper::LT_CHAR_CONSTANT) {
-                nonUnaryInstruction->argument = new CharArgument(tokenString);
+                nonUnaryInstruction->argument = new CharArgument(tokenString.toString());
                 state = IsaParserHelper::PS_ADDRESSING_MODE;
             }
             else {
@@ -925,11 +946,10 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
                 nonUnaryInstruction->addressingMode = Enu::EAddrMode::I;
                 if (token == IsaParserHelper::LT_COMMENT) {
                     code->hasCom = true;
-                    code->comment = tokenString;
+                    code->comment = tokenString.toString();
                     state = IsaParserHelper::PS_COMMENT;
                 }
                 else if (token == IsaParserHelper::LT_EMPTY) {
-                    code->sourceCodeLine = lineNum;
                     state = IsaParserHelper::PS_FINISH;
                 }
                 else {
@@ -942,12 +962,12 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
         case IsaParserHelper::PS_DOT_ADDRSS:
             if (token == IsaParserHelper::LT_IDENTIFIER) {
                 if (tokenString.length() > 8) {
-                    errorString = ";ERROR: Symbol " + tokenString + " cannot have more than eight characters.";
+                    errorString = ";ERROR: Symbol " + tokenString.toString() + " cannot have more than eight characters.";
                     return false;
                 }
-                if(!symTable->exists(tokenString)) symTable->insertSymbol(tokenString);
-                dotAddrss->argument = new SymbolRefArgument(symTable->getValue(tokenString));
-                byteCount += 2;
+                // The argument refers to the program's symbol table, so it is created when the line is placed.
+                parsed.symbolRef = tokenString.toString();
+                parsed.byteLength += 2;
                 state = IsaParserHelper::PS_CLOSE;
             }
             else {
@@ -959,12 +979,10 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
         case IsaParserHelper::PS_DOT_ALIGN:
             if (token == IsaParserHelper::LT_DEC_CONSTANT) {
                 bool ok;
-                int value = tokenString.toInt(&ok, 10);
+                int value = IsaParserHelper::stringToInt(tokenString, 10, &ok);
                 if (value == 2 || value == 4 || value == 8) {
-                    int numBytes = (value - byteCount % value) % value;
+                    // The padding depends on the address of the .ALIGN, so it is computed when the line is placed.
                     dotAlign->argument = new UnsignedDecArgument(value);
-                    dotAlign->numBytesGenerated = new UnsignedDecArgument(numBytes);
-                    byteCount += numBytes;
                     state = IsaParserHelper::PS_CLOSE;
                 }
                 else {
@@ -980,8 +998,8 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
 
         case IsaParserHelper::PS_DOT_ASCII:
             if (token == IsaParserHelper::LT_STRING_CONSTANT) {
-                dotAscii->argument = new StringArgument(tokenString);
-                byteCount += IsaParserHelper::byteStringLength(tokenString);
+                dotAscii->argument = new StringArgument(tokenString.toString());
+                parsed.byteLength += IsaParserHelper::byteStringLength(tokenString);
                 state = IsaParserHelper::PS_CLOSE;
             }
             else {
@@ -993,7 +1011,7 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
         case IsaParserHelper::PS_DOT_BLOCK:
             if (token == IsaParserHelper::LT_DEC_CONSTANT) {
                 bool ok;
-                int value = tokenString.toInt(&ok, 10);
+                int value = IsaParserHelper::stringToInt(tokenString, 10, &ok);
                 if ((0 <= value) && (value <= 65535)) {
                     if (value < 0) {
                         value += 65536; // Stored as two-byte unsigned.
@@ -1002,7 +1020,7 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
                     else {
                         dotBlock->argument = new UnsignedDecArgument(value);
                     }
-                    byteCount += value;
+                    parsed.byteLength += value;
                     state = IsaParserHelper::PS_CLOSE;
                 }
                 else {
@@ -1011,12 +1029,11 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
                 }
             }
             else if (token == IsaParserHelper::LT_HEX_CONSTANT) {
-                tokenString.remove(0, 2); // Remove "0x" prefix.
                 bool ok;
-                int value = tokenString.toInt(&ok, 16);
+                int value = IsaParserHelper::stringToInt(tokenString.mid(2), 16, &ok); // Skip "0x" prefix.
                 if (value < 65536) {
                     dotBlock->argument = new HexArgument(value);
-                    byteCount += value;
+                    parsed.byteLength += value;
                     state = IsaParserHelper::PS_CLOSE;
                 }
                 else {
@@ -1032,16 +1049,10 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
 
         case IsaParserHelper::PS_DOT_BURN:
             if (token == IsaParserHelper::LT_HEX_CONSTANT) {
-                tokenString.remove(0, 2); // Remove "0x" prefix.
                 bool ok;
-                int value = tokenString.toInt(&ok, 16);
+                int value = IsaParserHelper::stringToInt(tokenString.mid(2), 16, &ok); // Skip "0x" prefix.
                 if (value < 65536) {
                     dotBurn->argument = new HexArgument(value);
-                    info.burnCount++;
-                    info.burnValue = value;
-                    info.burnAddress = byteCount;
-                    // The strating rom address cannot be calculated until the length of the program is known
-                    // info.startROMAddress = ???;
                     state = IsaParserHelper::PS_CLOSE;
                 }
                 else {
@@ -1057,19 +1068,19 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
 
         case IsaParserHelper::PS_DOT_BYTE:
             if (token == IsaParserHelper::LT_CHAR_CONSTANT) {
-                dotByte->argument = new CharArgument(tokenString);
-                byteCount += 1;
+                dotByte->argument = new CharArgument(tokenString.toString());
+                parsed.byteLength += 1;
                 state = IsaParserHelper::PS_CLOSE;
             }
             else if (token == IsaParserHelper::LT_DEC_CONSTANT) {
                 bool ok;
-                int value = tokenString.toInt(&ok, 10);
+                int value = IsaParserHelper::stringToInt(tokenString, 10, &ok);
                 if ((-128 <= value) && (value <= 255)) {
                     if (value < 0) {
                         value += 256; // value stored as one-byte unsigned.
                     }
                     dotByte->argument = new DecArgument(value);
-                    byteCount += 1;
+                    parsed.byteLength += 1;
                     state = IsaParserHelper::PS_CLOSE;
                 }
                 else {
@@ -1078,12 +1089,11 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
                 }
             }
             else if (token == IsaParserHelper::LT_HEX_CONSTANT) {
-                tokenString.remove(0, 2); // Remove "0x" prefix.
                 bool ok;
-                int value = tokenString.toInt(&ok, 16);
+                int value = IsaParserHelper::stringToInt(tokenString.mid(2), 16, &ok); // Skip "0x" prefix.
                 if (value < 256) {
                     dotByte->argument = new HexArgument(value);
-                    byteCount += 1;
+                    parsed.byteLength += 1;
                     state = IsaParserHelper::PS_CLOSE;
                 }
                 else {
@@ -1096,8 +1106,8 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
                     errorString = ";ERROR: .BYTE string operands must have length one.";
                     return false;
                 }
-                dotByte->argument = new StringArgument(tokenString);
-                byteCount += 1;
+                dotByte->argument = new StringArgument(tokenString.toString());
+                parsed.byteLength += 1;
                 state = IsaParserHelper::PS_CLOSE;
             }
             else {
@@ -1109,14 +1119,12 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
         case IsaParserHelper::PS_DOT_END:
             if (token == IsaParserHelper::LT_COMMENT) {
                 dotEnd->hasCom = true;
-                dotEnd->comment = tokenString;
-                code->sourceCodeLine = lineNum;
+                dotEnd->comment = tokenString.toString();
                 state = IsaParserHelper::PS_FINISH;
             }
             else if (token == IsaParserHelper::LT_EMPTY) {
                 dotEnd->hasCom = false;
                 dotEnd->comment = "";
-                code->sourceCodeLine = lineNum;
                 state = IsaParserHelper::PS_FINISH;
             }
             else {
@@ -1126,13 +1134,13 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
             break;
 
         case IsaParserHelper::PS_DOT_EQUATE:
-            if (dotEquate->symbolEntry == nullptr) {
+            if (parsed.symbolDef.isEmpty()) {
                 errorString = ";ERROR: .EQUATE must have a symbol definition.";
                 return false;
             }
             else if (token == IsaParserHelper::LT_DEC_CONSTANT) {
                 bool ok;
-                int value = tokenString.toInt(&ok, 10);
+                int value = IsaParserHelper::stringToInt(tokenString, 10, &ok);
                 if ((-32768 <= value) && (value <= 65535)) {
 
                     if (value < 0) {
@@ -1142,7 +1150,6 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
                     else {
                         dotEquate->argument = new UnsignedDecArgument(value);
                     }
-                    dotEquate->symbolEntry->setValue( QSharedPointer<SymbolValueNumeric>::create(value));
                     state = IsaParserHelper::PS_CLOSE;
                 }
                 else {
@@ -1151,12 +1158,10 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
                 }
             }
             else if (token == IsaParserHelper::LT_HEX_CONSTANT) {
-                tokenString.remove(0, 2); // Remove "0x" prefix.
                 bool ok;
-                int value = tokenString.toInt(&ok, 16);
+                int value = IsaParserHelper::stringToInt(tokenString.mid(2), 16, &ok); // Skip "0x" prefix.
                 if (value < 65536) {
                     dotEquate->argument = new HexArgument(value);
-                    dotEquate->symbolEntry->setValue( QSharedPointer<SymbolValueNumeric>::create(value));
                     state = IsaParserHelper::PS_CLOSE;
                 }
                 else {
@@ -1169,13 +1174,11 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
                     errorString = ";ERROR: .EQUATE string operand must have length at most two.";
                     return false;
                 }
-                dotEquate->argument = new StringArgument(tokenString);
-                dotEquate->symbolEntry->setValue( QSharedPointer<SymbolValueNumeric>::create(IsaParserHelper::string2ArgumentToInt(tokenString)));
+                dotEquate->argument = new StringArgument(tokenString.toString());
                 state = IsaParserHelper::PS_CLOSE;
             }
             else if (token == IsaParserHelper::LT_CHAR_CONSTANT) {
-                dotEquate->argument = new CharArgument(tokenString);
-                dotEquate->symbolEntry->setValue( QSharedPointer<SymbolValueNumeric>::create(IsaParserHelper::charStringToInt(tokenString)));
+                dotEquate->argument = new CharArgument(tokenString.toString());
                 state = IsaParserHelper::PS_CLOSE;
             }
             else {
@@ -1186,13 +1189,13 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
 
         case IsaParserHelper::PS_DOT_WORD:
             if (token == IsaParserHelper::LT_CHAR_CONSTANT) {
-                dotWord->argument = new CharArgument(tokenString);
-                byteCount += 2;
+                dotWord->argument = new CharArgument(tokenString.toString());
+                parsed.byteLength += 2;
                 state = IsaParserHelper::PS_CLOSE;
             }
             else if (token == IsaParserHelper::LT_DEC_CONSTANT) {
                 bool ok;
-                int value = tokenString.toInt(&ok, 10);
+                int value = IsaParserHelper::stringToInt(tokenString, 10, &ok);
                 if ((-32768 <= value) && (value < 65536)) {
 
                     if (value < 0) {
@@ -1202,7 +1205,7 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
                     else {
                         dotWord->argument = new UnsignedDecArgument(value);
                     }
-                    byteCount += 2;
+                    parsed.byteLength += 2;
                     state = IsaParserHelper::PS_CLOSE;
                 }
                 else {
@@ -1211,12 +1214,11 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
                 }
             }
             else if (token == IsaParserHelper::LT_HEX_CONSTANT) {
-                tokenString.remove(0, 2); // Remove "0x" prefix.
                 bool ok;
-                int value = tokenString.toInt(&ok, 16);
+                int value = IsaParserHelper::stringToInt(tokenString.mid(2), 16, &ok); // Skip "0x" prefix.
                 if (value < 65536) {
                     dotWord->argument = new HexArgument(value);
-                    byteCount += 2;
+                    parsed.byteLength += 2;
                     state = IsaParserHelper::PS_CLOSE;
                 }
                 else {
@@ -1229,8 +1231,8 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
                     errorString = ";ERROR: .WORD string operands must have length at most two.";
                     return false;
                 }
-                dotWord->argument = new StringArgument(tokenString);
-                byteCount += 2;
+                dotWord->argument = new StringArgument(tokenString.toString());
+                parsed.byteLength += 2;
                 state = IsaParserHelper::PS_CLOSE;
             }
             else {
@@ -1241,12 +1243,11 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
 
         case IsaParserHelper::PS_CLOSE:
             if (token == IsaParserHelper::LT_EMPTY) {
-                code->sourceCodeLine = lineNum;
                 state = IsaParserHelper::PS_FINISH;
             }
             else if (token == IsaParserHelper::LT_COMMENT) {
                 code->hasCom = true;
-                code->comment = tokenString;
+                code->comment = tokenString.toString();
                 state = IsaParserHelper::PS_COMMENT;
             }
             else {
@@ -1257,7 +1258,6 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
 
         case IsaParserHelper::PS_COMMENT:
             if (token == IsaParserHelper::LT_EMPTY) {
-                code->sourceCodeLine = lineNum;
                 state = IsaParserHelper::PS_FINISH;
             }
             else {
@@ -1272,24 +1272,83 @@ bool IsaAsm::processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTrac
         }
     }
     while (state != IsaParserHelper::PS_FINISH);
-    // Parse trace tags
+    parsed.code = QSharedPointer<const AsmCode>(code);
     // If a line has a symbolic or format tag, we must perform additional parsing.
     // Failure to check for symbol tags led to bug #80, where programs
     // only containing symbolic trace tags would assemble with no warnings.
-    if(!code->hasComment() ||
-            !(hasTypeTag(code->getComment()) ||
-              hasSymbolTag(code->getComment()) )) {
+    parsed.hasTraceTags = code->hasComment() &&
+            (hasTypeTag(code->getComment()) ||
+             hasSymbolTag(code->getComment()));
+    return true;
+}
+
+bool IsaAsm::placeSourceLine(SymbolTable *symTable, BURNInfo &info, StaticTraceInfo &traceInfo, int &byteCount,
+                             const IsaParsedLine &parsed, int lineNum, AsmCode *&code,
+                             QString &errorString, bool &dotEndDetected, bool hasBreakpoint)
+{
+    // If the symbol is already defined, then there is an compilation error.
+    if (!parsed.symbolDef.isEmpty() && symTable->exists(parsed.symbolDef)
+            && symTable->getValue(parsed.symbolDef)->isDefined()) {
+        symTable->getValue(parsed.symbolDef)->setMultiplyDefined();
+        errorString = ";ERROR: Symbol " + parsed.symbolDef + " was previously defined.";
+        return false;
+    }
+    code = parsed.code->cloneAsmCode();
+    code->sourceCodeLine = lineNum;
+    // Comments and blank lines don't have a memory address, which the parser marks with -1.
+    if (code->memAddress != -1) code->memAddress = byteCount;
+    code->setBreakpoint(hasBreakpoint);
+    if (!parsed.symbolDef.isEmpty()) {
+        if(!symTable->exists(parsed.symbolDef)) symTable->insertSymbol(parsed.symbolDef);
+        symTable->setValue(parsed.symbolDef, QSharedPointer<SymbolValueLocation>::create(byteCount));
+        code->symbolEntry = symTable->getValue(parsed.symbolDef);
+    }
+    if (!parsed.symbolRef.isEmpty()) {
+        if(!symTable->exists(parsed.symbolRef)) symTable->insertSymbol(parsed.symbolRef);
+        AsmArgument *argument = new SymbolRefArgument(symTable->getValue(parsed.symbolRef));
+        // Only nonunary instructions and .ADDRSS take a symbolic argument.
+        if (auto instruction = dynamic_cast<NonUnaryInstruction*>(code)) instruction->argument = argument;
+        else static_cast<DotAddrss*>(code)->argument = argument;
+    }
+
+    auto dotAlign = dynamic_cast<DotAlign*>(code);
+    auto dotBurn = dynamic_cast<DotBurn*>(code);
+    auto dotEquate = dynamic_cast<DotEquate*>(code);
+    if (dotAlign != nullptr) {
+        int value = dotAlign->argument->getArgumentValue();
+        int numBytes = (value - byteCount % value) % value;
+        dotAlign->numBytesGenerated = new UnsignedDecArgument(numBytes);
+        byteCount += numBytes;
+    }
+    else if (dotBurn != nullptr) {
+        info.burnCount++;
+        info.burnValue = dotBurn->argument->getArgumentValue();
+        info.burnAddress = byteCount;
+        // The strating rom address cannot be calculated until the length of the program is known
+        // info.startROMAddress = ???;
+    }
+    else if (dotEquate != nullptr) {
+        dotEquate->symbolEntry->setValue(QSharedPointer<SymbolValueNumeric>::create(dotEquate->argument->getArgumentValue()));
+    }
+    dotEndDetected = dynamic_cast<DotEnd*>(code) != nullptr;
+    byteCount += parsed.byteLength;
+
+    // Parse trace tags
+    if (!parsed.hasTraceTags) {
         return true;
     }
+    auto dotBlock = dynamic_cast<DotBlock*>(code);
+    auto dotWord = dynamic_cast<DotWord*>(code);
+    auto dotByte = dynamic_cast<DotByte*>(code);
     QString comment = code->getComment(), tag = extractTypeTags(comment);
 
     // If the line of code is a nonunary instruction, but not a stack modifying instruction,
     // then don't attempt any further parsing.
     auto nui = dynamic_cast<NonUnaryInstruction*>(code);
-    if(     dynamic_cast<DotBlock*>(code) == nullptr &&
-            dynamic_cast<DotWord*>(code) == nullptr &&
-            dynamic_cast<DotEquate*>(code) == nullptr &&
-            dynamic_cast<DotByte*>(code) == nullptr &&
+    if(     dotBlock == nullptr &&
+            dotWord == nullptr &&
+            dotEquate == nullptr &&
+            dotByte == nullptr &&
             (nui == nullptr || (
             nui->mnemonic != Enu::EMnemonic::CALL &&
             nui->mnemonic != Enu::EMnemonic::SUBSP &&
@@ -1438,104 +1497,6 @@ bool IsaAsm::hasArrayType(QString formatTag)
             && formatTag.contains(IsaParserHelper::rxArrayTag);
 }
 
-bool IsaAsm::getToken(QString &sourceLine, IsaParserHelper::ELexicalToken &token, QString &tokenString)
-{
-    sourceLine = sourceLine.trimmed();
-    if (sourceLine.length() == 0) {
-        token = IsaParserHelper::LT_EMPTY;
-        tokenString = "";
-        return true;
-    }
-    QChar firstChar = sourceLine[0];
-    IsaParserHelper::rxAddrMode.setCaseSensitivity (Qt::CaseInsensitive);  // Make rxAddrMode not case sensitive
-    if (firstChar == ',') {
-        if (IsaParserHelper::rxAddrMode.indexIn(sourceLine) == -1) {
-            tokenString = ";ERROR: Malformed addressing mode.";
-            return false;
-        }
-        token = IsaParserHelper::LT_ADDRESSING_MODE;
-        tokenString = IsaParserHelper::rxAddrMode.capturedTexts()[0];
-        sourceLine.remove(0, tokenString.length());
-        return true;
-    }
-    if (firstChar == '\'') {
-        if (IsaParserHelper::rxCharConst.indexIn(sourceLine) == -1) {
-            tokenString = ";ERROR: Malformed character constant.";
-            return false;
-        }
-        token = IsaParserHelper::LT_CHAR_CONSTANT;
-        tokenString = IsaParserHelper::rxCharConst.capturedTexts()[0];
-        sourceLine.remove(0, tokenString.length());
-        return true;
-    }
-    if (firstChar == ';') {
-        if (IsaParserHelper::rxComment.indexIn(sourceLine) == -1) {
-            // This error should not occur, as any characters are allowed in a comment.
-            tokenString = ";ERROR: Malformed comment";
-            return false;
-        }
-        token = IsaParserHelper::LT_COMMENT;
-        tokenString = IsaParserHelper::rxComment.capturedTexts()[0];
-        sourceLine.remove(0, tokenString.length());
-        return true;
-    }
-    if (IsaParserHelper::startsWithHexPrefix(sourceLine)) {
-        if (IsaParserHelper::rxHexConst.indexIn(sourceLine) == -1) {
-            tokenString = ";ERROR: Malformed hex constant.";
-            return false;
-        }
-        token = IsaParserHelper::LT_HEX_CONSTANT;
-        tokenString = IsaParserHelper::rxHexConst.capturedTexts()[0];
-        sourceLine.remove(0, tokenString.length());
-        return true;
-    }
-    if ((firstChar.isDigit() || firstChar == '+' || firstChar == '-')) {
-        if (IsaParserHelper::rxDecConst.indexIn(sourceLine) == -1) {
-            tokenString = ";ERROR: Malformed decimal constant.";
-            return false;
-        }
-        token = IsaParserHelper::LT_DEC_CONSTANT;
-        tokenString = IsaParserHelper::rxDecConst.capturedTexts()[0];
-        sourceLine.remove(0, tokenString.length());
-        return true;
-    }
-    if (firstChar == '.') {
-        if (IsaParserHelper::rxDotCommand.indexIn(sourceLine) == -1) {
-            tokenString = ";ERROR: Malformed dot command.";
-            return false;
-        }
-        token = IsaParserHelper::LT_DOT_COMMAND;
-        tokenString = IsaParserHelper::rxDotCommand.capturedTexts()[0];
-        sourceLine.remove(0, tokenString.length());
-        return true;
-    }
-    if (firstChar.isLetter() || firstChar == '_') {
-        if (IsaParserHelper::rxIdentifier.indexIn(sourceLine) == -1) {
-            // This error should not occur, as one-character identifiers are valid.
-            tokenString = ";ERROR: Malformed identifier.";
-            return false;
-        }
-        tokenString = IsaParserHelper::rxIdentifier.capturedTexts()[0];
-        token = tokenString.endsWith(':') ?
-                    IsaParserHelper::LT_SYMBOL_DEF :
-                    IsaParserHelper::LT_IDENTIFIER;
-        sourceLine.remove(0, tokenString.length());
-        return true;
-    }
-    if (firstChar == '\"') {
-        if (IsaParserHelper::rxStringConst.indexIn(sourceLine) == -1) {
-            tokenString = ";ERROR: Malformed string constant.";
-            return false;
-        }
-        token = IsaParserHelper::LT_STRING_CONSTANT;
-        tokenString = IsaParserHelper::rxStringConst.capturedTexts()[0];
-        sourceLine.remove(0, tokenString.length());
-        return true;
-    }
-    tokenString = ";ERROR: Syntax error.";
-    return false;
-}
-
 Enu::ESymbolFormat IsaAsm::primitiveType(QString formatTag) {
     if (formatTag.startsWith("#1c")) return Enu::ESymbolFormat::F_1C;
     if (formatTag.startsWith("#1d")) return Enu::ESymbolFormat::F_1D;
@@ -1575,27 +1536,50 @@ QStringList IsaAsm::extractTagList(QString comment)
     return out;
 }
 
-bool IsaParserHelper::startsWithHexPrefix(QString str)
+Enu::EAddrMode IsaParserHelper::stringToAddrMode(QStringView str)
 {
-    if (str.length() < 2) return false;
-    if (str[0] != '0') return false;
-    if (str[1] == 'x' || str[1] == 'X') return true;
+    str = str.mid(1).trimmed(); // Remove the comma.
+    auto is = [str](QStringView mode) {return str.compare(mode, Qt::CaseInsensitive) == 0;};
+    if (is(u"I")) return Enu::EAddrMode::I;
+    if (is(u"D")) return Enu::EAddrMode::D;
+    if (is(u"N")) return Enu::EAddrMode::N;
+    if (is(u"S")) return Enu::EAddrMode::S;
+    if (is(u"SF")) return Enu::EAddrMode::SF;
+    if (is(u"X")) return Enu::EAddrMode::X;
+    if (is(u"SX")) return Enu::EAddrMode::SX;
+    if (is(u"SFX")) return Enu::EAddrMode::SFX;
+    return Enu::EAddrMode::NONE;
+}
+
+bool IsaParserHelper::stringToMnemonic(QStringView str, Enu::EMnemonic &mnemonic)
+{
+    // The map is keyed by upper case names, so compare without converting str to a QString.
+    for (auto it = Pep::mnemonToEnumMap.constBegin(); it != Pep::mnemonToEnumMap.constEnd(); ++it) {
+        if (str.compare(it.key(), Qt::CaseInsensitive) == 0) {
+            mnemonic = it.value();
+            return true;
+        }
+    }
     return false;
 }
 
-Enu::EAddrMode IsaParserHelper::stringToAddrMode(QString str)
+int IsaParserHelper::stringToInt(QStringView str, int base, bool *ok)
 {
-    str.remove(0, 1); // Remove the comma.
-    str = str.trimmed().toUpper();
-    if (str == "I") return Enu::EAddrMode::I;
-    if (str == "D") return Enu::EAddrMode::D;
-    if (str == "N") return Enu::EAddrMode::N;
-    if (str == "S") return Enu::EAddrMode::S;
-    if (str == "SF") return Enu::EAddrMode::SF;
-    if (str == "X") return Enu::EAddrMode::X;
-    if (str == "SX") return Enu::EAddrMode::SX;
-    if (str == "SFX") return Enu::EAddrMode::SFX;
-    return Enu::EAddrMode::NONE;
+    bool negative = str.startsWith('-');
+    if (negative || str.startsWith('+')) {
+        str = str.mid(1);
+    }
+    // One more than INT_MAX may be represented if the value is negative.
+    qint64 limit = qint64{std::numeric_limits<int>::max()} + (negative ? 1 : 0);
+    qint64 value = 0;
+    for (QChar digit : str) {
+        int digitValue = digit.isDigit() ? digit.digitValue() : digit.toLower().unicode() - 'a' + 10;
+        value = value * base + digitValue;
+        if (value > limit) break;
+    }
+    *ok = !str.isEmpty() && value <= limit;
+    if (!*ok) return 0;
+    return static_cast<int>(negative ? -value : value);
 }
 
 int IsaParserHelper::charStringToInt(QString str)
@@ -1669,21 +1653,22 @@ void IsaParserHelper::unquotedStringToInt(QString &str, int &value)
     value += value < 0 ? 256 : 0;
 }
 
-int IsaParserHelper::byteStringLength(QString str)
+int IsaParserHelper::byteStringLength(QStringView str)
 {
-    str.remove(0, 1); // Remove the leftmost double quote.
-    str.chop(1); // Remove the rightmost double quote.
+    str = str.mid(1, str.size() - 2); // Remove the double quotes.
     int length = 0;
     while (str.length() > 0) {
-        if (str.startsWith("\\x") || str.startsWith("\\X")) {
-            str.remove(0, 4); // Remove the \xFF
+        int charLength;
+        if (str.startsWith(QLatin1String("\\x"), Qt::CaseInsensitive)) {
+            charLength = 4; // Remove the \xFF
         }
-        else if (str.startsWith("\\")) {
-            str.remove(0, 2); // Remove the quoted character
+        else if (str.startsWith('\\')) {
+            charLength = 2; // Remove the quoted character
         }
         else {
-            str.remove(0, 1); // Remove the single character
+            charLength = 1; // Remove the single character
         }
+        str = str.mid(qMin(charLength, static_cast<int>(str.size())));
         length++;
     }
     return length;
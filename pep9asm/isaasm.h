@@ -22,7 +22,12 @@
 #ifndef ASM_H
 #define ASM_H
 
+#include <atomic>
+
+#include <QHash>
 #include <QRegExp>
+#include <QSharedPointer>
+#include <QStringView>
 #include "enu.h"
 
 class AsmCode; // Forward declaration for argument of processSourceLine.
@@ -54,28 +59,22 @@ namespace IsaParserHelper
         PS_FINISH, PS_INSTRUCTION, PS_START, PS_STRING, PS_SYMBOL_DEF
     };
 
-    // Regular expressions for lexical analysis
-    extern QRegExp rxAddrMode;
-    extern QRegExp rxCharConst;
-    extern QRegExp rxComment;
-    extern QRegExp rxDecConst;
-    extern QRegExp rxDotCommand;
-    extern QRegExp rxHexConst;
-    extern QRegExp rxIdentifier;
-    extern QRegExp rxStringConst;
-
     // Regular expressions for trace tag analysis
     extern QRegExp rxFormatTag;
     extern QRegExp rxSymbolTag;
     extern QRegExp rxArrayMultiplier;
     extern QRegExp rxArrayTag;
 
-    bool startsWithHexPrefix(QString str);
-    // Post: Returns true if str starts with the characters 0x or 0X. Otherwise returns false.
-
-    Enu::EAddrMode stringToAddrMode(QString str);
+    Enu::EAddrMode stringToAddrMode(QStringView str);
     // Post: Returns the addressing mode integer defined in Pep from its string representation.
 
+    bool stringToMnemonic(QStringView str, Enu::EMnemonic &mnemonic);
+    // Post: If str is a mnemonic in any case, mnemonic is set to it and true is returned.
+
+    int stringToInt(QStringView str, int base, bool *ok);
+    // Pre: str is an optionally signed sequence of ASCII digits in base.
+    // Post: Returns the value of str, or 0 if it does not fit in an int, like QString::toInt(...).
+
     int charStringToInt(QString str);
     // Pre: str is enclosed in single quotes.
     // Post: Returns the ASCII integer value of the character accounting for \ quoted characters.
@@ -90,18 +89,71 @@ namespace IsaParserHelper
     // is stripped from the beginning of str.
     // Post: value is the ASCII integer value of the first possibly \ quoted character.
 
-    int byteStringLength(QString str);
+    int byteStringLength(QStringView str);
     // Pre: str is a double quoted string.
     // Post: Returns the byte length of str accounting for possibly \ quoted characters.
 
 }
 
+/*
+ * The result of parsing one line of source code, which does not depend on any other line.
+ * Addresses, line numbers, and symbols are assigned when the line is placed in a program.
+ */
+struct IsaParsedLine
+{
+    // Code for the line, without an address or symbols. Symbolic arguments and the padding
+    // of a .ALIGN are left unset. Comments and blank lines have an address of -1.
+    QSharedPointer<const AsmCode> code;
+    // Name of the symbol defined by the line, or empty if the line does not define one.
+    QString symbolDef;
+    // Name of the symbol used as the argument, or empty if the argument is not a symbol.
+    QString symbolRef;
+    // Number of bytes generated by the line, not including the padding of a .ALIGN.
+    int byteLength = 0;
+    // If the comment contains trace tags that must be checked against the symbol table.
+    bool hasTraceTags = false;
+};
+
+/*
+ * Remembers the parsed lines of a program between assemblies, so that re-assembling
+ * an edited program only parses the lines that were changed. Addresses and symbols
+ * depend on every preceding line, so they are assigned again by every assembly.
+ *
+ * Lines are keyed by their text rather than their line number, so lines that were moved,
+ * or shifted by inserting lines above them, are still found. Only the lines seen by the
+ * current and the previous assembly are retained.
+ *
+ * A cache may only be used by one assembler at a time.
+ */
+class IsaLineCache
+{
+public:
+    IsaLineCache();
+    // Post: If line was parsed by the current or previous assembly, parsed is set
+    // to the result and true is returned.
+    bool find(const QString& line, IsaParsedLine& parsed);
+    void insert(const QString& line, const IsaParsedLine& parsed);
+    // Mark the start of an assembly. Lines not used since the previous call are discarded.
+    void beginAssembly();
+    // Discard all cached lines.
+    void clear();
+
+private:
+    QHash<QString, IsaParsedLine> current, previous;
+};
+
 class StructType;
 class IsaAsm
 {
     AsmProgramManager& manager;
+    // If present, reuses the lines that were parsed by an earlier assembly.
+    IsaLineCache* lineCache;
+    // If present, used instead of the manager's operating system.
+    QSharedPointer<const AsmProgram> operatingSystem;
+    // If present and set, assembly of a user program stops before the next line.
+    const std::atomic<bool>* cancelFlag;
 public:
-    IsaAsm(AsmProgramManager& manager);
+    IsaAsm(AsmProgramManager& manager, IsaLineCache* lineCache = nullptr);
     ~IsaAsm();
 
     bool assembleUserProgram(const QString& progText, QSharedPointer<AsmProgram> &progOut,
@@ -116,6 +168,14 @@ public:
     // warnings regarding trace tags.
     // Note: will not automatically set manger's userProgram.
 
+    void setOperatingSystem(QSharedPointer<const AsmProgram> os);
+    // Post: charIn and charOut in user programs are resolved against os rather than
+    // the manager's operating system. Needed when assembling off the UI thread, since
+    // the manager's operating system may be replaced while a program is assembled.
+
+    void setCancelFlag(const std::atomic<bool>* flag);
+    // Post: If flag is set while assembling a user program, assembly fails before the next line
+    // is processed. flag may be set from any thread.
 
 
     bool assembleOperatingSystem(const QString& progText, bool forceBurnAt0xFFFF,
@@ -144,12 +204,6 @@ private:
     // Pre: codeList contains a valid program
     // Post: The address of every line of code in codeList is increase by addressDelta
 
-    bool getToken(QString &sourceLine, IsaParserHelper::ELexicalToken &token, QString &tokenString);
-    // Pre: sourceLine has one line of source code.
-    // Post: If the next token is valid, the string of characters representing the next token are deleted from the
-    // beginning of sourceLine and returned in tokenString, true is returned, and token is set to the token type.
-    // Post: If false is returned, then tokenString is set to the lexical error message.
-
     bool processSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTraceInfo& traceInfo, int& byteCount, QString sourceLine, int lineNum, AsmCode *&code, QString &errorString, bool &dotEndDetected, bool hasBreakpoint = false);
     // Pre: sourceLine has one line of source code.
     // Pre: lineNum is the line number of the source code.
@@ -158,6 +212,21 @@ private:
     // Post: Pep::byteCount is incremented by the number of bytes generated.
     // Post: If the source line is not valid, false is returned and errorString is set to the error message.
     // Post: Symbol format tags have been detected
+    // The line is parsed by parseSourceLine(...), unless it is found in the line cache,
+    // and is then placed in the program by placeSourceLine(...).
+
+    static bool parseSourceLine(const QString& sourceLine, IsaParsedLine& parsed, QString& errorString);
+    // Pre: sourceLine has one line of source code.
+    // Post: If the source line is valid, true is returned and parsed is set to the parsed line.
+    // Post: If the source line is not valid, false is returned and errorString is set to the error message.
+    // Errors that depend on other lines, such as multiply defined symbols, are reported by placeSourceLine(...).
+
+    static bool placeSourceLine(SymbolTable* symTable, BURNInfo& info, StaticTraceInfo& traceInfo, int& byteCount, const IsaParsedLine& parsed, int lineNum, AsmCode *&code, QString &errorString, bool &dotEndDetected, bool hasBreakpoint);
+    // Post: code is set to a copy of parsed.code at address byteCount, with its symbols taken from symTable.
+    // Post: byteCount is incremented by the number of bytes generated.
+    // Post: dotEndDetected is set to true if the line is a .END. Otherwise it is set to false.
+    // Post: If the symbol defined by the line was previously defined, false is returned and errorString is set to the error message.
+    // Post: Symbol format tags have been detected
 
     // Returns true if a primitive / array type tag is present. Does not look for symbol tags
     static bool hasTypeTag(QString comment);
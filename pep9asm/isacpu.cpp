@@ -23,6 +23,7 @@
 #include <QApplication>
 
 #include "acpumodel.h"
+#include "alutable.h"
 #include "amemorydevice.h"
 #include "asmprogrammanager.h"
 #include "asmprogram.h"
@@ -31,18 +32,28 @@
 #include "pep.h"
 
 IsaCpu::IsaCpu(const AsmProgramManager *manager, QSharedPointer<AMemoryDevice> memDevice, QObject *parent):
-    ACPUModel(memDevice, parent), InterfaceISACPU(memDevice.get(), manager), memoizer(new IsaCpuMemoizer(*this))
+    ACPUModel(memDevice, parent), InterfaceISACPU(memDevice.get(), manager), memoizer(new IsaCpuMemoizer(*this)),
+    decodeCache(1<<16), opcodeTable(), fastExecution(false)
 {
+    buildOpcodeTable();
     // Create & register callbacks for breakpoint interrupts.
     std::function<void(void)> bpHandler = [this](){breakpointAsmHandler();};
     ACPUModel::handler->registerHandler(Interrupts::BREAKPOINT_ASM, bpHandler);
+    // Observe memory directly, since a signal connection would make every write pay for an emission.
+    memDevice->addObserver(this);
 }
 
 IsaCpu::~IsaCpu()
 {
+    memory->removeObserver(this);
     delete memoizer;
 }
 
+void IsaCpu::onMemoryChanged(quint16 address, quint8)
+{
+    invalidateDecodeCache(address);
+}
+
 void IsaCpu::stepOver()
 {
     // Clear at start, so as to preserve highlighting AFTER finshing a write.
@@ -60,9 +71,9 @@ bool IsaCpu::canStepInto() const
 {
     quint8 byte;
     memory->getByte(getCPURegWordStart(Enu::CPURegisters::PC), byte);
-    Enu::EMnemonic mnemon = Pep::decodeMnemonic[byte];
+    Enu::EMnemonic mnemon = Pep::decodeMnemonic.at(byte);
     // Can only step into calls, trap instructions.
-    return (mnemon == Enu::EMnemonic::CALL) || Pep::isTrapMap[mnemon];
+    return (mnemon == Enu::EMnemonic::CALL) || Pep::isTrapMap.value(mnemon);
 }
 
 void IsaCpu::stepInto()
@@ -111,6 +122,16 @@ const RegisterFile &IsaCpu::getRegisterBank() const
     return registerBank;
 }
 
+void IsaCpu::setFastExecution(bool fast) noexcept
+{
+    fastExecution = fast;
+}
+
+bool IsaCpu::getFastExecution() const noexcept
+{
+    return fastExecution;
+}
+
 void IsaCpu::onISAStep()
 {
     asmBreakpointHit = false;
@@ -120,32 +141,27 @@ void IsaCpu::onISAStep()
     memory->onCycleStarted();
     InterfaceISACPU::calculateStackChangeStart(this->getCPURegByteStart(Enu::CPURegisters::IS));
 
-    // Load PC from register bank, allocate space for operand if it exists.
-    quint16 opSpec, pc = registerBank.readRegisterWordCurrent(Enu::CPURegisters::PC);
+    // Load PC from register bank, and fetch & decode the instruction it points to.
+    quint16 pc = registerBank.readRegisterWordCurrent(Enu::CPURegisters::PC);
     quint16 startPC = pc;
-    quint8 is;
-
-    bool okay = memory->readByte(pc, is);
+    decode_cache_entry instr;
 
-    registerBank.writeRegisterByte(Enu::CPURegisters::IS, is);
-    Enu::EMnemonic mnemon = Pep::decodeMnemonic[is];
-    Enu::EAddrMode addrMode;
+    bool okay = decodeInstruction(pc, instr);
 
+    registerBank.writeRegisterByte(Enu::CPURegisters::IS, instr.is);
     pc += 1;
     registerBank.writeRegisterWord(Enu::CPURegisters::PC, pc);
-    if(Pep::isTrapMap[mnemon]) {
-        executeTrap(mnemon);
+    if(instr.isTrap) {
+        executeTrap(instr.mnemon);
     }
-    else if(Pep::isUnaryMap[mnemon]) {
-        executeUnary(mnemon);
+    else if(instr.length == 1) {
+        executeUnary(instr.mnemon);
     }
     else {
-        okay &= memory->readWord(pc, opSpec);
-        registerBank.writeRegisterWord(Enu::CPURegisters::OS, opSpec);
-        addrMode = Pep::decodeAddrMode[is];
+        registerBank.writeRegisterWord(Enu::CPURegisters::OS, instr.opSpec);
         pc += 2;
         registerBank.writeRegisterWord(Enu::CPURegisters::PC, pc);
-        executeNonunary(mnemon, opSpec, addrMode);
+        executeNonunary(instr.mnemon, instr.opSpec, instr.addrMode);
     }
 
     if(!okay) {
@@ -168,12 +184,8 @@ void IsaCpu::onISAStep()
 
     registerBank.flattenFile();
 
-    // Modulus must be greater than 1, or there will be no gaurentee of forward progress.
-    // If modulus were 1, then debug debug breakpoints that were signaled externally
-    // during process events would never be cleared by branch handler.
-    if(asmInstructionCounter % 500 == 0) {
-        QApplication::processEvents();
-    }
+    // Give the event loop a chance to run, and honor external cancellation.
+    pollYield();
 
     // If execution finished on this instruction, then restore original starting program counter,
     // as the instruction at the current program counter will not be executed.
@@ -188,19 +200,76 @@ void IsaCpu::onISAStep()
     ACPUModel::handler->handleQueuedInterrupts();
 }
 
+void IsaCpu::onFastISAStep()
+{
+    // Load PC from register bank, and fetch & decode the instruction it points to.
+    quint16 pc = registerBank.readRegisterWordCurrent(Enu::CPURegisters::PC);
+    quint16 startPC = pc;
+    decode_cache_entry instr;
+
+    bool okay = decodeInstruction(pc, instr);
+
+    registerBank.writeRegisterByte(Enu::CPURegisters::IS, instr.is);
+    pc += 1;
+    registerBank.writeRegisterWord(Enu::CPURegisters::PC, pc);
+    std::invoke(instr.handler, this, instr);
+
+    if(!okay) {
+        controlError = true;
+        errorMessage = "Error: Failed to perform memory access.";
+    }
+
+    // Same call depth bookkeeping as updateAtInstructionEnd(), but decided
+    // from the decoded instruction rather than the mnemonic maps.
+    if(instr.isTrap || instr.mnemon == Enu::EMnemonic::CALL) {
+        callDepth++;
+    }
+    else if(instr.mnemon == Enu::EMnemonic::RET || instr.mnemon == Enu::EMnemonic::RETTR) {
+        callDepth--;
+    }
+    if(hadErrorOnStep()) {
+        executionFinished = true;
+    }
+    asmInstructionCounter++;
+
+    registerBank.flattenFile();
+
+    pollYield();
+
+    if(executionFinished || hadErrorOnStep()) {
+        registerBank.writePCStart(startPC);
+        emit simulationFinished();
+    }
+    ACPUModel::handler->handleQueuedInterrupts();
+}
+
+void IsaCpu::doISAStepWhile(std::function<bool ()> condition)
+{
+    if(!fastExecution || inDebug) {
+        InterfaceISACPU::doISAStepWhile(condition);
+        return;
+    }
+    // The fast engine does not track the stack, so any existing
+    // trace will no longer reflect the state of memory.
+    memTrace->activeStack->setStackIntact(false);
+    do{
+        onFastISAStep();
+    } while(condition());
+}
+
 void IsaCpu::updateAtInstructionEnd()
 {
     // Handle changing of call stack depth if the executed instruction affects the call stack.
-    if(Pep::decodeMnemonic[getRegisterBank().readRegisterByteCurrent(Enu::CPURegisters::IS)] == Enu::EMnemonic::CALL){
+    if(Pep::decodeMnemonic.at(getRegisterBank().readRegisterByteCurrent(Enu::CPURegisters::IS)) == Enu::EMnemonic::CALL){
         callDepth++;
     }
-    else if(Pep::isTrapMap[Pep::decodeMnemonic[getRegisterBank().readRegisterByteCurrent(Enu::CPURegisters::IS)]]){
+    else if(Pep::isTrapMap.value(Pep::decodeMnemonic.at(getRegisterBank().readRegisterByteCurrent(Enu::CPURegisters::IS)))){
         callDepth++;
     }
-    else if(Pep::decodeMnemonic[getRegisterBank().readRegisterByteCurrent(Enu::CPURegisters::IS)] == Enu::EMnemonic::RET){
+    else if(Pep::decodeMnemonic.at(getRegisterBank().readRegisterByteCurrent(Enu::CPURegisters::IS)) == Enu::EMnemonic::RET){
         callDepth--;
     }
-    else if(Pep::decodeMnemonic[getRegisterBank().readRegisterByteCurrent(Enu::CPURegisters::IS)] == Enu::EMnemonic::RETTR){
+    else if(Pep::decodeMnemonic.at(getRegisterBank().readRegisterByteCurrent(Enu::CPURegisters::IS)) == Enu::EMnemonic::RETTR){
         callDepth--;
     }
     if(hadErrorOnStep()) {
@@ -337,6 +406,11 @@ void IsaCpu::onSimulationStarted()
     asmBreakpointHit = false;
     memoizer->clear();
     memory->clearErrors();
+    // Memory may have been loaded with signals blocked, and the
+    // mnemonic maps may have been redefined since the last run.
+    buildOpcodeTable();
+    clearDecodeCache();
+    resetYieldPolicy();
     ACPUModel::handler->clearQueuedInterrupts();
 }
 
@@ -399,6 +473,8 @@ void IsaCpu::onResetCPU()
     ACPUModel::memory->clearErrors();
     ACPUModel::handler->clearQueuedInterrupts();
     memoizer->clear();
+    buildOpcodeTable();
+    clearDecodeCache();
     InterfaceISACPU::reset();
     inSimulation = false;
     inDebug = false;
@@ -412,6 +488,168 @@ void IsaCpu::onResetCPU()
 
 }
 
+bool IsaCpu::decodeInstruction(quint16 pc, decode_cache_entry &entry)
+{
+    // If the instruction at pc has been decoded, and no write has touched
+    // any of its bytes since, the cached copy is still correct.
+    if(decodeCache[pc].isValid) {
+        entry = decodeCache[pc];
+        return true;
+    }
+
+    quint8 is = 0;
+    bool okay = memory->readByte(pc, is);
+    entry = opcodeTable[is];
+    if(entry.length == 3) {
+        okay &= memory->readWord(static_cast<quint16>(pc + 1), entry.opSpec);
+    }
+
+    // Only remember instructions that were read successfully from memory
+    // whose contents can't change without a write (i.e. not memory-mapped IO).
+    bool cachable = okay;
+    for(quint16 offset = 0; cachable && offset < entry.length; offset++) {
+        cachable &= memory->isCachable(static_cast<quint16>(pc + offset));
+    }
+    entry.isValid = cachable;
+    if(cachable) {
+        decodeCache[pc] = entry;
+    }
+    return okay;
+}
+
+void IsaCpu::invalidateDecodeCache(quint16 address) noexcept
+{
+    // The longest instruction is 3 bytes, so the changed byte may belong
+    // to an instruction starting up to 2 bytes before it.
+    decodeCache[address].isValid = false;
+    decodeCache[static_cast<quint16>(address - 1)].isValid = false;
+    decodeCache[static_cast<quint16>(address - 2)].isValid = false;
+}
+
+void IsaCpu::clearDecodeCache() noexcept
+{
+    decodeCache.fill(decode_cache_entry());
+}
+
+void IsaCpu::buildOpcodeTable() noexcept
+{
+    for(int it = 0; it < 256; it++) {
+        decode_cache_entry& entry = opcodeTable[static_cast<std::size_t>(it)];
+        entry = decode_cache_entry();
+        entry.is = static_cast<quint8>(it);
+        entry.mnemon = Pep::decodeMnemonic.at(it);
+        if(Pep::isTrapMap.value(entry.mnemon)) {
+            entry.handler = trapHandler(entry.mnemon);
+            entry.isTrap = true;
+            entry.length = 1;
+        }
+        else if(Pep::isUnaryMap.value(entry.mnemon)) {
+            entry.handler = unaryHandler(entry.mnemon);
+            entry.length = 1;
+        }
+        else {
+            entry.addrMode = Pep::decodeAddrMode.at(it);
+            entry.handler = nonunaryHandler(entry.mnemon, entry.addrMode);
+            entry.length = 3;
+        }
+    }
+}
+
+IsaCpu::instruction_handler IsaCpu::trapHandler(Enu::EMnemonic mnemon) noexcept
+{
+    switch(mnemon) {
+    case Enu::EMnemonic::NOP0: return &IsaCpu::executeTrapFast<Enu::EMnemonic::NOP0>;
+    case Enu::EMnemonic::NOP1: return &IsaCpu::executeTrapFast<Enu::EMnemonic::NOP1>;
+    case Enu::EMnemonic::NOP: return &IsaCpu::executeTrapFast<Enu::EMnemonic::NOP>;
+    case Enu::EMnemonic::DECI: return &IsaCpu::executeTrapFast<Enu::EMnemonic::DECI>;
+    case Enu::EMnemonic::DECO: return &IsaCpu::executeTrapFast<Enu::EMnemonic::DECO>;
+    case Enu::EMnemonic::HEXO: return &IsaCpu::executeTrapFast<Enu::EMnemonic::HEXO>;
+    case Enu::EMnemonic::STRO: return &IsaCpu::executeTrapFast<Enu::EMnemonic::STRO>;
+    default: return &IsaCpu::executeInvalidFast;
+    }
+}
+
+IsaCpu::instruction_handler IsaCpu::unaryHandler(Enu::EMnemonic mnemon) noexcept
+{
+    switch(mnemon) {
+    case Enu::EMnemonic::STOP: return &IsaCpu::executeUnaryFast<Enu::EMnemonic::STOP>;
+    case Enu::EMnemonic::RET: return &IsaCpu::executeUnaryFast<Enu::EMnemonic::RET>;
+    case Enu::EMnemonic::RETTR: return &IsaCpu::executeUnaryFast<Enu::EMnemonic::RETTR>;
+    case Enu::EMnemonic::MOVSPA: return &IsaCpu::executeUnaryFast<Enu::EMnemonic::MOVSPA>;
+    case Enu::EMnemonic::MOVFLGA: return &IsaCpu::executeUnaryFast<Enu::EMnemonic::MOVFLGA>;
+    case Enu::EMnemonic::MOVAFLG: return &IsaCpu::executeUnaryFast<Enu::EMnemonic::MOVAFLG>;
+    case Enu::EMnemonic::NOTA: return &IsaCpu::executeUnaryFast<Enu::EMnemonic::NOTA>;
+    case Enu::EMnemonic::NOTX: return &IsaCpu::executeUnaryFast<Enu::EMnemonic::NOTX>;
+    case Enu::EMnemonic::NEGA: return &IsaCpu::executeUnaryFast<Enu::EMnemonic::NEGA>;
+    case Enu::EMnemonic::NEGX: return &IsaCpu::executeUnaryFast<Enu::EMnemonic::NEGX>;
+    case Enu::EMnemonic::ASLA: return &IsaCpu::executeUnaryFast<Enu::EMnemonic::ASLA>;
+    case Enu::EMnemonic::ASLX: return &IsaCpu::executeUnaryFast<Enu::EMnemonic::ASLX>;
+    case Enu::EMnemonic::ASRA: return &IsaCpu::executeUnaryFast<Enu::EMnemonic::ASRA>;
+    case Enu::EMnemonic::ASRX: return &IsaCpu::executeUnaryFast<Enu::EMnemonic::ASRX>;
+    case Enu::EMnemonic::RORA: return &IsaCpu::executeUnaryFast<Enu::EMnemonic::RORA>;
+    case Enu::EMnemonic::RORX: return &IsaCpu::executeUnaryFast<Enu::EMnemonic::RORX>;
+    case Enu::EMnemonic::ROLA: return &IsaCpu::executeUnaryFast<Enu::EMnemonic::ROLA>;
+    case Enu::EMnemonic::ROLX: return &IsaCpu::executeUnaryFast<Enu::EMnemonic::ROLX>;
+    case Enu::EMnemonic::NOP0: return &IsaCpu::executeUnaryFast<Enu::EMnemonic::NOP0>;
+    default: return &IsaCpu::executeInvalidFast;
+    }
+}
+
+template<Enu::EMnemonic mnemon>
+IsaCpu::instruction_handler IsaCpu::nonunaryHandler(Enu::EAddrMode addrMode) noexcept
+{
+    switch(addrMode) {
+    case Enu::EAddrMode::I: return &IsaCpu::executeNonunaryFast<mnemon, Enu::EAddrMode::I>;
+    case Enu::EAddrMode::D: return &IsaCpu::executeNonunaryFast<mnemon, Enu::EAddrMode::D>;
+    case Enu::EAddrMode::N: return &IsaCpu::executeNonunaryFast<mnemon, Enu::EAddrMode::N>;
+    case Enu::EAddrMode::S: return &IsaCpu::executeNonunaryFast<mnemon, Enu::EAddrMode::S>;
+    case Enu::EAddrMode::SF: return &IsaCpu::executeNonunaryFast<mnemon, Enu::EAddrMode::SF>;
+    case Enu::EAddrMode::X: return &IsaCpu::executeNonunaryFast<mnemon, Enu::EAddrMode::X>;
+    case Enu::EAddrMode::SX: return &IsaCpu::executeNonunaryFast<mnemon, Enu::EAddrMode::SX>;
+    case Enu::EAddrMode::SFX: return &IsaCpu::executeNonunaryFast<mnemon, Enu::EAddrMode::SFX>;
+    default: return &IsaCpu::executeInvalidFast;
+    }
+}
+
+IsaCpu::instruction_handler IsaCpu::nonunaryHandler(Enu::EMnemonic mnemon, Enu::EAddrMode addrMode) noexcept
+{
+    switch(mnemon) {
+    case Enu::EMnemonic::BR: return nonunaryHandler<Enu::EMnemonic::BR>(addrMode);
+    case Enu::EMnemonic::BRLE: return nonunaryHandler<Enu::EMnemonic::BRLE>(addrMode);
+    case Enu::EMnemonic::BRLT: return nonunaryHandler<Enu::EMnemonic::BRLT>(addrMode);
+    case Enu::EMnemonic::BREQ: return nonunaryHandler<Enu::EMnemonic::BREQ>(addrMode);
+    case Enu::EMnemonic::BRNE: return nonunaryHandler<Enu::EMnemonic::BRNE>(addrMode);
+    case Enu::EMnemonic::BRGE: return nonunaryHandler<Enu::EMnemonic::BRGE>(addrMode);
+    case Enu::EMnemonic::BRGT: return nonunaryHandler<Enu::EMnemonic::BRGT>(addrMode);
+    case Enu::EMnemonic::BRV: return nonunaryHandler<Enu::EMnemonic::BRV>(addrMode);
+    case Enu::EMnemonic::BRC: return nonunaryHandler<Enu::EMnemonic::BRC>(addrMode);
+    case Enu::EMnemonic::CALL: return nonunaryHandler<Enu::EMnemonic::CALL>(addrMode);
+    case Enu::EMnemonic::ADDSP: return nonunaryHandler<Enu::EMnemonic::ADDSP>(addrMode);
+    case Enu::EMnemonic::SUBSP: return nonunaryHandler<Enu::EMnemonic::SUBSP>(addrMode);
+    case Enu::EMnemonic::ADDA: return nonunaryHandler<Enu::EMnemonic::ADDA>(addrMode);
+    case Enu::EMnemonic::ADDX: return nonunaryHandler<Enu::EMnemonic::ADDX>(addrMode);
+    case Enu::EMnemonic::SUBA: return nonunaryHandler<Enu::EMnemonic::SUBA>(addrMode);
+    case Enu::EMnemonic::SUBX: return nonunaryHandler<Enu::EMnemonic::SUBX>(addrMode);
+    case Enu::EMnemonic::ANDA: return nonunaryHandler<Enu::EMnemonic::ANDA>(addrMode);
+    case Enu::EMnemonic::ANDX: return nonunaryHandler<Enu::EMnemonic::ANDX>(addrMode);
+    case Enu::EMnemonic::ORA: return nonunaryHandler<Enu::EMnemonic::ORA>(addrMode);
+    case Enu::EMnemonic::ORX: return nonunaryHandler<Enu::EMnemonic::ORX>(addrMode);
+    case Enu::EMnemonic::CPWA: return nonunaryHandler<Enu::EMnemonic::CPWA>(addrMode);
+    case Enu::EMnemonic::CPWX: return nonunaryHandler<Enu::EMnemonic::CPWX>(addrMode);
+    case Enu::EMnemonic::LDWA: return nonunaryHandler<Enu::EMnemonic::LDWA>(addrMode);
+    case Enu::EMnemonic::LDWX: return nonunaryHandler<Enu::EMnemonic::LDWX>(addrMode);
+    case Enu::EMnemonic::STWA: return nonunaryHandler<Enu::EMnemonic::STWA>(addrMode);
+    case Enu::EMnemonic::STWX: return nonunaryHandler<Enu::EMnemonic::STWX>(addrMode);
+    case Enu::EMnemonic::CPBA: return nonunaryHandler<Enu::EMnemonic::CPBA>(addrMode);
+    case Enu::EMnemonic::CPBX: return nonunaryHandler<Enu::EMnemonic::CPBX>(addrMode);
+    case Enu::EMnemonic::LDBA: return nonunaryHandler<Enu::EMnemonic::LDBA>(addrMode);
+    case Enu::EMnemonic::LDBX: return nonunaryHandler<Enu::EMnemonic::LDBX>(addrMode);
+    case Enu::EMnemonic::STBA: return nonunaryHandler<Enu::EMnemonic::STBA>(addrMode);
+    case Enu::EMnemonic::STBX: return nonunaryHandler<Enu::EMnemonic::STBX>(addrMode);
+    default: return &IsaCpu::executeInvalidFast;
+    }
+}
+
 bool IsaCpu::operandWordValueHelper(quint16 operand, Enu::EAddrMode addrMode,
                                bool (AMemoryDevice::*readFunc)(quint16, quint16 &) const,
                                quint16 &opVal)
@@ -629,10 +867,16 @@ bool IsaCpu::writeOperandByte(quint16 operand, quint8 value, Enu::EAddrMode addr
     return rVal;
 }
 
+void IsaCpu::writeStatusBitsMasked(quint8 NZVC, quint8 mask)
+{
+    quint8 bits = registerBank.readStatusBitsCurrent();
+    registerBank.writeStatusBits(static_cast<quint8>((bits & ~mask) | (NZVC & mask)));
+}
+
 void IsaCpu::executeUnary(Enu::EMnemonic mnemon)
 {
     quint16 temp, sp, acc, idx;
-    quint8 tempByte;
+    quint8 tempByte, NZVC;
     sp = registerBank.readRegisterWordCurrent(Enu::CPURegisters::SP);
     acc = registerBank.readRegisterWordCurrent(Enu::CPURegisters::A);
     idx = registerBank.readRegisterWordCurrent(Enu::CPURegisters::X);
@@ -718,106 +962,56 @@ void IsaCpu::executeUnary(Enu::EMnemonic mnemon)
 
     // Arithmetic shift instructions
     case Enu::EMnemonic::ASLA: // Modifies NZVC bits
-        temp = static_cast<quint16>(acc << 1);
+        temp = ALU::shiftLeftWord(acc, false, false, NZVC);
         registerBank.writeRegisterWord(Enu::CPURegisters::A, temp);
-        // Is negative if high order bit is 1.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_N, temp & 0x8000);
-         // Is zero if all bits are 0's.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_Z, temp == 0);
-        // Signed overflow occurs when the starting & ending values of the high order bit differ (a xor temp == 1).
-        // Then shift the result over by 15 places to only keep high order bit (which is the sign).
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_V, (acc ^ temp) >> 15);
-        // Carry out if register starts with high order 1.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_C, acc & 0x8000);
+        writeStatusBitsMasked(NZVC, Enu::NMask | Enu::ZMask | Enu::VMask | Enu::CMask);
         break;
 
     case Enu::EMnemonic::ASLX: // Modifies NZVC bits
-        temp = static_cast<quint16>(idx << 1);
+        temp = ALU::shiftLeftWord(idx, false, false, NZVC);
         registerBank.writeRegisterWord(Enu::CPURegisters::X, temp);
-        // Is negative if high order bit is 1.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_N, temp & 0x8000);
-         // Is zero if all bits are 0's.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_Z, temp == 0);
-        // Signed overflow occurs when the starting & ending values of the high order bit differ (a xor temp == 1).
-        // Then shift the result over by 15 places to only keep high order bit (which is the sign).
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_V, (idx ^ temp) >> 15);
-        // Carry out if register starts with high order 1.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_C, idx & 0x8000);
-
+        writeStatusBitsMasked(NZVC, Enu::NMask | Enu::ZMask | Enu::VMask | Enu::CMask);
         break;
 
     case Enu::EMnemonic::ASRA: // Modifies NZC bits
-        // Shift all bits to the right by 1 position. Since using unsigned shift, must explicitly
-        // perform sign extension by hand.
-        temp = static_cast<quint16>(acc >> 1 |
-                                    // If the high order bit is 1, then sign extend with 1, else 0.
-                                    ((acc & 0x8000) ? 1<<15 : 0));
+        temp = ALU::shiftRightWord(acc, false, false, NZVC);
         registerBank.writeRegisterWord(Enu::CPURegisters::A, temp);
-        // Is negative if high order bit is 1.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_N, temp & 0x8000);
-         // Is zero if all bits are 0's.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_Z, temp == 0);
-        // Carry out if register starts with low order 1.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_C, acc & 0x01);
+        writeStatusBitsMasked(NZVC, Enu::NMask | Enu::ZMask | Enu::CMask);
         break;
 
     case Enu::EMnemonic::ASRX: // Modifies NZC bits
-        // Shift all bits to the right by 1 position. Since using unsigned shift, must explicitly
-        // perform sign extension by hand.
-        temp = static_cast<quint16>(idx >> 1 |
-                                    // If the high order bit is 1, then sign extend with 1, else 0.
-                                    ((idx & 0x8000) ? 1<<15 : 0));
+        temp = ALU::shiftRightWord(idx, false, false, NZVC);
         registerBank.writeRegisterWord(Enu::CPURegisters::X, temp);
-        // Is negative if high order bit is 1.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_N, temp & 0x8000);
-         // Is zero if all bits are 0's.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_Z, temp == 0);
-        // Carry out if register starts with low order 1.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_C, idx & 0x01);
+        writeStatusBitsMasked(NZVC, Enu::NMask | Enu::ZMask | Enu::CMask);
         break;
 
     // Rotate instructions.
     case Enu::EMnemonic::RORA: // Modifies C bits
-        temp = static_cast<quint16>(acc >> 1
-                                    // Shift the carry to high order bit.
-                                    | (registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_C)
-                                        ? 1<<15 : 0));
+        temp = ALU::shiftRightWord(acc, registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_C), true, NZVC);
         registerBank.writeRegisterWord(Enu::CPURegisters::A, temp);
-        // Carry out if register starts with low order 1.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_C, acc & 0x01);
+        writeStatusBitsMasked(NZVC, Enu::CMask);
         break;
 
     case Enu::EMnemonic::RORX: // Modifies C bit
-        temp = static_cast<quint16>(idx >> 1
-                                    // Shift the carry to high order bit.
-                                    | (registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_C)
-                                        ? 1<<15 : 0));
+        temp = ALU::shiftRightWord(idx, registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_C), true, NZVC);
         registerBank.writeRegisterWord(Enu::CPURegisters::X, temp);
-        // Carry out if register starts with low order 1.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_C, idx & 0x01);
+        writeStatusBitsMasked(NZVC, Enu::CMask);
         break;
 
     case Enu::EMnemonic::ROLA: // Modifies C bit
-        temp = static_cast<quint16>(acc << 1
-                                    // Shift the carry in to low order bit.
-                                    | (registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_C)
-                                        ? 1 : 0));
+        temp = ALU::shiftLeftWord(acc, registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_C), true, NZVC);
         registerBank.writeRegisterWord(Enu::CPURegisters::A, temp);
-        // Carry out if register starts with high order 1.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_C, acc & 0x8000);
+        writeStatusBitsMasked(NZVC, Enu::CMask);
         break;
 
     case Enu::EMnemonic::ROLX: // Modifies C bit
-        temp = static_cast<quint16>(acc << 1
-                                    // Shift the carry in to low order bit.
-                                    | (registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_C)
-                                        ? 1 : 0));
+        temp = ALU::shiftLeftWord(idx, registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_C), true, NZVC);
         registerBank.writeRegisterWord(Enu::CPURegisters::X, temp);
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_C, idx & 0x8000);
+        writeStatusBitsMasked(NZVC, Enu::CMask);
         break;
 
     case Enu::EMnemonic::NOP0:
-        if(Pep::isTrapMap[Enu::EMnemonic::NOP0]) {
+        if(Pep::isTrapMap.value(Enu::EMnemonic::NOP0)) {
             controlError = true;
             executionFinished = true;
             errorMessage = "Error: NOP0 is not a unary instruction.";
@@ -835,7 +1029,7 @@ void IsaCpu::executeUnary(Enu::EMnemonic mnemon)
 void IsaCpu::executeNonunary(Enu::EMnemonic mnemon, quint16 opSpec, Enu::EAddrMode addrMode)
 {
     quint16 tempWord, a, x, sp, result;
-    quint8 tempByte;
+    quint8 tempByte, NZVC;
     a = registerBank.readRegisterWordCurrent(Enu::CPURegisters::A);
     x = registerBank.readRegisterWordCurrent(Enu::CPURegisters::X);
     sp = registerBank.readRegisterWordCurrent(Enu::CPURegisters::SP);
@@ -930,73 +1124,33 @@ void IsaCpu::executeNonunary(Enu::EMnemonic mnemon, quint16 opSpec, Enu::EAddrMo
     case Enu::EMnemonic::ADDA:
         memSuccess = readOperandWordValue(opSpec, addrMode, tempWord);
         // The result is the decoded operand specifier plus the accumulator
-        result = a + tempWord;
+        result = ALU::addWords(a, tempWord, NZVC);
         registerBank.writeRegisterWord(Enu::CPURegisters::A, result);
-        // Is negative if high order bit is 1.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_N, result & 0x8000);
-         // Is zero if all bits are 0's.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_Z, result == 0);
-        // There is a signed overflow iff the high order bits of the register and operand
-        //are the same, and one input & the output differ in sign.
-        // >> Shifts in 0's (unsigned shorts), so after shift, only high order bit remain.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_V, (~(a ^ tempWord) & (a ^ result)) >> 15);
-        // Carry out iff result is unsigned less than register or operand.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_C, result < a  || result < tempWord);
+        writeStatusBitsMasked(NZVC, Enu::NMask | Enu::ZMask | Enu::VMask | Enu::CMask);
         break;
 
     case Enu::EMnemonic::ADDX:
         memSuccess = readOperandWordValue(opSpec, addrMode, tempWord);
         // The result is the decoded operand specifier plus the index reg.
-        result = x + tempWord;
+        result = ALU::addWords(x, tempWord, NZVC);
         registerBank.writeRegisterWord(Enu::CPURegisters::X, result);
-        // Is negative if high order bit is 1.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_N, result & 0x8000);
-         // Is zero if all bits are 0's.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_Z, result == 0);
-        // There is a signed overflow iff the high order bits of the register and operand
-        //are the same, and one input & the output differ in sign.
-        // >> Shifts in 0's (unsigned shorts), so after shift, only high order bit remain.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_V, (~(x ^ tempWord) & (x ^ result)) >> 15);
-        // Carry out iff result is unsigned less than register or operand.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_C, result < x  || result < tempWord);
+        writeStatusBitsMasked(NZVC, Enu::NMask | Enu::ZMask | Enu::VMask | Enu::CMask);
         break;
 
     case Enu::EMnemonic::SUBA:
         memSuccess = readOperandWordValue(opSpec, addrMode, tempWord);
-        // The result is the two's complement of the decoded operand specifier plus a.
-        tempWord = ~tempWord + 1;
-        // The result is the decoded operand specifier plus the accumulator.
-        result = a + tempWord;
+        // The result is a minus the decoded operand specifier.
+        result = ALU::subtractWords(a, tempWord, NZVC);
         registerBank.writeRegisterWord(Enu::CPURegisters::A, result);
-        // Is negative if high order bit is 1.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_N, result & 0x8000);
-         // Is zero if all bits are 0's.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_Z, result == 0);
-        // There is a signed overflow iff the high order bits of the register and operand
-        //are the same, and one input & the output differ in sign.
-        // >> Shifts in 0's (unsigned shorts), so after shift, only high order bit remain.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_V, (~(a ^ tempWord) & (a ^ result)) >> 15);
-        // Carry out iff result is unsigned less than register or operand.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_C, result < a  || result < tempWord);
+        writeStatusBitsMasked(NZVC, Enu::NMask | Enu::ZMask | Enu::VMask | Enu::CMask);
         break;
 
     case Enu::EMnemonic::SUBX:
         memSuccess = readOperandWordValue(opSpec, addrMode, tempWord);
-        // The result is the two's complement of the decoded operand specifier plus a.
-        tempWord = ~tempWord + 1;
-        // The result is the decoded operand specifier plus the index reg.
-        result = x + tempWord;
+        // The result is x minus the decoded operand specifier.
+        result = ALU::subtractWords(x, tempWord, NZVC);
         registerBank.writeRegisterWord(Enu::CPURegisters::X, result);
-        // Is negative if high order bit is 1.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_N, result & 0x8000);
-         // Is zero if all bits are 0's.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_Z, result == 0);
-        // There is a signed overflow iff the high order bits of the register and operand
-        //are the same, and one input & the output differ in sign.
-        // >> Shifts in 0's (unsigned shorts), so after shift, only high order bit remain.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_V, (~(x ^ tempWord) & (x ^ result)) >> 15);
-        // Carry out iff result is unsigned less than register or operand.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_C, result < x  || result < tempWord);
+        writeStatusBitsMasked(NZVC, Enu::NMask | Enu::ZMask | Enu::VMask | Enu::CMask);
         break;
 
     case Enu::EMnemonic::ANDA:
@@ -1044,42 +1198,20 @@ void IsaCpu::executeNonunary(Enu::EMnemonic mnemon, quint16 opSpec, Enu::EAddrMo
 
     case Enu::EMnemonic::CPWA:
         memSuccess = readOperandWordValue(opSpec, addrMode, tempWord);
-        // The result is the two's complement of the decoded operand specifier plus a.
-        tempWord = ~tempWord + 1;
-        result = a + tempWord;
-        // Is negative if high order bit is 1.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_N, result & 0x8000);
-         // Is zero if all bits are 0's.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_Z, result == 0);
-        // There is a signed overflow iff the high order bits of the register and operand
-        //are the same, and one input & the output differ in sign.
-        // >> Shifts in 0's (unsigned shorts), so after shift, only high order bit remain.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_V, (~(a ^  tempWord) & (a ^ result)) >> 15);
-        // Carry out iff result is unsigned less than register or operand.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_C, result < a  || result < tempWord);
+        // The status bits are those of a minus the decoded operand specifier.
+        ALU::subtractWords(a, tempWord, NZVC);
         // If there was a signed overflow, selectively invert N bit.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_N, registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_N)
-                                    ^ registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_V));
+        if(NZVC & Enu::VMask) NZVC ^= Enu::NMask;
+        writeStatusBitsMasked(NZVC, Enu::NMask | Enu::ZMask | Enu::VMask | Enu::CMask);
         break;
 
     case Enu::EMnemonic::CPWX:
         memSuccess = readOperandWordValue(opSpec, addrMode, tempWord);
-        // The result is the two's complement of the decoded operand specifier plus x.
-        tempWord = ~tempWord + 1;
-        result = x + tempWord;
-        // Is negative if high order bit is 1.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_N, result & 0x8000);
-         // Is zero if all bits are 0's.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_Z, result == 0);
-        // There is a signed overflow iff the high order bits of the register and operand
-        //are the same, and one input & the output differ in sign.
-        // >> Shifts in 0's (unsigned shorts), so after shift, only high order bit remain.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_V, (~(x ^ tempWord) & (x ^ result)) >> 15);
-        // Carry out iff result is unsigned less than register or operand.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_C, result < a  || result < tempWord);
+        // The status bits are those of x minus the decoded operand specifier.
+        ALU::subtractWords(x, tempWord, NZVC);
         // If there was a signed overflow, selectively invert N bit.
-        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_N, registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_N)
-                                    ^ registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_V));
+        if(NZVC & Enu::VMask) NZVC ^= Enu::NMask;
+        writeStatusBitsMasked(NZVC, Enu::NMask | Enu::ZMask | Enu::VMask | Enu::CMask);
         break;
 
     case Enu::EMnemonic::LDWA:
@@ -1248,6 +1380,399 @@ void IsaCpu::executeTrap(Enu::EMnemonic mnemon)
     }
 }
 
+namespace {
+// Register operated on by instructions that come in both an A and an X flavor.
+template<Enu::EMnemonic mnemon>
+constexpr Enu::CPURegisters operandRegister() noexcept
+{
+    switch(mnemon) {
+    case Enu::EMnemonic::NOTA: [[fallthrough]];
+    case Enu::EMnemonic::NEGA: [[fallthrough]];
+    case Enu::EMnemonic::ASLA: [[fallthrough]];
+    case Enu::EMnemonic::ASRA: [[fallthrough]];
+    case Enu::EMnemonic::RORA: [[fallthrough]];
+    case Enu::EMnemonic::ROLA: [[fallthrough]];
+    case Enu::EMnemonic::ADDA: [[fallthrough]];
+    case Enu::EMnemonic::SUBA: [[fallthrough]];
+    case Enu::EMnemonic::ANDA: [[fallthrough]];
+    case Enu::EMnemonic::ORA: [[fallthrough]];
+    case Enu::EMnemonic::CPWA: [[fallthrough]];
+    case Enu::EMnemonic::LDWA: [[fallthrough]];
+    case Enu::EMnemonic::STWA: [[fallthrough]];
+    case Enu::EMnemonic::CPBA: [[fallthrough]];
+    case Enu::EMnemonic::LDBA: [[fallthrough]];
+    case Enu::EMnemonic::STBA:
+        return Enu::CPURegisters::A;
+    default:
+        return Enu::CPURegisters::X;
+    }
+}
+}
+
+template<Enu::EAddrMode addrMode>
+bool IsaCpu::effectiveAddressFast(quint16 operand, quint16 &address)
+{
+    static_assert(addrMode != Enu::EAddrMode::I, "Immediate operands have no effective address.");
+    bool rVal = true;
+    if constexpr(addrMode == Enu::EAddrMode::D || addrMode == Enu::EAddrMode::N) {
+        address = operand;
+    }
+    else if constexpr(addrMode == Enu::EAddrMode::S || addrMode == Enu::EAddrMode::SF
+                      || addrMode == Enu::EAddrMode::SFX) {
+        address = operand + registerBank.readRegisterWordCurrent(Enu::CPURegisters::SP);
+    }
+    else if constexpr(addrMode == Enu::EAddrMode::X) {
+        address = operand + registerBank.readRegisterWordCurrent(Enu::CPURegisters::X);
+    }
+    else if constexpr(addrMode == Enu::EAddrMode::SX) {
+        address = operand
+                + registerBank.readRegisterWordCurrent(Enu::CPURegisters::SP)
+                + registerBank.readRegisterWordCurrent(Enu::CPURegisters::X);
+    }
+    // Indirect modes find the address of the operand in memory.
+    if constexpr(addrMode == Enu::EAddrMode::N || addrMode == Enu::EAddrMode::SF
+                 || addrMode == Enu::EAddrMode::SFX) {
+        rVal = memory->readWord(address, address);
+    }
+    if constexpr(addrMode == Enu::EAddrMode::SFX) {
+        address += registerBank.readRegisterWordCurrent(Enu::CPURegisters::X);
+    }
+    return rVal;
+}
+
+template<Enu::EAddrMode addrMode>
+bool IsaCpu::readOperandWordFast(quint16 operand, quint16 &opVal)
+{
+    bool rVal = true;
+    if constexpr(addrMode == Enu::EAddrMode::I) {
+        opVal = operand;
+    }
+    else {
+        quint16 effectiveAddress = 0;
+        rVal = effectiveAddressFast<addrMode>(operand, effectiveAddress);
+        rVal &= memory->readWord(effectiveAddress, opVal);
+    }
+    // Same as readOperandWordValue(...), cache the decoded operand value.
+    InterfaceISACPU::opValCache = opVal;
+    return rVal;
+}
+
+template<Enu::EAddrMode addrMode>
+bool IsaCpu::readOperandByteFast(quint16 operand, quint8 &opVal)
+{
+    bool rVal = true;
+    if constexpr(addrMode == Enu::EAddrMode::I) {
+        opVal = static_cast<quint8>(operand & 0xff);
+    }
+    else {
+        quint16 effectiveAddress = 0;
+        rVal = effectiveAddressFast<addrMode>(operand, effectiveAddress);
+        rVal &= memory->readByte(effectiveAddress, opVal);
+    }
+    InterfaceISACPU::opValCache = opVal;
+    return rVal;
+}
+
+template<Enu::EAddrMode addrMode>
+bool IsaCpu::writeOperandWordFast(quint16 operand, quint16 value)
+{
+    // Immediate operands can't be written to.
+    bool rVal = false;
+    quint16 effectiveAddress = 0;
+    if constexpr(addrMode != Enu::EAddrMode::I) {
+        rVal = effectiveAddressFast<addrMode>(operand, effectiveAddress);
+        rVal &= memory->writeWord(effectiveAddress, value);
+    }
+    // Same as writeOperandWord(...), cache the address that was written.
+    InterfaceISACPU::opValCache = effectiveAddress;
+    return rVal;
+}
+
+template<Enu::EAddrMode addrMode>
+bool IsaCpu::writeOperandByteFast(quint16 operand, quint8 value)
+{
+    bool rVal = false;
+    quint16 effectiveAddress = 0;
+    if constexpr(addrMode != Enu::EAddrMode::I) {
+        rVal = effectiveAddressFast<addrMode>(operand, effectiveAddress);
+        rVal &= memory->writeByte(effectiveAddress, value);
+    }
+    InterfaceISACPU::opValCache = effectiveAddress;
+    return rVal;
+}
+
+template<Enu::EMnemonic mnemon>
+void IsaCpu::executeUnaryFast(const decode_cache_entry &)
+{
+    constexpr Enu::CPURegisters reg = operandRegister<mnemon>();
+    if constexpr(mnemon == Enu::EMnemonic::STOP) {
+        executionFinished = true;
+    }
+    else if constexpr(mnemon == Enu::EMnemonic::RET) {
+        quint16 sp = registerBank.readRegisterWordCurrent(Enu::CPURegisters::SP), temp;
+        memory->readWord(sp, temp);
+        registerBank.writeRegisterWord(Enu::CPURegisters::PC, temp);
+        registerBank.writeRegisterWord(Enu::CPURegisters::SP, sp + 2);
+    }
+    else if constexpr(mnemon == Enu::EMnemonic::RETTR) {
+        quint16 sp = registerBank.readRegisterWordCurrent(Enu::CPURegisters::SP), temp;
+        quint8 tempByte;
+        memory->readByte(sp, tempByte);
+        registerBank.writeStatusBits(tempByte);
+        memory->readWord(sp + 1, temp);
+        registerBank.writeRegisterWord(Enu::CPURegisters::A, temp);
+        memory->readWord(sp + 3, temp);
+        registerBank.writeRegisterWord(Enu::CPURegisters::X, temp);
+        memory->readWord(sp + 5, temp);
+        registerBank.writeRegisterWord(Enu::CPURegisters::PC, temp);
+        memory->readWord(sp + 7, temp);
+        registerBank.writeRegisterWord(Enu::CPURegisters::SP, temp);
+    }
+    else if constexpr(mnemon == Enu::EMnemonic::MOVSPA) {
+        registerBank.writeRegisterWord(Enu::CPURegisters::A,
+                                       registerBank.readRegisterWordCurrent(Enu::CPURegisters::SP));
+    }
+    else if constexpr(mnemon == Enu::EMnemonic::MOVFLGA) {
+        registerBank.writeRegisterWord(Enu::CPURegisters::A, registerBank.readStatusBitsCurrent());
+    }
+    else if constexpr(mnemon == Enu::EMnemonic::MOVAFLG) {
+        registerBank.writeStatusBits(static_cast<quint8>(registerBank.readRegisterWordCurrent(Enu::CPURegisters::A)));
+    }
+    else if constexpr(mnemon == Enu::EMnemonic::NOTA || mnemon == Enu::EMnemonic::NOTX) {
+        quint16 temp = ~registerBank.readRegisterWordCurrent(reg);
+        registerBank.writeRegisterWord(reg, temp);
+        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_N, temp & 0x8000);
+        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_Z, temp == 0);
+    }
+    else if constexpr(mnemon == Enu::EMnemonic::NEGA || mnemon == Enu::EMnemonic::NEGX) {
+        quint16 temp = ~registerBank.readRegisterWordCurrent(reg) + 1;
+        registerBank.writeRegisterWord(reg, temp);
+        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_N, temp & 0x8000);
+        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_Z, temp == 0);
+        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_V, temp == 0x8000);
+    }
+    else if constexpr(mnemon == Enu::EMnemonic::ASLA || mnemon == Enu::EMnemonic::ASLX) {
+        quint8 NZVC;
+        registerBank.writeRegisterWord(reg, ALU::shiftLeftWord(registerBank.readRegisterWordCurrent(reg),
+                                                               false, false, NZVC));
+        writeStatusBitsMasked(NZVC, Enu::NMask | Enu::ZMask | Enu::VMask | Enu::CMask);
+    }
+    else if constexpr(mnemon == Enu::EMnemonic::ASRA || mnemon == Enu::EMnemonic::ASRX) {
+        quint8 NZVC;
+        registerBank.writeRegisterWord(reg, ALU::shiftRightWord(registerBank.readRegisterWordCurrent(reg),
+                                                                false, false, NZVC));
+        writeStatusBitsMasked(NZVC, Enu::NMask | Enu::ZMask | Enu::CMask);
+    }
+    else if constexpr(mnemon == Enu::EMnemonic::RORA || mnemon == Enu::EMnemonic::RORX) {
+        quint8 NZVC;
+        registerBank.writeRegisterWord(reg, ALU::shiftRightWord(registerBank.readRegisterWordCurrent(reg),
+                                                                registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_C),
+                                                                true, NZVC));
+        writeStatusBitsMasked(NZVC, Enu::CMask);
+    }
+    else if constexpr(mnemon == Enu::EMnemonic::ROLA || mnemon == Enu::EMnemonic::ROLX) {
+        quint8 NZVC;
+        registerBank.writeRegisterWord(reg, ALU::shiftLeftWord(registerBank.readRegisterWordCurrent(reg),
+                                                               registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_C),
+                                                               true, NZVC));
+        writeStatusBitsMasked(NZVC, Enu::CMask);
+    }
+    else {
+        // buildOpcodeTable() only selects NOP0 when it is not a trap, so there is nothing to do.
+        static_assert(mnemon == Enu::EMnemonic::NOP0, "Unhandled unary instruction.");
+    }
+}
+
+template<Enu::EMnemonic mnemon, Enu::EAddrMode addrMode>
+void IsaCpu::executeNonunaryFast(const decode_cache_entry &entry)
+{
+    constexpr Enu::CPURegisters reg = operandRegister<mnemon>();
+    registerBank.writeRegisterWord(Enu::CPURegisters::OS, entry.opSpec);
+    quint16 pc = registerBank.readRegisterWordCurrent(Enu::CPURegisters::PC) + 2;
+    registerBank.writeRegisterWord(Enu::CPURegisters::PC, pc);
+    quint16 opVal = 0;
+    bool memSuccess = true;
+
+    if constexpr(mnemon == Enu::EMnemonic::BR || mnemon == Enu::EMnemonic::BRLE
+                 || mnemon == Enu::EMnemonic::BRLT || mnemon == Enu::EMnemonic::BREQ
+                 || mnemon == Enu::EMnemonic::BRNE || mnemon == Enu::EMnemonic::BRGE
+                 || mnemon == Enu::EMnemonic::BRGT || mnemon == Enu::EMnemonic::BRV
+                 || mnemon == Enu::EMnemonic::BRC) {
+        bool taken = true;
+        if constexpr(mnemon == Enu::EMnemonic::BRLE) {
+            taken = registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_N) ||
+                    registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_Z);
+        }
+        else if constexpr(mnemon == Enu::EMnemonic::BRLT) {
+            taken = registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_N);
+        }
+        else if constexpr(mnemon == Enu::EMnemonic::BREQ) {
+            taken = registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_Z);
+        }
+        else if constexpr(mnemon == Enu::EMnemonic::BRNE) {
+            taken = !registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_Z);
+        }
+        else if constexpr(mnemon == Enu::EMnemonic::BRGE) {
+            taken = !registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_N);
+        }
+        else if constexpr(mnemon == Enu::EMnemonic::BRGT) {
+            taken = !registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_N) &&
+                    !registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_Z);
+        }
+        else if constexpr(mnemon == Enu::EMnemonic::BRV) {
+            taken = registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_V);
+        }
+        else if constexpr(mnemon == Enu::EMnemonic::BRC) {
+            taken = registerBank.readStatusBitCurrent(Enu::EStatusBit::STATUS_C);
+        }
+        if(taken) {
+            memSuccess = readOperandWordFast<addrMode>(entry.opSpec, opVal);
+            registerBank.writeRegisterWord(Enu::CPURegisters::PC, opVal);
+        }
+    }
+    else if constexpr(mnemon == Enu::EMnemonic::CALL) {
+        memSuccess = readOperandWordFast<addrMode>(entry.opSpec, opVal);
+        quint16 sp = registerBank.readRegisterWordCurrent(Enu::CPURegisters::SP) - 2;
+        memSuccess &= memory->writeWord(sp, pc);
+        registerBank.writeRegisterWord(Enu::CPURegisters::PC, opVal);
+        registerBank.writeRegisterWord(Enu::CPURegisters::SP, sp);
+    }
+    else if constexpr(mnemon == Enu::EMnemonic::ADDSP) {
+        memSuccess = readOperandWordFast<addrMode>(entry.opSpec, opVal);
+        registerBank.writeRegisterWord(Enu::CPURegisters::SP,
+                                       registerBank.readRegisterWordCurrent(Enu::CPURegisters::SP) + opVal);
+    }
+    else if constexpr(mnemon == Enu::EMnemonic::SUBSP) {
+        memSuccess = readOperandWordFast<addrMode>(entry.opSpec, opVal);
+        registerBank.writeRegisterWord(Enu::CPURegisters::SP,
+                                       registerBank.readRegisterWordCurrent(Enu::CPURegisters::SP) - opVal);
+    }
+    else if constexpr(mnemon == Enu::EMnemonic::ADDA || mnemon == Enu::EMnemonic::ADDX) {
+        quint8 NZVC;
+        memSuccess = readOperandWordFast<addrMode>(entry.opSpec, opVal);
+        registerBank.writeRegisterWord(reg, ALU::addWords(registerBank.readRegisterWordCurrent(reg), opVal, NZVC));
+        writeStatusBitsMasked(NZVC, Enu::NMask | Enu::ZMask | Enu::VMask | Enu::CMask);
+    }
+    else if constexpr(mnemon == Enu::EMnemonic::SUBA || mnemon == Enu::EMnemonic::SUBX) {
+        quint8 NZVC;
+        memSuccess = readOperandWordFast<addrMode>(entry.opSpec, opVal);
+        registerBank.writeRegisterWord(reg, ALU::subtractWords(registerBank.readRegisterWordCurrent(reg), opVal, NZVC));
+        writeStatusBitsMasked(NZVC, Enu::NMask | Enu::ZMask | Enu::VMask | Enu::CMask);
+    }
+    else if constexpr(mnemon == Enu::EMnemonic::ANDA || mnemon == Enu::EMnemonic::ANDX
+                      || mnemon == Enu::EMnemonic::ORA || mnemon == Enu::EMnemonic::ORX) {
+        memSuccess = readOperandWordFast<addrMode>(entry.opSpec, opVal);
+        quint16 result = registerBank.readRegisterWordCurrent(reg);
+        if constexpr(mnemon == Enu::EMnemonic::ANDA || mnemon == Enu::EMnemonic::ANDX) {
+            result &= opVal;
+        }
+        else {
+            result |= opVal;
+        }
+        registerBank.writeRegisterWord(reg, result);
+        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_N, result & 0x8000);
+        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_Z, result == 0);
+    }
+    else if constexpr(mnemon == Enu::EMnemonic::CPWA || mnemon == Enu::EMnemonic::CPWX) {
+        quint8 NZVC;
+        memSuccess = readOperandWordFast<addrMode>(entry.opSpec, opVal);
+        ALU::subtractWords(registerBank.readRegisterWordCurrent(reg), opVal, NZVC);
+        // If there was a signed overflow, selectively invert N bit.
+        if(NZVC & Enu::VMask) NZVC ^= Enu::NMask;
+        writeStatusBitsMasked(NZVC, Enu::NMask | Enu::ZMask | Enu::VMask | Enu::CMask);
+    }
+    else if constexpr(mnemon == Enu::EMnemonic::LDWA || mnemon == Enu::EMnemonic::LDWX) {
+        memSuccess = readOperandWordFast<addrMode>(entry.opSpec, opVal);
+        registerBank.writeRegisterWord(reg, opVal);
+        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_N, opVal & 0x8000);
+        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_Z, opVal == 0);
+    }
+    else if constexpr(mnemon == Enu::EMnemonic::STWA || mnemon == Enu::EMnemonic::STWX) {
+        memSuccess = writeOperandWordFast<addrMode>(entry.opSpec, registerBank.readRegisterWordCurrent(reg));
+    }
+    else if constexpr(mnemon == Enu::EMnemonic::CPBA || mnemon == Enu::EMnemonic::CPBX) {
+        quint8 opByte = 0;
+        memSuccess = readOperandByteFast<addrMode>(entry.opSpec, opByte);
+        // Narrow the register and operand to 1 byte before comparing.
+        quint16 negated = ~opByte + 1;
+        quint16 result = (registerBank.readRegisterWordCurrent(reg) + negated) & 0xff;
+        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_N, result & 0x80);
+        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_Z, result == 0);
+        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_V, false);
+        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_C, false);
+    }
+    else if constexpr(mnemon == Enu::EMnemonic::LDBA || mnemon == Enu::EMnemonic::LDBX) {
+        quint8 opByte = 0;
+        memSuccess = readOperandByteFast<addrMode>(entry.opSpec, opByte);
+        quint16 result = (registerBank.readRegisterWordCurrent(reg) & 0xff00) | opByte;
+        registerBank.writeRegisterWord(reg, result);
+        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_N, false);
+        registerBank.writeStatusBit(Enu::EStatusBit::STATUS_Z, (result & 0xff) == 0);
+    }
+    else if constexpr(mnemon == Enu::EMnemonic::STBA || mnemon == Enu::EMnemonic::STBX) {
+        memSuccess = writeOperandByteFast<addrMode>(entry.opSpec,
+                                                    static_cast<quint8>(0xff & registerBank.readRegisterWordCurrent(reg)));
+    }
+    else {
+        static_assert(mnemon != mnemon, "Unhandled nonunary instruction.");
+    }
+
+    if(!memSuccess){
+        controlError = true;
+        errorMessage = "Error: Failed to perform memory access.";
+    }
+}
+
+template<Enu::EMnemonic mnemon>
+void IsaCpu::executeTrapFast(const decode_cache_entry &)
+{
+    quint16 pc, tempAddr, temp = manager->getOperatingSystem()->getBurnValue() - 9;
+    memory->readWord(temp, tempAddr);
+    quint16 pcAddr = manager->getOperatingSystem()->getBurnValue() - 1;
+    bool memSuccess = true;
+#if hardwarePCIncr
+    // Same as executeTrap(...), non-unary traps must increment the program counter.
+    if constexpr(mnemon != Enu::EMnemonic::NOP0 && mnemon != Enu::EMnemonic::NOP1) {
+        pc = registerBank.readRegisterWordCurrent(Enu::CPURegisters::PC) + 2;
+        registerBank.writeRegisterWord(Enu::CPURegisters::PC, pc);
+    }
+#endif
+    memSuccess &= memory->writeByte(tempAddr - 1, registerBank.readRegisterByteCurrent(Enu::CPURegisters::IS));
+    memSuccess &= memory->writeWord(tempAddr - 3, registerBank.readRegisterWordCurrent(Enu::CPURegisters::SP));
+    memSuccess &= memory->writeWord(tempAddr - 5, registerBank.readRegisterWordCurrent(Enu::CPURegisters::PC));
+    memSuccess &= memory->writeWord(tempAddr - 7, registerBank.readRegisterWordCurrent(Enu::CPURegisters::X));
+    memSuccess &= memory->writeWord(tempAddr - 9, registerBank.readRegisterWordCurrent(Enu::CPURegisters::A));
+    memSuccess &= memory->writeByte(tempAddr - 10, registerBank.readStatusBitsCurrent());
+    memSuccess &= memory->readWord(pcAddr, pc);
+    registerBank.writeRegisterWord(Enu::CPURegisters::SP, tempAddr - 10);
+    registerBank.writeRegisterWord(Enu::CPURegisters::PC, pc);
+#if performTrapFix
+    registerBank.writeRegisterWord(Enu::CPURegisters::X, 0);
+#endif
+    if(!memSuccess){
+        controlError = true;
+        errorMessage = "Error: Failed to perform memory access.";
+    }
+}
+
+void IsaCpu::executeInvalidFast(const decode_cache_entry &entry)
+{
+    controlError = true;
+    executionFinished = true;
+    if(entry.isTrap) {
+        errorMessage = "Error: Attempted to execute invalid trap instruction";
+    }
+    else if(entry.length == 1) {
+        errorMessage = "Error: Attempted to execute invalid unary instruction.";
+    }
+    else {
+        registerBank.writeRegisterWord(Enu::CPURegisters::OS, entry.opSpec);
+        quint16 pc = registerBank.readRegisterWordCurrent(Enu::CPURegisters::PC) + 2;
+        registerBank.writeRegisterWord(Enu::CPURegisters::PC, pc);
+        errorMessage = "Error: Attempted to execute invalid nonunary instruction";
+    }
+}
+
 void IsaCpu::breakpointAsmHandler()
 {
     // Callback function
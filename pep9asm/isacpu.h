@@ -20,8 +20,12 @@
 */
 #ifndef ISACPU_H
 #define ISACPU_H
+#include "amemorydevice.h"
 #include "interfaceisacpu.h"
 #include <QElapsedTimer>
+#include <QVector>
+#include <array>
+#include "enu.h"
 #include "registerfile.h"
 
 /* Though not part of the specification, the trap mechanism  must
@@ -38,7 +42,30 @@
 #define hardwarePCIncr true
 class CPUDataSection;
 class IsaCpuMemoizer;
-class IsaCpu: public ACPUModel, public InterfaceISACPU
+class IsaCpu;
+
+/*
+ * An instruction that has already been fetched from memory & decoded.
+ * Since most programs spend their time in loops, the same handful of
+ * addresses are fetched over and over again. Caching the decoded
+ * form of the instruction at an address avoids repeatedly reading
+ * memory and performing table lookups on every step.
+ */
+struct decode_cache_entry {
+    // Function which will execute the decoded instruction in the fast engine.
+    void (IsaCpu::*handler)(const decode_cache_entry&) = nullptr;
+    Enu::EMnemonic mnemon = Enu::EMnemonic::STOP;
+    Enu::EAddrMode addrMode = Enu::EAddrMode::NONE;
+    quint16 opSpec = 0;
+    quint8 is = 0;
+    // Number of bytes occupied by the instruction (1 or 3).
+    quint8 length = 1;
+    // Is the mnemonic handled by the operating system's trap handler?
+    bool isTrap = false;
+    bool isValid = false;
+};
+
+class IsaCpu: public ACPUModel, public InterfaceISACPU, public AMemoryObserver
 {
     friend class IsaCpuMemoizer;
 public:
@@ -54,11 +81,28 @@ public:
     quint64 getInstructionCount() override;
     const QVector<quint32> getInstructionHistogram() override;
 
+    // AMemoryObserver interface
+    // Any write or set to memory might modify a previously decoded instruction,
+    // so stale decodings must be discarded.
+    void onMemoryChanged(quint16 address, quint8 newValue) override;
+
     RegisterFile& getRegisterBank();
     const RegisterFile& getRegisterBank() const;
 
+    // When enabled, and debugging is disabled, instructions are executed
+    // by a stripped down engine that dispatches directly through a per-opcode
+    // table, and that does not collect statistics nor trace the stack.
+    void setFastExecution(bool fast) noexcept;
+    bool getFastExecution() const noexcept;
+
 protected:
     void onISAStep() override;
+    // Execute a single ISA instruction without involving the memoizer or
+    // stack tracing. Breakpoints are not checked.
+    void onFastISAStep();
+    // Select between onISAStep() and onFastISAStep() depending on the
+    // debugging state and the requested execution engine.
+    void doISAStepWhile(std::function<bool(void)> condition) override;
     void updateAtInstructionEnd() override;
     bool readOperandWordValue(quint16 operand, Enu::EAddrMode addrMode, quint16& opVal);
     bool readOperandByteValue(quint16 operand, Enu::EAddrMode addrMode, quint8& opVal);
@@ -97,9 +141,59 @@ private:
                          bool (AMemoryDevice::*readFunc)(quint16, quint8&) const, quint8& opVal);
     bool writeOperandWord(quint16 operand, quint16 value, Enu::EAddrMode addrMode);
     bool writeOperandByte(quint16 operand, quint8 value, Enu::EAddrMode addrMode);
+    // Execute an instruction on behalf of onISAStep(). The fast engine
+    // does not use these, see the execute*Fast(...) handlers instead.
     void executeUnary(Enu::EMnemonic mnemon);
     void executeNonunary(Enu::EMnemonic mnemon, quint16 opSpec, Enu::EAddrMode addrMode);
     void executeTrap(Enu::EMnemonic mnemon);
+    // Overwrite the status bits selected by mask with those in NZVC, leaving the rest untouched.
+    void writeStatusBitsMasked(quint8 NZVC, quint8 mask);
+
+    // Fetch & decode the instruction located at pc into entry, using a
+    // previously decoded copy if one exists. Returns false if memory could
+    // not be accessed.
+    bool decodeInstruction(quint16 pc, decode_cache_entry& entry);
+    // Discard any decoded instructions that overlap the byte at address.
+    void invalidateDecodeCache(quint16 address) noexcept;
+    // Discard every decoded instruction.
+    void clearDecodeCache() noexcept;
+    // Recompute opcodeTable from the current mnemonic maps.
+    void buildOpcodeTable() noexcept;
+    using instruction_handler = void (IsaCpu::*)(const decode_cache_entry&);
+    // Select the handler instantiated for a mnemonic (and addressing mode).
+    // Mnemonics without a handler of the requested kind map to executeInvalidFast.
+    static instruction_handler trapHandler(Enu::EMnemonic mnemon) noexcept;
+    static instruction_handler unaryHandler(Enu::EMnemonic mnemon) noexcept;
+    static instruction_handler nonunaryHandler(Enu::EMnemonic mnemon, Enu::EAddrMode addrMode) noexcept;
+    template<Enu::EMnemonic mnemon>
+    static instruction_handler nonunaryHandler(Enu::EAddrMode addrMode) noexcept;
+    // Handlers stored in opcodeTable. Each is specialized for exactly one
+    // mnemonic and addressing mode, so the instruction specifier indexes
+    // straight into the code which executes it.
+    template<Enu::EMnemonic mnemon>
+    void executeTrapFast(const decode_cache_entry& entry);
+    template<Enu::EMnemonic mnemon>
+    void executeUnaryFast(const decode_cache_entry& entry);
+    template<Enu::EMnemonic mnemon, Enu::EAddrMode addrMode>
+    void executeNonunaryFast(const decode_cache_entry& entry);
+    void executeInvalidFast(const decode_cache_entry& entry);
+    // Operand access for the fast engine, with the addressing mode fixed at compile time.
+    template<Enu::EAddrMode addrMode>
+    bool effectiveAddressFast(quint16 operand, quint16& address);
+    template<Enu::EAddrMode addrMode>
+    bool readOperandWordFast(quint16 operand, quint16& opVal);
+    template<Enu::EAddrMode addrMode>
+    bool readOperandByteFast(quint16 operand, quint8& opVal);
+    template<Enu::EAddrMode addrMode>
+    bool writeOperandWordFast(quint16 operand, quint16 value);
+    template<Enu::EAddrMode addrMode>
+    bool writeOperandByteFast(quint16 operand, quint8 value);
+    // Decoded instructions indexed by the address of their instruction specifier.
+    QVector<decode_cache_entry> decodeCache;
+    // Decoding of each of the 256 instruction specifiers, minus the operand specifier.
+    // Replaces the QMap lookups that would otherwise be required to decode an instruction.
+    std::array<decode_cache_entry, 256> opcodeTable;
+    bool fastExecution;
     // Callback function to handle InteruptHandler's BREAKPOINT_ASM.
     void breakpointAsmHandler();
 };
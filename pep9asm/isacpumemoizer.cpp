@@ -63,11 +63,7 @@ void IsaCpuMemoizer::storeStateInstrStart()
 QString IsaCpuMemoizer::memoize()
 {
     const RegisterFile& file = cpu.registerBank;
-    SymbolTable* symTable = nullptr;
-    if(cpu.manager->getProgramAt(file.readRegisterWordStart(Enu::CPURegisters::PC)) != nullptr) {
-        symTable = cpu.manager->getProgramAt(file.readRegisterWordStart(Enu::CPURegisters::PC))
-                ->getSymbolTable().get();
-    }
+    const AsmProgram* program = cpu.manager->getProgramAt(file.readRegisterWordStart(Enu::CPURegisters::PC));
     quint8 ir = 0;
     QString build, AX, NZVC;
     AX = QString(" A=%1, X=%2, SP=%3")
@@ -76,23 +72,23 @@ QString IsaCpuMemoizer::memoize()
                  formatNum(file.readRegisterWordCurrent(Enu::CPURegisters::X)),
                  formatNum(file.readRegisterWordCurrent(Enu::CPURegisters::SP)));
     NZVC = QString(" SNZVC=") % QString("%1").arg(QString::number(file.readStatusBitsCurrent(), 2), 5, '0');
-    build = (attemptAddrReplace(symTable, file.readRegisterWordStart(Enu::CPURegisters::PC)) + QString(":")).leftJustified(10) %
-            formatInstr(symTable, file.getIRCache(), file.readRegisterWordCurrent(Enu::CPURegisters::OS));
+    build = (attemptAddrReplace(program, file.readRegisterWordStart(Enu::CPURegisters::PC)) + QString(":")).leftJustified(10) %
+            formatInstr(program, file.getIRCache(), file.readRegisterWordCurrent(Enu::CPURegisters::OS));
     build += "  " + AX;
     build += NZVC;
     build += "  " + AX;
     build += NZVC;
     ir = file.getIRCache();
-    if(Pep::isTrapMap[Pep::decodeMnemonic[ir]]) {
+    if(Pep::isTrapMap.value(Pep::decodeMnemonic.at(ir))) {
         build += generateTrapFrame(state);
     }
-    else if(Pep::decodeMnemonic[ir] == Enu::EMnemonic::RETTR) {
+    else if(Pep::decodeMnemonic.at(ir) == Enu::EMnemonic::RETTR) {
         build += generateTrapFrame(state,false);
     }
-    else if(Pep::decodeMnemonic[ir] == Enu::EMnemonic::CALL) {
+    else if(Pep::decodeMnemonic.at(ir) == Enu::EMnemonic::CALL) {
         build += generateStackFrame(state);
     }
-    else if(Pep::decodeMnemonic[ir] == Enu::EMnemonic::RET) {
+    else if(Pep::decodeMnemonic.at(ir) == Enu::EMnemonic::RET) {
         build += generateStackFrame(state,false);
     }
     return build;
@@ -107,13 +103,13 @@ QString IsaCpuMemoizer::finalStatistics()
     tally.append(0);
     int tallyIt = 0;
     for(int it = 0; it < 256; it++) {
-        if(mnemon == Pep::decodeMnemonic[it]) {
+        if(mnemon == Pep::decodeMnemonic.at(it)) {
             tally[tallyIt]+= state.instructionsCalled[it];
         }
         else {
             tally.append(state.instructionsCalled[it]);
             tallyIt++;
-            mnemon = Pep::decodeMnemonic[it];
+            mnemon = Pep::decodeMnemonic.at(it);
             mnemonList.append(mnemon);
         }
     }
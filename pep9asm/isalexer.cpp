@@ -0,0 +1,252 @@
+// File: isalexer.cpp
+/*
+    Pep9 is a virtual machine for writing machine language and assembly
+    language programs.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "isalexer.h"
+
+namespace {
+    inline bool isAsciiDigit(QChar c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    inline bool isAsciiLetter(QChar c)
+    {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+    }
+
+    inline bool isHexDigit(QChar c)
+    {
+        return isAsciiDigit(c) || (c >= 'A' && c <= 'F') || (c >= 'a' && c <= 'f');
+    }
+
+    // Characters that may follow a \ in a character or string constant, other than x.
+    inline bool isEscapedChar(QChar c)
+    {
+        switch(c.unicode()) {
+        case '\'': case 'b': case 'f': case 'n': case 'r':
+        case 't': case 'v': case '\"': case '\\':
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Matches the \w character class: letters, numbers, marks, and underscores.
+    inline bool isWordChar(QChar c)
+    {
+        return c.isLetterOrNumber() || c.isMark() || c == '_';
+    }
+}
+
+IsaLexer::IsaLexer(QStringView line): line(line), position(0)
+{
+
+}
+
+bool IsaLexer::nextToken(IsaToken &token, QString &errorMessage)
+{
+    while(position < line.size() && line[position].isSpace()) {
+        position++;
+    }
+    token.offset = position;
+    if (position == line.size()) {
+        token.type = IsaParserHelper::LT_EMPTY;
+        token.length = 0;
+        return true;
+    }
+
+    QChar firstChar = line[position];
+    int length = 0;
+    if (firstChar == ',') {
+        token.type = IsaParserHelper::LT_ADDRESSING_MODE;
+        length = matchAddrMode();
+        if (length == 0) errorMessage = ";ERROR: Malformed addressing mode.";
+    }
+    else if (firstChar == '\'') {
+        token.type = IsaParserHelper::LT_CHAR_CONSTANT;
+        length = matchCharConst();
+        if (length == 0) errorMessage = ";ERROR: Malformed character constant.";
+    }
+    else if (firstChar == ';') {
+        // A comment is the remainder of the line, without trailing whitespace.
+        token.type = IsaParserHelper::LT_COMMENT;
+        length = static_cast<int>(line.size()) - position;
+        while(line[position + length - 1].isSpace()) {
+            length--;
+        }
+    }
+    else if (firstChar == '0' && position + 1 < line.size()
+             && (line[position + 1] == 'x' || line[position + 1] == 'X')) {
+        token.type = IsaParserHelper::LT_HEX_CONSTANT;
+        length = matchHexConst();
+        if (length == 0) errorMessage = ";ERROR: Malformed hex constant.";
+    }
+    else if (firstChar.isDigit() || firstChar == '+' || firstChar == '-') {
+        token.type = IsaParserHelper::LT_DEC_CONSTANT;
+        length = matchDecConst();
+        if (length == 0) errorMessage = ";ERROR: Malformed decimal constant.";
+    }
+    else if (firstChar == '.') {
+        token.type = IsaParserHelper::LT_DOT_COMMAND;
+        length = matchDotCommand();
+        if (length == 0) errorMessage = ";ERROR: Malformed dot command.";
+    }
+    else if (firstChar.isLetter() || firstChar == '_') {
+        length = matchIdentifier();
+        if (length == 0) errorMessage = ";ERROR: Malformed identifier.";
+        else token.type = line[position + length - 1] == ':' ?
+                    IsaParserHelper::LT_SYMBOL_DEF :
+                    IsaParserHelper::LT_IDENTIFIER;
+    }
+    else if (firstChar == '\"') {
+        token.type = IsaParserHelper::LT_STRING_CONSTANT;
+        length = matchStringConst();
+        if (length == 0) errorMessage = ";ERROR: Malformed string constant.";
+    }
+    else {
+        errorMessage = ";ERROR: Syntax error.";
+    }
+
+    if (length == 0) return false;
+    token.length = length;
+    position += length;
+    return true;
+}
+
+QStringView IsaLexer::text(const IsaToken &token) const
+{
+    return line.mid(token.offset, token.length);
+}
+
+int IsaLexer::matchAddrMode() const
+{
+    // A comma, optional whitespace, and one of i, d, n, s, sf, x, sx, sfx in any case.
+    int index = position + 1;
+    while(index < line.size() && line[index].isSpace()) {
+        index++;
+    }
+    if (index == line.size()) return 0;
+    auto lowerAt = [this](int at) {
+        return at < line.size() ? line[at].toLower() : QChar();
+    };
+    QChar mode = lowerAt(index);
+    if (mode == 'i' || mode == 'd' || mode == 'x' || mode == 'n') {
+        return index + 1 - position;
+    }
+    else if (mode != 's') {
+        return 0;
+    }
+    QChar second = lowerAt(index + 1);
+    if (second == 'f') {
+        return (lowerAt(index + 2) == 'x' ? index + 3 : index + 2) - position;
+    }
+    else if (second == 'x') {
+        // sxf is not an addressing mode, and can't be read as s or sx followed by an f.
+        return lowerAt(index + 2) == 'f' ? 0 : index + 2 - position;
+    }
+    return index + 1 - position;
+}
+
+int IsaLexer::matchCharConst() const
+{
+    // A single possibly quoted character between single quotes.
+    int length = matchQuotedChar(position + 1, '\'');
+    if (length == 0) return 0;
+    int close = position + 1 + length;
+    if (close >= line.size() || line[close] != '\'') return 0;
+    return close + 1 - position;
+}
+
+int IsaLexer::matchHexConst() const
+{
+    // 0x followed by at least one hex digit.
+    int index = position + 2;
+    while(index < line.size() && isHexDigit(line[index])) {
+        index++;
+    }
+    if (index == position + 2) return 0;
+    return index - position;
+}
+
+int IsaLexer::matchDecConst() const
+{
+    // An optional sign followed by at least one digit.
+    int index = position;
+    if (line[index] == '+' || line[index] == '-') {
+        index++;
+    }
+    int firstDigit = index;
+    while(index < line.size() && isAsciiDigit(line[index])) {
+        index++;
+    }
+    if (index == firstDigit) return 0;
+    return index - position;
+}
+
+int IsaLexer::matchDotCommand() const
+{
+    // A dot, a letter, and any number of word characters.
+    int index = position + 1;
+    if (index == line.size() || !isAsciiLetter(line[index])) return 0;
+    index++;
+    while(index < line.size() && isWordChar(line[index])) {
+        index++;
+    }
+    return index - position;
+}
+
+int IsaLexer::matchIdentifier() const
+{
+    // A letter or underscore, any number of word characters, and an optional colon.
+    int index = position;
+    if (!isAsciiLetter(line[index]) && line[index] != '_') return 0;
+    index++;
+    while(index < line.size() && isWordChar(line[index])) {
+        index++;
+    }
+    if (index < line.size() && line[index] == ':') {
+        index++;
+    }
+    return index - position;
+}
+
+int IsaLexer::matchStringConst() const
+{
+    // Any number of possibly quoted characters between double quotes.
+    int index = position + 1;
+    while(index < line.size() && line[index] != '\"') {
+        int length = matchQuotedChar(index, '\"');
+        if (length == 0) return 0;
+        index += length;
+    }
+    if (index == line.size()) return 0;
+    return index + 1 - position;
+}
+
+int IsaLexer::matchQuotedChar(int index, QChar quote) const
+{
+    if (index >= line.size() || line[index] == quote) return 0;
+    else if (line[index] != '\\') return 1;
+    // Otherwise, the character is quoted.
+    else if (index + 1 < line.size() && isEscapedChar(line[index + 1])) return 2;
+    else if (index + 3 < line.size() && (line[index + 1] == 'x' || line[index + 1] == 'X')
+             && isHexDigit(line[index + 2]) && isHexDigit(line[index + 3])) return 4;
+    return 0;
+}
@@ -0,0 +1,75 @@
+// File: isalexer.h
+/*
+    Pep9 is a virtual machine for writing machine language and assembly
+    language programs.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef ISALEXER_H
+#define ISALEXER_H
+
+#include <QString>
+#include <QStringView>
+
+#include "isaasm.h"
+
+// A single token of a source line. The token's text is line.mid(offset, length).
+struct IsaToken
+{
+    IsaParserHelper::ELexicalToken type;
+    int offset, length;
+};
+
+/*
+ * Splits one line of Pep/9 assembly language into tokens.
+ *
+ * The lexer walks the line a single time, deciding the kind of each token from its
+ * first character, exactly as the assembler's regular expressions used to. Tokens
+ * are reported as offsets into the line, so lexing neither copies nor allocates.
+ * The line must outlive the lexer.
+ */
+class IsaLexer
+{
+public:
+    explicit IsaLexer(QStringView line);
+
+    // Post: If the next token is valid, it is stored in token, the lexer advances past it,
+    // and true is returned. At the end of the line, token has type LT_EMPTY.
+    // Post: If false is returned, then errorMessage is set to the lexical error message.
+    bool nextToken(IsaToken& token, QString& errorMessage);
+    // Return the characters making up token.
+    QStringView text(const IsaToken& token) const;
+
+private:
+    QStringView line;
+    // Index of the first character that has not been lexed.
+    int position;
+
+    // Each method attempts to match a token starting at position, and returns the
+    // number of characters matched, or 0 if the text is malformed.
+    int matchAddrMode() const;
+    int matchCharConst() const;
+    int matchHexConst() const;
+    int matchDecConst() const;
+    int matchDotCommand() const;
+    int matchIdentifier() const;
+    int matchStringConst() const;
+    // Match a single possibly \ quoted character of a character or string constant at index.
+    // Returns the number of characters matched, or 0 if the character is malformed.
+    int matchQuotedChar(int index, QChar quote) const;
+};
+
+#endif // ISALEXER_H
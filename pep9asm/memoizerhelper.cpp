@@ -19,9 +19,8 @@
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "memoizerhelper.h"
+#include "asmprogram.h"
 #include "pep.h"
-#include "symbolentry.h"
-#include "symbolvalue.h"
 
 const QString stackFrameEnter("%1\n===CALL===\n");
 const QString stackFrameLeave("%1\n===RET====\n");
@@ -53,7 +52,7 @@ QString formatAddress(quint16 address)
 QString mnemonDecode(quint8 instrSpec)
 {
     static QMetaEnum metaenum = Enu::staticMetaObject.enumerator(Enu::staticMetaObject.indexOfEnumerator("EMnemonic"));
-    return QString(metaenum.valueToKey((int)Pep::decodeMnemonic[instrSpec])).toLower();
+    return QString(metaenum.valueToKey((int)Pep::decodeMnemonic.at(instrSpec))).toLower();
 }
 
 // Convert a mnemonic into its string
@@ -73,20 +72,20 @@ QString formatUnary(quint8 instrSpec)
     return formatIS(instrSpec).leftJustified(inst_size+max_symLen+2+4);
 }
 
-QString formatNonUnary(SymbolTable* symTable, quint8 instrSpec,quint16 oprSpec)
+QString formatNonUnary(const AsmProgram* program, quint8 instrSpec,quint16 oprSpec)
 {
     return formatIS(instrSpec).leftJustified(inst_size) %
-            QString(attemptOperSpecReplace(symTable, oprSpec)).rightJustified(max_symLen) %
-            ", " % Pep::intToAddrMode(Pep::decodeAddrMode[instrSpec]).leftJustified(4,' ');
+            QString(attemptOperSpecReplace(program, oprSpec)).rightJustified(max_symLen) %
+            ", " % Pep::intToAddrMode(Pep::decodeAddrMode.at(instrSpec)).leftJustified(4,' ');
 }
 
-QString formatInstr(SymbolTable* symTable, quint8 instrSpec,quint16 oprSpec)
+QString formatInstr(const AsmProgram* program, quint8 instrSpec,quint16 oprSpec)
 {
-    if(Pep::isUnaryMap[Pep::decodeMnemonic[instrSpec]]) {
+    if(Pep::isUnaryMap.value(Pep::decodeMnemonic.at(instrSpec))) {
         return formatUnary(instrSpec);
     }
     else {
-        return formatNonUnary(symTable, instrSpec, oprSpec);
+        return formatNonUnary(program, instrSpec, oprSpec);
     }
 }
 
@@ -112,34 +111,18 @@ QString generateTrapFrame(CPUState&, bool /*enter*/)
     }*/
 }
 
-QString attemptOperSpecReplace(SymbolTable *symTable, quint16 number)
+QString attemptOperSpecReplace(const AsmProgram *program, quint16 number)
 {
-    if(symTable == nullptr) return formatNum(number);
-    int count = 0;
-    QString name;
-    for(auto it : symTable->getSymbolMap()) {
-        if(it->getRawValue()->getSymbolType() == SymbolType::ADDRESS) continue;
-        if(it->getValue() == number) {
-            count++;
-            name = it->getName();
-        }
-    }
-    if(count == 1) return name;
+    if(program == nullptr) return formatNum(number);
+    QString name = program->getNumericSymbolName(number);
+    if(!name.isNull()) return name;
     else return formatNum(number);
 }
 
-QString attemptAddrReplace(SymbolTable *symTable, quint16 number)
+QString attemptAddrReplace(const AsmProgram *program, quint16 number)
 {
-    if(symTable == nullptr) return formatNum(number);
-    int count = 0;
-    QString name;
-    for(auto it : symTable->getSymbolMap()) {
-        if(it->getRawValue()->getSymbolType() == SymbolType::NUMERIC_CONSTANT) continue;
-        if(it->getValue() == number) {
-            count++;
-            name = it->getName();
-        }
-    }
-    if(count == 1) return name;
+    if(program == nullptr) return formatNum(number);
+    QString name = program->getAddressSymbolName(number);
+    if(!name.isNull()) return name;
     else return formatNum(number);
 }
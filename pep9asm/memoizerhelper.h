@@ -22,7 +22,7 @@
 #define MEMOIZERHELPER_H
 #include <QtCore>
 #include "enu.h"
-#include "symboltable.h"
+class AsmProgram;
 struct CPUState
 {
     QVector<quint32> instructionsCalled = QVector<quint32>(256, 0);
@@ -35,10 +35,10 @@ QString mnemonDecode(quint8 instrSpec);
 QString mnemonDecode(Enu::EMnemonic instrSpec);
 QString formatIS(quint8 instrSpec);
 QString formatUnary(quint8 instrSpec);
-QString formatNonUnary(SymbolTable* symTable, quint8 instrSpec, quint16 oprSpec);
-QString formatInstr(SymbolTable* symTable, quint8 instrSpec, quint16 oprSpec);
+QString formatNonUnary(const AsmProgram* program, quint8 instrSpec, quint16 oprSpec);
+QString formatInstr(const AsmProgram* program, quint8 instrSpec, quint16 oprSpec);
 QString generateStackFrame(CPUState &state, bool enter = true);
 QString generateTrapFrame(CPUState &state, bool enter = true);
-QString attemptAddrReplace(SymbolTable* symTable, quint16 number);
-QString attemptOperSpecReplace(SymbolTable* symTable, quint16 number);
+QString attemptAddrReplace(const AsmProgram* program, quint16 number);
+QString attemptOperSpecReplace(const AsmProgram* program, quint16 number);
 #endif // MEMOIZERHELPER_H
@@ -23,6 +23,7 @@
 #include "pep.h"
 #include <QPainter>
 #include "amemorydevice.h"
+#include "simulationsnapshot.h"
 // #include <QDebug>
 
 const int MemoryCellGraphicsItem::boxHeight = 22;
@@ -116,9 +117,63 @@ void MemoryCellGraphicsItem::updateValue()
 {
     quint8 byte;
     quint16 word;
+    switch (cellSize(eSymbolFormat)) {
+    case 1:
+        memDevice->getByte(address, byte);
+        formatValue(byte);
+        break;
+    case 2:
+        memDevice->getWord(address, word);
+        formatValue(word);
+        break;
+    default:
+        formatValue(0);
+        break;
+    }
+}
+
+void MemoryCellGraphicsItem::updateValue(const SimulationSnapshot &snapshot)
+{
+    quint8 hi, lo;
+    bool hiWritten, loWritten;
+    switch (cellSize(eSymbolFormat)) {
+    case 1:
+        if(snapshot.getByte(address, lo)) formatValue(lo);
+        break;
+    case 2:
+        // Only part of a word may have been written, so fall back to the existing value for the other half.
+        hi = static_cast<quint8>(iValue >> 8);
+        lo = static_cast<quint8>(iValue);
+        hiWritten = snapshot.getByte(address, hi);
+        loWritten = snapshot.getByte(static_cast<quint16>(address + 1), lo);
+        if(hiWritten || loWritten) formatValue(static_cast<quint16>(hi << 8 | lo));
+        break;
+    default:
+        break;
+    }
+}
+
+void MemoryCellGraphicsItem::updateValue(const QVector<quint8> &block, quint16 base)
+{
+    int offset = static_cast<quint16>(address - base);
+    switch (cellSize(eSymbolFormat)) {
+    case 1:
+        formatValue(block.at(offset));
+        break;
+    case 2:
+        formatValue(static_cast<quint16>(block.at(offset) << 8 | block.at(offset + 1)));
+        break;
+    default:
+        formatValue(0);
+        break;
+    }
+}
+
+void MemoryCellGraphicsItem::formatValue(quint16 raw)
+{
+    quint8 byte = static_cast<quint8>(raw);
     switch (eSymbolFormat) {
     case Enu::ESymbolFormat::F_1C:
-        memDevice->getByte(address, byte);
         if(QChar::isPrint(byte)) {
             value = QChar(byte);
         }
@@ -127,25 +182,21 @@ void MemoryCellGraphicsItem::updateValue()
         break;
     // 1 byte integers are to be displayed as unsigned.
     case Enu::ESymbolFormat::F_1D:
-        memDevice->getByte(address, byte);
         value = QString("%1").arg(byte);
         iValue = byte;
         break;
     // 2 byte integers are to be displayed as signed.
     case Enu::ESymbolFormat::F_2D:
-        memDevice->getWord(address, word);
-        value = QString("%1").arg(static_cast<qint16>(word));
-        iValue = word;
+        value = QString("%1").arg(static_cast<qint16>(raw));
+        iValue = raw;
         break;
     case Enu::ESymbolFormat::F_1H:
-        memDevice->getByte(address, byte);
         value = QString("%1").arg(byte, 2, 16, QLatin1Char('0')).toUpper();
         iValue = byte;
         break;
     case Enu::ESymbolFormat::F_2H:
-        memDevice->getWord(address, word);
-        value = QString("%1").arg(word, 4, 16, QLatin1Char('0')).toUpper();
-        iValue = word;
+        value = QString("%1").arg(raw, 4, 16, QLatin1Char('0')).toUpper();
+        iValue = raw;
         break;
     default:
         value = ""; // Should not occur
@@ -26,6 +26,7 @@
 #include "enu.h"
 #include "colors.h"
 class AMemoryDevice;
+class SimulationSnapshot;
 
 quint16 cellSize(Enu::ESymbolFormat symbolFormat);
 // This is used exclusively in the memoryTracePane/memoryCellGraphicsItem
@@ -54,6 +55,10 @@ public:
     // QColor textColor;
     // QColor boxTextColor;
     void updateValue();
+    // Update the value from a snapshot, keeping the current value of any bytes the snapshot does not contain.
+    void updateValue(const SimulationSnapshot& snapshot);
+    // Update the value from a block of bytes read from memory starting at base, which must span this cell.
+    void updateValue(const QVector<quint8>& block, quint16 base);
     quint16 getAddress() const;
     quint16 getNumBytes() const;
     quint16 getValue() const;
@@ -68,6 +73,8 @@ private:
     const PepColors::Colors * colors;
     QColor backgroundColor;
     bool isModified;
+    // Set the displayed value from the raw contents of the cell.
+    void formatValue(quint16 raw);
 
 };
 
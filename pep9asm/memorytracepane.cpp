@@ -34,6 +34,7 @@
 #include "asmprogrammanager.h"
 #include "asmprogram.h"
 #include "acpumodel.h"
+#include "simulationsnapshot.h"
 
 NewMemoryTracePane::NewMemoryTracePane(QWidget *parent): QWidget (parent), ui(new Ui::MemoryTracePane),
     colors(&PepColors::lightMode), globalVars(), runtimeStack(), heap(), extraItems(),
@@ -88,12 +89,12 @@ void NewMemoryTracePane::updateTrace()
         ui->warningLabel->setText(trace->heapTrace.getErrorMessage());
     }
     // Using main memory device, update
-    for(quint16 address : memorySection->getBytesWritten()) {
+    memorySection->getBytesWritten().forEachAddress([this](quint16 address) {
         if(addressToItems.contains(address)) {
             addressToItems[address]->setModified(true);
             addressToItems[address]->updateValue();
         }
-    }
+    });
 
 
     // This is time-consuming, but worthwhile to ensure scrollbars aren't going off into
@@ -225,6 +226,21 @@ void NewMemoryTracePane::onMemoryChanged()
     updateTrace();
 }
 
+void NewMemoryTracePane::onSimulationSnapshot(const SimulationSnapshot &snapshot)
+{
+    if(isHidden()) return;
+    for(const auto& block : snapshot.getMemoryBlocks()) {
+        // A two byte cell starting just before the block may still overlap it.
+        quint16 first = block.base == 0 ? 0 : static_cast<quint16>(block.base - 1);
+        quint32 last = block.base + static_cast<quint32>(block.bytes.size()) - 1;
+        for(auto item = addressToItems.lowerBound(first);
+            item != addressToItems.end() && item.key() <= last; ++item) {
+            item.value()->updateValue(snapshot);
+        }
+    }
+    scene->invalidate();
+}
+
 void NewMemoryTracePane::updateGlobals()
 {
     // Update the value of all global items
@@ -301,9 +317,9 @@ void NewMemoryTracePane::updateHeap()
     // Update the contents of every cell in the memory view
     for (auto item : heap) {
         item->setModified(false);
-        item->updateValue();
         item->setBackgroundColor(colors->backgroundFill);
     }
+    updateValues(heap);
     // If currently in malloc, and there are items to highlight, highlight (in green) the last added frame.
     if(trace->heapTrace.inMalloc()
             && trace->heapTrace.crbegin() != trace->heapTrace.crend()) {
@@ -393,7 +409,6 @@ void NewMemoryTracePane::updateStack()
             // Adjust location of next stack item to account for the most recently processed item
             yLoc -= MemoryCellGraphicsItem::boxHeight;
             item->setModified(false);
-            item->updateValue();
         }
 
         // If a frame is orphaned or incomplete, it should not be outlined.
@@ -443,6 +458,25 @@ void NewMemoryTracePane::updateStack()
     for(auto item : newItems) {
         runtimeStack.push(item);
     }
+    // Values are read once the stack is complete, so that all cells share one range read.
+    updateValues(runtimeStack);
+}
+
+void NewMemoryTracePane::updateValues(const QVector<MemoryCellGraphicsItem *> &items)
+{
+    if(items.isEmpty()) return;
+    // Cells of a stack or heap are close together, so read every byte between the
+    // lowest and highest cell rather than issuing a read per cell.
+    quint32 first = 0xFFFF, end = 0;
+    for(auto item : items) {
+        first = qMin(first, static_cast<quint32>(item->getAddress()));
+        end = qMax(end, static_cast<quint32>(item->getAddress()) + item->getNumBytes());
+    }
+    QVector<quint8> block(static_cast<int>(end - first));
+    memorySection->getRange(static_cast<quint16>(first), static_cast<quint32>(block.size()), block.data());
+    for(auto item : items) {
+        item->updateValue(block, static_cast<quint16>(first));
+    }
 }
 
 void NewMemoryTracePane::updateStatics()
@@ -36,6 +36,7 @@ class MainMemory;
 class MemoryTrace;
 class AsmProgramManager;
 class ACPUModel;
+class SimulationSnapshot;
 class NewMemoryTracePane : public QWidget {
     Q_OBJECT
     Q_DISABLE_COPY(NewMemoryTracePane)
@@ -63,11 +64,17 @@ public slots:
     // Handle switching styles to and from dark mode & potential re-highlighting
     void onDarkModeChanged(bool darkMode);
     void onMemoryChanged();
+    // Update the values of existing cells from a CPU running on another thread.
+    // The stack and heap are owned by the simulation, so they are not re-rendered
+    // until the simulation pauses or finishes.
+    void onSimulationSnapshot(const SimulationSnapshot& snapshot);
 private:
     void updateGlobals();
     void updateHeap();
     void updateStack();
     void updateStatics();
+    // Refresh the values of items with a single range read covering all of them.
+    void updateValues(const QVector<MemoryCellGraphicsItem*>& items);
 
     Ui::MemoryTracePane *ui;
     const PepColors::Colors *colors;
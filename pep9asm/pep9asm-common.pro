@@ -23,10 +23,12 @@ HEADERS += \
     asmprogram.h \
     asmprogrammanager.h \
     asmsourcecodepane.h \
+    backgroundassembler.h \
     cpphighlighter.h \
     executionstatisticswidget.h \
     interfaceisacpu.h \
     isaasm.h \
+    isalexer.h \
     memorycellgraphicsitem.h \
     memorytracepane.h \
     pepasmhighlighter.h \
@@ -48,10 +50,12 @@ SOURCES += \
     asmprogram.cpp \
     asmprogrammanager.cpp \
     asmsourcecodepane.cpp \
+    backgroundassembler.cpp \
     cpphighlighter.cpp \
     executionstatisticswidget.cpp \
     interfaceisacpu.cpp \
     isaasm.cpp \
+    isalexer.cpp \
     memorycellgraphicsitem.cpp \
     memorytracepane.cpp \
     pepasmhighlighter.cpp \
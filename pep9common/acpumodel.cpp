@@ -26,7 +26,9 @@
 #include <QSharedPointer>
 ACPUModel::ACPUModel(QSharedPointer<AMemoryDevice> memoryDev, QObject* parent) noexcept: QObject(parent), memory(memoryDev),
     handler(new InterruptHandler()), callDepth(0), inDebug(false), inSimulation(false),
-    executionFinished(false), controlError(false), errorMessage("")
+    executionFinished(false), controlError(false), errorMessage(""),
+    yieldPolicy(QSharedPointer<TimeSlicedYieldPolicy>::create()), yieldCountdown(yieldInterval),
+    pendingRequests(0)
 {
 
 }
@@ -71,6 +73,49 @@ int ACPUModel::getCallDepth() const noexcept
     return callDepth;
 }
 
+void ACPUModel::setYieldPolicy(QSharedPointer<AYieldPolicy> policy)
+{
+    yieldPolicy = policy;
+}
+
+QSharedPointer<AYieldPolicy> ACPUModel::getYieldPolicy() const noexcept
+{
+    return yieldPolicy;
+}
+
+void ACPUModel::requestCancel() noexcept
+{
+    pendingRequests.fetch_or(cancelRequestFlag, std::memory_order_relaxed);
+}
+
+void ACPUModel::requestInterrupt(Enu::BreakpointTypes type) noexcept
+{
+    pendingRequests.fetch_or(static_cast<int>(type), std::memory_order_relaxed);
+}
+
+void ACPUModel::resetYieldPolicy()
+{
+    yieldCountdown = yieldInterval;
+    pendingRequests.store(0, std::memory_order_relaxed);
+    yieldPolicy->reset();
+}
+
+void ACPUModel::handlePendingRequests()
+{
+    int requests = pendingRequests.exchange(0, std::memory_order_relaxed);
+    // Cancellation supersedes any breakpoints, since execution will not be resumed.
+    if(requests & cancelRequestFlag) {
+        onCancelExecution();
+        return;
+    }
+    for(auto type : {Enu::BreakpointTypes::ASSEMBLER, Enu::BreakpointTypes::MICROCODE}) {
+        if(requests & static_cast<int>(type)) {
+            enableDebugging();
+            forceBreakpoint(type);
+        }
+    }
+}
+
 void ACPUModel::onClearMemory()
 {
     memory->clearErrors();
@@ -22,8 +22,12 @@
 #ifndef ACPUMODEL_H
 #define ACPUMODEL_H
 
+#include <atomic>
+
 #include <QObject>
+#include <QSharedPointer>
 #include "enu.h"
+#include "yieldpolicy.h"
 
 class AMemoryDevice;
 class InterruptHandler;
@@ -64,6 +68,18 @@ public:
     // Return the depth of the call stack (#calls+#traps-#ret-#rettr)
     int getCallDepth() const noexcept;
 
+    // Change how often the running simulation returns control to the event loop.
+    // Defaults to a TimeSlicedYieldPolicy.
+    void setYieldPolicy(QSharedPointer<AYieldPolicy> policy);
+    QSharedPointer<AYieldPolicy> getYieldPolicy() const noexcept;
+    // Ask a running simulation to cancel execution. Unlike onCancelExecution(),
+    // this may be called from any thread. The request is honored the next time
+    // the simulation polls its yield policy.
+    void requestCancel() noexcept;
+    // Ask a running simulation to enable debugging and force a breakpoint of the given type.
+    // Like requestCancel(), this may be called from any thread.
+    void requestInterrupt(Enu::BreakpointTypes type) noexcept;
+
     // Prepare the CPU for starting simulations / debugging.
     virtual void initCPU() = 0;
     // Fetch values of the status bit reigsters(NZVCS bits).
@@ -113,6 +129,18 @@ signals:
     void asmInstructionFinished();
 
 protected:
+    // Must be called once per step by the simulation loop.
+    // Every yieldInterval steps, honor any pending cancellation or interrupt request,
+    // or otherwise consult the yield policy. Returns true on the steps where it did so.
+    inline bool pollYield();
+    // Discard stale cancellation & interrupt requests and restart the yield policy.
+    // Should be called when a simulation is started.
+    void resetYieldPolicy();
+    // Number of steps between consecutive polls. Must be greater than 1, or there will be no
+    // guarantee of forward progress, since breakpoints that were signaled externally
+    // while yielding would never be cleared.
+    static const quint32 yieldInterval = 256;
+
     QSharedPointer<AMemoryDevice> memory;
     QSharedPointer<InterruptHandler> handler;
     int callDepth;
@@ -120,6 +148,29 @@ protected:
     mutable bool controlError;
     //
     mutable QString errorMessage;
+private:
+    // Act on the requests made through requestCancel() and requestInterrupt().
+    void handlePendingRequests();
+    // Bit flag in pendingRequests for requestCancel(). The other bits are Enu::BreakpointTypes.
+    static const int cancelRequestFlag = 1 << 16;
+    QSharedPointer<AYieldPolicy> yieldPolicy;
+    quint32 yieldCountdown;
+    std::atomic<int> pendingRequests;
 };
 
+inline bool ACPUModel::pollYield()
+{
+    if(--yieldCountdown != 0) {
+        return false;
+    }
+    yieldCountdown = yieldInterval;
+    if(pendingRequests.load(std::memory_order_relaxed) != 0) {
+        handlePendingRequests();
+    }
+    else {
+        yieldPolicy->yield();
+    }
+    return true;
+}
+
 #endif // ACPUMODEL_H
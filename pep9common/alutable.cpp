@@ -0,0 +1,161 @@
+// File: alutable.cpp
+/*
+    The Pep/9 suite of applications (Pep9, Pep9CPU, Pep9Micro) are
+    simulators for the Pep/9 virtual machine, and allow users to
+    create, simulate, and debug across various levels of abstraction.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "alutable.h"
+
+#include <vector>
+
+quint16 ALU::compute(Enu::EALUFunc func, quint8 a, quint8 b, bool carryIn)
+{
+    quint8 res = 0, NZVC = 0;
+    switch(func) {
+    case Enu::A_func: // A
+        res = a;
+        break;
+    case Enu::ApB_func: // A plus B
+        carryIn = false;
+        [[fallthrough]];
+    case Enu::ApBpCin_func: // A plus B plus Cin
+        // Widen the sum so that the carry out is simply the ninth bit.
+        // Comparing the narrowed sum against a and b misses 0xff + 0xff + 1.
+    {
+        quint16 sum = static_cast<quint16>(a + b + carryIn);
+        res = static_cast<quint8>(sum);
+        NZVC |= Enu::CMask * static_cast<quint8>(sum >> 8);
+        // There is a signed overflow iff the high order bits of the input are the same,
+        // and the inputs & output differs in sign.
+        NZVC |= Enu::VMask * ((~(a ^ b) & (a ^ res)) >> 7);
+        break;
+    }
+    case Enu::ApnBp1_func: // A plus ~B plus 1
+        return compute(Enu::ApBpCin_func, a, static_cast<quint8>(~b), true);
+    case Enu::ApnBpCin_func: // A plus ~B plus Cin
+        return compute(Enu::ApBpCin_func, a, static_cast<quint8>(~b), carryIn);
+    case Enu::AandB_func: // A * B
+        res = a & b;
+        break;
+    case Enu::nAandB_func: // ~(A * B)
+        res = ~(a & b);
+        break;
+    case Enu::AorB_func: // A + B
+        res = a | b;
+        break;
+    case Enu::nAorB_func: // ~(A + B)
+        res = ~(a | b);
+        break;
+    case Enu::AxorB_func: // A xor B
+        res = a ^ b;
+        break;
+    case Enu::nA_func: // ~A
+        res = ~a;
+        break;
+    case Enu::ASLA_func: // ASL A
+        carryIn = false;
+        [[fallthrough]];
+    case Enu::ROLA_func: // ROL A
+        res = static_cast<quint8>(a << 1 | quint8{carryIn});
+        NZVC |= Enu::CMask * ((a & 0x80) >> 7); // Carry out equals the hi order bit
+        NZVC |= Enu::VMask * (((a << 1) ^ a) >> 7 & 1); // Signed overflow if a<hi> doesn't match a<hi-1>
+        break;
+    case Enu::ASRA_func: // ASR A
+        carryIn = a & 128; // RORA and ASRA only differ by how the carryIn is calculated
+        [[fallthrough]];
+    case Enu::RORA_func: // ROR a
+        res = static_cast<quint8>(a >> 1 | static_cast<quint8>(carryIn) << 7);
+        // Carry out is lowest order bit of a
+        NZVC |= Enu::CMask * (a & 1);
+        break;
+    case Enu::NZVCA_func: // Move A to NZVC
+        // Must return early to avoid NZ calculation
+        return static_cast<quint16>((a & (Enu::NMask | Enu::ZMask | Enu::VMask | Enu::CMask)) << 8);
+    default:
+        return 0;
+    }
+    // Result is negative if high order bit is 1
+    NZVC |= (res & 0x80) ? Enu::NMask : 0;
+    NZVC |= (res == 0) ? Enu::ZMask : 0;
+    return static_cast<quint16>(NZVC << 8 | res);
+}
+
+const quint16 *ALU::buildTable()
+{
+    // 16 functions * 2 carry ins * 256 * 256 entries, 4MiB in total.
+    // Allocated once and intentionally never freed.
+    auto *entries = new std::vector<quint16>(static_cast<size_t>(functionCount) << 17);
+    for(int func = 0; func < functionCount; func++) {
+        for(int carryIn = 0; carryIn < 2; carryIn++) {
+            for(int a = 0; a < 256; a++) {
+                quint16 *row = entries->data() + (func << 17 | carryIn << 16 | a << 8);
+                for(int b = 0; b < 256; b++) {
+                    row[b] = compute(static_cast<Enu::EALUFunc>(func), static_cast<quint8>(a),
+                                     static_cast<quint8>(b), carryIn);
+                }
+            }
+        }
+    }
+    return entries->data();
+}
+
+// Z must hold for both bytes; N, V and C come from the high order byte.
+static inline quint8 combineStatus(quint16 hi, quint16 lo)
+{
+    quint8 NZVC = ALU::status(hi) & ~Enu::ZMask;
+    NZVC |= ALU::status(hi) & ALU::status(lo) & Enu::ZMask;
+    return NZVC;
+}
+
+quint16 ALU::addWords(quint16 a, quint16 b, quint8 &NZVC)
+{
+    quint16 lo = lookup(Enu::ApB_func, a & 0xff, b & 0xff, false);
+    quint16 hi = lookup(Enu::ApBpCin_func, a >> 8, b >> 8, status(lo) & Enu::CMask);
+    NZVC = combineStatus(hi, lo);
+    return static_cast<quint16>(result(hi) << 8 | result(lo));
+}
+
+quint16 ALU::subtractWords(quint16 a, quint16 b, quint8 &NZVC)
+{
+    // The +1 of the two's complement is the carry in of the low order byte.
+    quint16 lo = lookup(Enu::ApnBp1_func, a & 0xff, b & 0xff, false);
+    quint16 hi = lookup(Enu::ApnBpCin_func, a >> 8, b >> 8, status(lo) & Enu::CMask);
+    NZVC = combineStatus(hi, lo);
+    return static_cast<quint16>(result(hi) << 8 | result(lo));
+}
+
+quint16 ALU::shiftLeftWord(quint16 a, bool carryIn, bool rotate, quint8 &NZVC)
+{
+    // The carry out of the low order byte is shifted into the high order byte.
+    quint16 lo = lookup(Enu::ROLA_func, a & 0xff, 0, rotate && carryIn);
+    quint16 hi = lookup(Enu::ROLA_func, a >> 8, 0, status(lo) & Enu::CMask);
+    NZVC = combineStatus(hi, lo);
+    return static_cast<quint16>(result(hi) << 8 | result(lo));
+}
+
+quint16 ALU::shiftRightWord(quint16 a, bool carryIn, bool rotate, quint8 &NZVC)
+{
+    // The carry out of the high order byte is shifted into the low order byte,
+    // and the final carry out comes from the low order byte.
+    quint16 hi = rotate ? lookup(Enu::RORA_func, a >> 8, 0, carryIn)
+                        : lookup(Enu::ASRA_func, a >> 8, 0, false);
+    quint16 lo = lookup(Enu::RORA_func, a & 0xff, 0, status(hi) & Enu::CMask);
+    NZVC = combineStatus(hi, lo) & ~Enu::CMask;
+    NZVC |= status(lo) & Enu::CMask;
+    return static_cast<quint16>(result(hi) << 8 | result(lo));
+}
@@ -0,0 +1,74 @@
+// File: alutable.h
+/*
+    The Pep/9 suite of applications (Pep9, Pep9CPU, Pep9Micro) are
+    simulators for the Pep/9 virtual machine, and allow users to
+    create, simulate, and debug across various levels of abstraction.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef ALUTABLE_H
+#define ALUTABLE_H
+
+#include <QtCore>
+#include "enu.h"
+
+/*
+ * Precomputed outputs of the Pep/9 8-bit ALU.
+ *
+ * Every (function, carry in, A, B) combination is evaluated once, the first time
+ * the table is used. Each entry packs the result byte in its low half and the NZVC
+ * bits in its high half, so that a calculation is a single load.
+ *
+ * Whether an output is meaningful (i.e. a carry in was present for functions that
+ * require one) is still decided by the caller. The table does not model the S bit.
+ */
+namespace ALU {
+    static const int functionCount = Enu::EALUFunc::NZVCA_func + 1;
+
+    // Evaluates one ALU operation directly. Used to build the table.
+    quint16 compute(Enu::EALUFunc func, quint8 a, quint8 b, bool carryIn);
+    const quint16 *buildTable();
+
+    inline const quint16 *table()
+    {
+        // Initialization of function local statics is thread safe, which matters
+        // now that simulations may run off the GUI thread.
+        static const quint16 *entries = buildTable();
+        return entries;
+    }
+
+    // Caller must guarantee that func < functionCount.
+    inline quint16 lookup(quint8 func, quint8 a, quint8 b, bool carryIn)
+    {
+        return table()[static_cast<quint32>(func) << 17 | static_cast<quint32>(carryIn) << 16
+                | static_cast<quint32>(a) << 8 | b];
+    }
+    inline quint8 result(quint16 entry) { return static_cast<quint8>(entry); }
+    inline quint8 status(quint16 entry) { return static_cast<quint8>(entry >> 8); }
+
+    /*
+     * 16-bit operations used by the ISA level simulator, performed as two chained
+     * byte lookups the same way the microcode drives the ALU.
+     * Each returns the result word and writes all four NZVC bits to NZVC.
+     */
+    quint16 addWords(quint16 a, quint16 b, quint8 &NZVC);
+    // Computes a + ~b + 1, so the carry out is set when no borrow occurs.
+    quint16 subtractWords(quint16 a, quint16 b, quint8 &NZVC);
+    quint16 shiftLeftWord(quint16 a, bool carryIn, bool rotate, quint8 &NZVC);
+    quint16 shiftRightWord(quint16 a, bool carryIn, bool rotate, quint8 &NZVC);
+}
+
+#endif // ALUTABLE_H
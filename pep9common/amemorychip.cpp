@@ -92,6 +92,42 @@ bool AMemoryChip::setWord(quint16 offsetFromBase, quint16 value)
     return retVal;
 }
 
+bool AMemoryChip::readRange(quint16 offsetFromBase, quint32 length, quint8 *output) const
+{
+    bool retVal = true;
+    for(quint32 it = 0; it < length; it++) {
+        retVal &= readByte(static_cast<quint16>(offsetFromBase + it), output[it]);
+    }
+    return retVal;
+}
+
+bool AMemoryChip::writeRange(quint16 offsetFromBase, quint32 length, const quint8 *values)
+{
+    bool retVal = true;
+    for(quint32 it = 0; it < length; it++) {
+        retVal &= writeByte(static_cast<quint16>(offsetFromBase + it), values[it]);
+    }
+    return retVal;
+}
+
+bool AMemoryChip::getRange(quint16 offsetFromBase, quint32 length, quint8 *output) const
+{
+    bool retVal = true;
+    for(quint32 it = 0; it < length; it++) {
+        retVal &= getByte(static_cast<quint16>(offsetFromBase + it), output[it]);
+    }
+    return retVal;
+}
+
+bool AMemoryChip::setRange(quint16 offsetFromBase, quint32 length, const quint8 *values)
+{
+    bool retVal = true;
+    for(quint32 it = 0; it < length; it++) {
+        retVal &= setByte(static_cast<quint16>(offsetFromBase + it), values[it]);
+    }
+    return retVal;
+}
+
 [[noreturn]] void AMemoryChip::outOfBoundsReadHelper(quint16 offsetFromBase) const
 {
     std::string message = "Out of range memory read at: " +
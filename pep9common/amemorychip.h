@@ -124,6 +124,14 @@ public:
     virtual bool getWord(quint16 offsetFromBase, quint16& output) const;
     virtual bool setWord(quint16 offsetFromBase, quint16 value);
 
+    // Read / Write / Get / Set length contiguous bytes starting at offsetFromBase.
+    // By default, these perform one byte operation per address. Chips with
+    // contiguous storage should override them to copy the entire block at once.
+    virtual bool readRange(quint16 offsetFromBase, quint32 length, quint8* output) const;
+    virtual bool writeRange(quint16 offsetFromBase, quint32 length, const quint8* values);
+    virtual bool getRange(quint16 offsetFromBase, quint32 length, quint8* output) const;
+    virtual bool setRange(quint16 offsetFromBase, quint32 length, const quint8* values);
+
 protected:
     quint32 size;
     quint16 baseAddress;
@@ -22,12 +22,28 @@
 
 #include "amemorydevice.h"
 
+#include <QMetaMethod>
+
 AMemoryDevice::AMemoryDevice(QObject *parent) noexcept: QObject(parent), bytesWritten(), bytesSet(),
-    errorMessage(""), error(false)
+    errorMessage(""), error(false), observers(), changeListeners(false),
+    changedConnected(false)
 {
 
 }
 
+void AMemoryDevice::addObserver(AMemoryObserver *observer)
+{
+    if(observer == nullptr || observers.contains(observer)) return;
+    observers.append(observer);
+    updateChangeListeners();
+}
+
+void AMemoryDevice::removeObserver(AMemoryObserver *observer)
+{
+    observers.removeAll(observer);
+    updateChangeListeners();
+}
+
 bool AMemoryDevice::hadError() const noexcept
 {
     return error;
@@ -44,12 +60,12 @@ void AMemoryDevice::clearErrors()
     errorMessage = "";
 }
 
-const QSet<quint16> AMemoryDevice::getBytesWritten() const noexcept
+const DirtyBitmap &AMemoryDevice::getBytesWritten() const noexcept
 {
     return bytesWritten;
 }
 
-const QSet<quint16> AMemoryDevice::getBytesSet() const noexcept
+const DirtyBitmap &AMemoryDevice::getBytesSet() const noexcept
 {
     return bytesSet;
 }
@@ -64,6 +80,54 @@ void AMemoryDevice::clearBytesSet() noexcept
     bytesSet.clear();
 }
 
+void AMemoryDevice::notifyOutputWritten(quint16 address, quint8 value) const
+{
+    for(auto observer : observers) {
+        observer->onOutputWritten(address, value);
+    }
+}
+
+void AMemoryDevice::notifyInputRequested(quint16 address) const
+{
+    for(auto observer : observers) {
+        observer->onInputRequested(address);
+    }
+}
+
+void AMemoryDevice::connectNotify(const QMetaMethod &signal)
+{
+    if(signal == QMetaMethod::fromSignal(&AMemoryDevice::changed)) {
+        updateChangeListeners();
+    }
+}
+
+void AMemoryDevice::disconnectNotify(const QMetaMethod &signal)
+{
+    // An invalid method means that every connection was removed at once.
+    if(!signal.isValid() || signal == QMetaMethod::fromSignal(&AMemoryDevice::changed)) {
+        updateChangeListeners();
+    }
+}
+
+void AMemoryDevice::updateChangeListeners() noexcept
+{
+    // Ask Qt rather than keeping a separate count, which could drift from the real connections.
+    changedConnected = isSignalConnected(QMetaMethod::fromSignal(&AMemoryDevice::changed));
+    changeListeners = !observers.isEmpty() || changedConnected;
+}
+
+void AMemoryDevice::notifyChangedSlow(quint16 address, quint8 newValue)
+{
+    for(auto observer : observers) {
+        observer->onMemoryChanged(address, newValue);
+    }
+    // Blocking signals (e.g. during loadValues(...)) only suppresses changed(...);
+    // observers, such as decode caches, must still learn of every change.
+    if(changedConnected.load(std::memory_order_relaxed) && !signalsBlocked()) {
+        emit changed(address, newValue);
+    }
+}
+
 bool AMemoryDevice::readWord(quint16 offsetFromBase, quint16 &output) const
 {
     quint8 temp = 0;
@@ -103,3 +167,39 @@ bool AMemoryDevice::setWord(quint16 offsetFromBase, quint16 value)
     retVal &= setByte(offsetFromBase+1, value & 0xff);
     return retVal;
 }
+
+bool AMemoryDevice::readRange(quint16 address, quint32 length, quint8 *output) const
+{
+    bool retVal = true;
+    for(quint32 it = 0; it < length; it++) {
+        retVal &= readByte(static_cast<quint16>(address + it), output[it]);
+    }
+    return retVal;
+}
+
+bool AMemoryDevice::writeRange(quint16 address, quint32 length, const quint8 *values)
+{
+    bool retVal = true;
+    for(quint32 it = 0; it < length; it++) {
+        retVal &= writeByte(static_cast<quint16>(address + it), values[it]);
+    }
+    return retVal;
+}
+
+bool AMemoryDevice::getRange(quint16 address, quint32 length, quint8 *output) const
+{
+    bool retVal = true;
+    for(quint32 it = 0; it < length; it++) {
+        retVal &= getByte(static_cast<quint16>(address + it), output[it]);
+    }
+    return retVal;
+}
+
+bool AMemoryDevice::setRange(quint16 address, quint32 length, const quint8 *values)
+{
+    bool retVal = true;
+    for(quint32 it = 0; it < length; it++) {
+        retVal &= setByte(static_cast<quint16>(address + it), values[it]);
+    }
+    return retVal;
+}
@@ -22,8 +22,32 @@
 #ifndef AMEMORYDEVICE_H
 #define AMEMORYDEVICE_H
 
+#include <atomic>
+
 #include <QObject>
-#include <QSet>
+#include <QVector>
+
+#include "dirtybitmap.h"
+
+/*
+ * Receives notifications from a memory device through plain virtual calls, rather than
+ * through Qt's signal machinery. Observers are invoked synchronously, on the thread performing
+ * the memory access, so they must not block or touch UI objects. Each method does nothing
+ * unless overriden, so observers need only implement the events they care about.
+ */
+class AMemoryObserver
+{
+public:
+    virtual ~AMemoryObserver() = default;
+    // The byte at address was written or set.
+    virtual void onMemoryChanged(quint16 address, quint8 newValue) { Q_UNUSED(address); Q_UNUSED(newValue);}
+    // A value was written to the memory-mapped output port at address.
+    virtual void onOutputWritten(quint16 address, quint8 value) { Q_UNUSED(address); Q_UNUSED(value);}
+    // A memory-mapped input port at address was read, but had no buffered input.
+    // The observer may satisfy the read before returning by calling the device's
+    // onInputReceived(...), onInputCanceled(...), or onInputAborted(...).
+    virtual void onInputRequested(quint16 address) { Q_UNUSED(address);}
+};
 
 /*
  * This class provides a unified interface for memory devices (like RAM, or a cache).
@@ -40,7 +64,11 @@
  * and set will modify the value. Some chips (like the ConstChip) do not support any modification, even
  * through set, but some chips like the ROMChip will error if written to, but will succede if set.
  *
- * Both set / write will trigger the changed(...) signal
+ * Both set / write will trigger the changed(...) signal, and will notify any AMemoryObserver.
+ * Observers are notified even while the device's signals are blocked.
+ * Observers are the preferred way for simulation components to listen to memory, since they
+ * avoid the cost of a signal emission. When there are neither observers nor connections
+ * to changed(...), a write costs only a single flag test.
  *
  * Therefore, programmers should use get / set when interacting with the memory model from the UI,
  * and the logical model operating on memory should use get / set.
@@ -50,9 +78,29 @@ class AMemoryDevice : public QObject
 {
     Q_OBJECT
 protected:
-    QSet<quint16> bytesWritten, bytesSet;
+    DirtyBitmap bytesWritten, bytesSet;
     mutable QString errorMessage;
     mutable bool error;
+    // Observers are not owned by the device.
+    QVector<AMemoryObserver*> observers;
+    // True if there are observers or connections to changed(...). May be updated by
+    // a connection made from another thread, so it is atomic.
+    std::atomic<bool> changeListeners;
+    // True if any slot is connected to changed(...). Only refreshed when a connection
+    // is made or broken, so that notifying does not need to query Qt for every byte.
+    std::atomic<bool> changedConnected;
+
+    // Notify observers and connected slots that the byte at address changed.
+    // Inlined so that the common case of no listeners is only a flag test.
+    inline void notifyChanged(quint16 address, quint8 newValue);
+    // Notify observers that a value was written to an output port.
+    void notifyOutputWritten(quint16 address, quint8 value) const;
+    // Notify observers that an input port needs a value.
+    void notifyInputRequested(quint16 address) const;
+
+    // Track connections to changed(...), so that emissions may be skipped when no one is listening.
+    void connectNotify(const QMetaMethod& signal) override;
+    void disconnectNotify(const QMetaMethod& signal) override;
 public:
     explicit AMemoryDevice(QObject *parent = nullptr) noexcept;
 
@@ -64,20 +112,37 @@ public:
     // The Pep/9 memory model should at most be 2^16 bytes, but provide
     // for potential expansion in the future.
     virtual quint32 maxAddress() const noexcept = 0;
+    // Can the contents of an address be cached, or are they volatile (e.g. memory-mapped IO)?
+    // To reduce unecessary code, assume an address is cachable unless overriden.
+    virtual bool isCachable(quint16 address) const noexcept { Q_UNUSED(address); return true;}
+
+    // Observers must be removed before they are destroyed. Should not be called while
+    // a different thread is accessing the device.
+    void addObserver(AMemoryObserver* observer);
+    void removeObserver(AMemoryObserver* observer);
 
     // Remove any pending errors in the memory device.
     void clearErrors();
 
     // Returns the set of bytes the have been written / set.
     // since the last clear.
-    const QSet<quint16> getBytesWritten() const noexcept;
-    const QSet<quint16> getBytesSet() const noexcept;
+    const DirtyBitmap& getBytesWritten() const noexcept;
+    const DirtyBitmap& getBytesSet() const noexcept;
     // Call after all components have (synchronously) had a chance
     // to access these fields. The set of written / set bytes will
     // continue to grow until explicitly reset.
     void clearBytesWritten() noexcept;
     void clearBytesSet() noexcept;
 
+    // Read / Write / Get / Set length contiguous bytes starting at address,
+    // following the same side-effect rules as the byte functions below.
+    // By default, these perform one byte operation per address. Devices
+    // should override them to operate on entire blocks at once.
+    virtual bool readRange(quint16 address, quint32 length, quint8* output) const;
+    virtual bool writeRange(quint16 address, quint32 length, const quint8* values);
+    virtual bool getRange(quint16 address, quint32 length, quint8* output) const;
+    virtual bool setRange(quint16 address, quint32 length, const quint8* values);
+
 public slots:
     // Clear the contents of memory. All addresses from 0 to size will be set to 0.
     virtual void clearMemory() = 0;
@@ -104,7 +169,14 @@ signals:
     // Signal that a memory address has been written / set.
     void changed(quint16 address, quint8 newValue);
 
-
+private:
+    void updateChangeListeners() noexcept;
+    void notifyChangedSlow(quint16 address, quint8 newValue);
 };
 
+inline void AMemoryDevice::notifyChanged(quint16 address, quint8 newValue)
+{
+    if(changeListeners.load(std::memory_order_relaxed)) notifyChangedSlow(address, newValue);
+}
+
 #endif // AMEMORYDEVICE_H
@@ -0,0 +1,73 @@
+// File: dirtybitmap.cpp
+/*
+    The Pep/9 suite of applications (Pep9, Pep9CPU, Pep9Micro) are
+    simulators for the Pep/9 virtual machine, and allow users to
+    create, simulate, and debug across various levels of abstraction.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "dirtybitmap.h"
+
+DirtyBitmap::DirtyBitmap() noexcept: bits(), summary()
+{
+    bits.fill(0);
+    summary.fill(0);
+}
+
+void DirtyBitmap::markRange(quint16 first, quint16 last) noexcept
+{
+    for(quint32 address = first; address <= last; address++) {
+        mark(static_cast<quint16>(address));
+    }
+}
+
+bool DirtyBitmap::isDirty(quint16 address) const noexcept
+{
+    return (bits[address / lineSize] >> (address % lineSize)) & 1;
+}
+
+bool DirtyBitmap::isEmpty() const noexcept
+{
+    for(auto lines : summary) {
+        if(lines != 0) return false;
+    }
+    return true;
+}
+
+void DirtyBitmap::clear() noexcept
+{
+    for(quint32 summaryIndex = 0; summaryIndex < summary.size(); summaryIndex++) {
+        quint64 lines = summary[summaryIndex];
+        while(lines != 0) {
+            bits[summaryIndex * 64 + qCountTrailingZeroBits(lines)] = 0;
+            lines &= lines - 1;
+        }
+        summary[summaryIndex] = 0;
+    }
+}
+
+void DirtyBitmap::unite(const DirtyBitmap &other) noexcept
+{
+    for(quint32 summaryIndex = 0; summaryIndex < summary.size(); summaryIndex++) {
+        quint64 lines = other.summary[summaryIndex];
+        summary[summaryIndex] |= lines;
+        while(lines != 0) {
+            quint32 line = summaryIndex * 64 + qCountTrailingZeroBits(lines);
+            bits[line] |= other.bits[line];
+            lines &= lines - 1;
+        }
+    }
+}
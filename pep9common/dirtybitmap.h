@@ -0,0 +1,114 @@
+// File: dirtybitmap.h
+/*
+    The Pep/9 suite of applications (Pep9, Pep9CPU, Pep9Micro) are
+    simulators for the Pep/9 virtual machine, and allow users to
+    create, simulate, and debug across various levels of abstraction.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef DIRTYBITMAP_H
+#define DIRTYBITMAP_H
+
+#include <array>
+
+#include <QtGlobal>
+
+/*
+ * Tracks which of the 2^16 memory addresses have been modified.
+ *
+ * Each address is represented by a single bit, so marking an address is O(1)
+ * and never allocates. Every 64 bit word of the bitmap (a "line" of 64 addresses)
+ * is additionally summarized by a single bit, which allows clearing and iterating
+ * to skip over untouched portions of memory. The cost of both is proportional to
+ * the number of dirty lines, rather than the size of memory.
+ */
+class DirtyBitmap
+{
+public:
+    // Number of addresses summarized by a single summary bit.
+    static constexpr quint32 lineSize = 64;
+    static constexpr quint32 lineCount = (1 << 16) / lineSize;
+
+    DirtyBitmap() noexcept;
+
+    // Record that address was modified.
+    inline void mark(quint16 address) noexcept;
+    // Record that every address in [first, last] was modified.
+    void markRange(quint16 first, quint16 last) noexcept;
+    bool isDirty(quint16 address) const noexcept;
+    // Returns true if no address has been marked since the last clear.
+    bool isEmpty() const noexcept;
+    // Forget all marked addresses. Only dirty lines are visited.
+    void clear() noexcept;
+    // Mark every address that is marked in other.
+    void unite(const DirtyBitmap& other) noexcept;
+
+    // Call func(quint16 address) for each dirty address in ascending order.
+    template <typename Func>
+    void forEachAddress(Func func) const;
+    // Call func(quint16 first, quint16 last) for each maximal run of consecutive
+    // dirty addresses in ascending order. Both ends of the range are inclusive.
+    template <typename Func>
+    void forEachRange(Func func) const;
+
+private:
+    std::array<quint64, lineCount> bits;
+    std::array<quint64, lineCount / 64> summary;
+};
+
+inline void DirtyBitmap::mark(quint16 address) noexcept
+{
+    quint32 line = address / lineSize;
+    bits[line] |= quint64{1} << (address % lineSize);
+    summary[line / 64] |= quint64{1} << (line % 64);
+}
+
+template <typename Func>
+void DirtyBitmap::forEachAddress(Func func) const
+{
+    for(quint32 summaryIndex = 0; summaryIndex < summary.size(); summaryIndex++) {
+        quint64 lines = summary[summaryIndex];
+        while(lines != 0) {
+            quint32 line = summaryIndex * 64 + qCountTrailingZeroBits(lines);
+            // Remove the lowest set bit.
+            lines &= lines - 1;
+            quint64 word = bits[line];
+            while(word != 0) {
+                func(static_cast<quint16>(line * lineSize + qCountTrailingZeroBits(word)));
+                word &= word - 1;
+            }
+        }
+    }
+}
+
+template <typename Func>
+void DirtyBitmap::forEachRange(Func func) const
+{
+    bool inRange = false;
+    quint16 first = 0, previous = 0;
+    forEachAddress([&](quint16 address) {
+        if(inRange && address == previous + 1) {
+            previous = address;
+            return;
+        }
+        if(inRange) func(first, previous);
+        inRange = true;
+        first = previous = address;
+    });
+    if(inRange) func(first, previous);
+}
+
+#endif // DIRTYBITMAP_H
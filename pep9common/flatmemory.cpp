@@ -0,0 +1,375 @@
+// File: flatmemory.cpp
+/*
+    The Pep/9 suite of applications (Pep9, Pep9CPU, Pep9Micro) are
+    simulators for the Pep/9 virtual machine, and allow users to
+    create, simulate, and debug across various levels of abstraction.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "flatmemory.h"
+
+#include <stdexcept>
+
+#include <QCoreApplication>
+
+FlatMemory::FlatMemory(QObject *parent) noexcept: AMemoryDevice(parent),
+    memory(), attributes(), ports(), maxAddr(0xffff)
+{
+    // Default to 64k of RAM, like a MainMemory with a single RAMChip installed.
+    memory.fill(0);
+    attributes.fill(NONE);
+}
+
+FlatMemory::~FlatMemory()
+{
+
+}
+
+quint32 FlatMemory::maxAddress() const noexcept
+{
+    return maxAddr;
+}
+
+bool FlatMemory::isCachable(quint16 address) const noexcept
+{
+    return (attributes[address] & (UNINSTALLED | MEMORY_MAPPED)) == 0;
+}
+
+void FlatMemory::constructMemoryDevice(QList<MemoryChipSpec> specList)
+{
+    // Any address not described by a specification is uninstalled.
+    attributes.fill(UNINSTALLED);
+    ports.clear();
+    maxAddr = 0;
+    for(auto spec : specList) {
+        quint8 attribute = NONE;
+        switch(spec.type) {
+        case AMemoryChip::ChipTypes::RAM:
+            attribute = NONE;
+            break;
+        case AMemoryChip::ChipTypes::ROM:
+            attribute = READ_ONLY;
+            break;
+        case AMemoryChip::ChipTypes::IDEV:
+        case AMemoryChip::ChipTypes::ODEV:
+            attribute = MEMORY_MAPPED;
+            break;
+        default:
+            throw std::invalid_argument("FlatMemory only supports RAM, ROM, IDEV, and ODEV chips.");
+        }
+        for(quint32 offset = 0; offset < spec.size && spec.startAddr + offset <= 0xffff; offset++) {
+            quint16 address = static_cast<quint16>(spec.startAddr + offset);
+            attributes[address] = attribute;
+            if(attribute == MEMORY_MAPPED) {
+                IOPort port;
+                port.type = spec.type;
+                ports.insert(address, port);
+            }
+        }
+        // Highest address is the start of the chip plus its size, minus one
+        // since addresses start at 0, not 1.
+        if(spec.size != 0 && spec.startAddr + spec.size - 1 > maxAddr) {
+            maxAddr = spec.startAddr + spec.size - 1;
+        }
+    }
+}
+
+void FlatMemory::loadValues(quint16 address, QVector<quint8> values) noexcept
+{
+    // Block signals being omitted, to match MainMemory::loadValues(...).
+    bool block = signalsBlocked();
+    blockSignals(true);
+    // Only copy the values that fall in range of the memory device.
+    qint64 count = qMin<qint64>(values.length(), qint64{maxAddress()} - address + 1);
+    if(count > 0) {
+        setRange(address, static_cast<quint32>(count), values.constData());
+    }
+    blockSignals(block);
+}
+
+QSharedPointer<const FlatMemory::Snapshot> FlatMemory::snapshot() const
+{
+    auto retVal = QSharedPointer<Snapshot>::create();
+    retVal->memory = memory;
+    retVal->attributes = attributes;
+    retVal->ports = ports;
+    retVal->maxAddr = maxAddr;
+    return retVal;
+}
+
+void FlatMemory::restore(const QSharedPointer<const Snapshot> &snapshot)
+{
+    memory = snapshot->memory;
+    attributes = snapshot->attributes;
+    // QMap is implicitly shared, so the ports are only copied once this device modifies them.
+    ports = snapshot->ports;
+    maxAddr = snapshot->maxAddr;
+    clearErrors();
+}
+
+void FlatMemory::clearMemory()
+{
+    memory.fill(0);
+    for(auto address : ports.keys()) {
+        ports[address].value = 0;
+    }
+    clearErrors();
+    clearIO();
+}
+
+void FlatMemory::onCycleStarted()
+{
+    // Flat memory doesn't have any per-cycle internal updates.
+}
+
+void FlatMemory::onCycleFinished()
+{
+    // Flat memory doesn't have any per-cycle internal updates.
+}
+
+bool FlatMemory::readByte(quint16 address, quint8 &output) const
+{
+    return readByteInline(address, output);
+}
+
+bool FlatMemory::writeByte(quint16 address, quint8 value)
+{
+    return writeByteInline(address, value);
+}
+
+bool FlatMemory::getByte(quint16 address, quint8 &output) const
+{
+    return getByteInline(address, output);
+}
+
+bool FlatMemory::setByte(quint16 address, quint8 value)
+{
+    return setByteInline(address, value);
+}
+
+bool FlatMemory::readWord(quint16 address, quint16 &output) const
+{
+    return readWordInline(address, output);
+}
+
+bool FlatMemory::writeWord(quint16 address, quint16 value)
+{
+    return writeWordInline(address, value);
+}
+
+bool FlatMemory::getWord(quint16 address, quint16 &output) const
+{
+    quint8 hi = 0, lo = 0;
+    bool retVal = getByteInline(address, hi);
+    retVal &= getByteInline(static_cast<quint16>(address + 1), lo);
+    output = static_cast<quint16>(hi << 8 | lo);
+    return retVal;
+}
+
+bool FlatMemory::setWord(quint16 address, quint16 value)
+{
+    bool retVal = setByteInline(address, static_cast<quint8>(value >> 8));
+    retVal &= setByteInline(static_cast<quint16>(address + 1), static_cast<quint8>(value & 0xff));
+    return retVal;
+}
+
+bool FlatMemory::readRange(quint16 address, quint32 length, quint8 *output) const
+{
+    bool retVal = true;
+    for(quint32 it = 0; it < length; it++) {
+        retVal &= readByteInline(static_cast<quint16>(address + it), output[it]);
+    }
+    return retVal;
+}
+
+bool FlatMemory::writeRange(quint16 address, quint32 length, const quint8 *values)
+{
+    bool retVal = true;
+    for(quint32 it = 0; it < length; it++) {
+        retVal &= writeByteInline(static_cast<quint16>(address + it), values[it]);
+    }
+    return retVal;
+}
+
+bool FlatMemory::getRange(quint16 address, quint32 length, quint8 *output) const
+{
+    bool retVal = true;
+    for(quint32 it = 0; it < length; it++) {
+        retVal &= getByteInline(static_cast<quint16>(address + it), output[it]);
+    }
+    return retVal;
+}
+
+bool FlatMemory::setRange(quint16 address, quint32 length, const quint8 *values)
+{
+    bool retVal = true;
+    for(quint32 it = 0; it < length; it++) {
+        retVal &= setByteInline(static_cast<quint16>(address + it), values[it]);
+    }
+    return retVal;
+}
+
+void FlatMemory::clearIO()
+{
+    for(auto address : ports.keys()) {
+        IOPort& port = ports[address];
+        port.buffer.clear();
+        port.waiting = false;
+        port.canceled = false;
+        port.aborted = false;
+    }
+}
+
+void FlatMemory::onInputReceived(quint16 address, quint8 input)
+{
+    onInputReceived(address, QString(input));
+}
+
+void FlatMemory::onInputReceived(quint16 address, QChar input)
+{
+    onInputReceived(address, QString(input));
+}
+
+void FlatMemory::onInputReceived(quint16 address, QString input)
+{
+    if(input.isEmpty()) return;
+    IOPort& port = inputPortAt(address);
+    if(port.waiting) {
+        // Satisfy the outstanding request with the first character, and buffer the rest.
+        port.value = static_cast<quint8>(input.front().toLatin1());
+        port.buffer.append(input.mid(1, -1).toLatin1());
+        port.waiting = false;
+    }
+    else {
+        port.buffer.append(input.toLatin1());
+    }
+}
+
+void FlatMemory::onInputCanceled(quint16 address)
+{
+    IOPort& port = inputPortAt(address);
+    port.waiting = false;
+    port.canceled = true;
+}
+
+void FlatMemory::onInputAborted(quint16 address)
+{
+    IOPort& port = inputPortAt(address);
+    port.waiting = false;
+    port.aborted = true;
+}
+
+bool FlatMemory::readSlow(quint16 address, quint8 &output) const
+{
+    if(!(attributes[address] & MEMORY_MAPPED)
+            || ports[address].type != AMemoryChip::ChipTypes::IDEV) {
+        return getSlow(address, output);
+    }
+    IOPort& port = ports[address];
+    // Serve the read from previously buffered input if possible.
+    if(!port.buffer.isEmpty()) {
+        port.value = static_cast<quint8>(port.buffer.front());
+        port.buffer.remove(0, 1);
+        output = port.value;
+        return true;
+    }
+    // Otherwise, request input and give the receiver a chance to respond.
+    port.waiting = true;
+    port.canceled = false;
+    port.aborted = false;
+    // Observers may answer the request directly. Only fall back to the
+    // signal & event loop if none of them did.
+    notifyInputRequested(address);
+    if(port.waiting) {
+        emit inputRequested(address);
+        // Let the receiver handle I/O before returning to this device.
+        if(port.waiting) {
+            QCoreApplication::processEvents();
+        }
+    }
+    if(port.canceled) {
+        return false;
+    }
+    else if(port.aborted) {
+        port.value = errorChar;
+    }
+    output = port.value;
+    return true;
+}
+
+bool FlatMemory::writeSlow(quint16 address, quint8 value)
+{
+    quint8 attribute = attributes[address];
+    if(attribute & UNINSTALLED) {
+        return setSlow(address, value);
+    }
+    else if(attribute & READ_ONLY) {
+        // Don't allow users to change (write to) read only memory.
+        notifyChanged(address, value);
+        return true;
+    }
+    IOPort& port = ports[address];
+    port.value = value;
+    notifyChanged(address, value);
+    if(port.type == AMemoryChip::ChipTypes::ODEV) {
+        notifyOutputWritten(address, value);
+        emit outputWritten(address, value);
+    }
+    return true;
+}
+
+bool FlatMemory::getSlow(quint16 address, quint8 &output) const
+{
+    if(attributes[address] & UNINSTALLED) {
+        error = true;
+        errorMessage = "Attempted to read from memory not installed in computer at: " +
+                QString("0x%1.").arg(address, 4, 16, QLatin1Char('0'));
+        return false;
+    }
+    else if(attributes[address] & MEMORY_MAPPED) {
+        output = ports[address].value;
+        return true;
+    }
+    output = memory[address];
+    return true;
+}
+
+bool FlatMemory::setSlow(quint16 address, quint8 value)
+{
+    if(attributes[address] & UNINSTALLED) {
+        error = true;
+        errorMessage = "Attempted to write to memory not installed in computer at: " +
+                QString("0x%1.").arg(address, 4, 16, QLatin1Char('0'));
+        return false;
+    }
+    else if(attributes[address] & MEMORY_MAPPED) {
+        ports[address].value = value;
+    }
+    else {
+        memory[address] = value;
+    }
+    notifyChanged(address, value);
+    return true;
+}
+
+FlatMemory::IOPort &FlatMemory::inputPortAt(quint16 address)
+{
+    if(!(attributes[address] & MEMORY_MAPPED)
+            || ports[address].type != AMemoryChip::ChipTypes::IDEV) {
+        throw std::invalid_argument("Expected address of an input port, given address of other type.");
+    }
+    return ports[address];
+}
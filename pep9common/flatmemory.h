@@ -0,0 +1,223 @@
+// File: flatmemory.h
+/*
+    The Pep/9 suite of applications (Pep9, Pep9CPU, Pep9Micro) are
+    simulators for the Pep/9 virtual machine, and allow users to
+    create, simulate, and debug across various levels of abstraction.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef FLATMEMORY_H
+#define FLATMEMORY_H
+
+#include <array>
+
+#include <QByteArray>
+#include <QMap>
+#include <QObject>
+#include <QSharedPointer>
+#include <QVector>
+
+#include "amemorydevice.h"
+#include "mainmemory.h"
+
+/*
+ * A memory device that stores all 2^16 bytes of memory in a single flat array.
+ *
+ * MainMemory must translate every access to a chip via its lookup table, and then
+ * perform a virtual call on that chip. This is flexible enough to be driven by the
+ * UI's memory configuration, but it is needlessly slow when no UI is attached.
+ *
+ * Instead, FlatMemory keeps a per-address attribute byte. Plain RAM has no attributes,
+ * so the common case is a single array access performed by the inline accessors
+ * below. ROM, uninstalled addresses, and memory-mapped IO ports are flagged, and
+ * are handled out-of-line. IO ports are described by a small side table rather than
+ * by chips.
+ *
+ * Since there is no UI to highlight them, the bytes that were written / set are
+ * not recorded.
+ *
+ * The signals and IO slots mirror those of MainMemory, so that the two devices may be
+ * used interchangeably by the terminal helpers. Helpers that run without a UI should
+ * prefer registering an AMemoryObserver, which avoids a signal emission per character.
+ */
+class FlatMemory final : public AMemoryDevice
+{
+    Q_OBJECT
+public:
+    explicit FlatMemory(QObject* parent = nullptr) noexcept;
+    virtual ~FlatMemory() override;
+
+    // AMemoryDevice interface
+    quint32 maxAddress() const noexcept override;
+    bool isCachable(quint16 address) const noexcept override;
+
+    // Configure this memory device as described by the specifications in the
+    // specList. Addresses not covered by a specification will be uninstalled.
+    // Only RAM, ROM, IDEV, and ODEV chips are supported.
+    void constructMemoryDevice(QList<MemoryChipSpec> specList);
+
+    // Copies the bytes from values into memory starting at address.
+    void loadValues(quint16 address, QVector<quint8> values) noexcept;
+
+    // An immutable copy of the contents, configuration, and IO buffers of a device.
+    // A snapshot is shared between all of its holders, so it may be captured once
+    // (e.g. after the operating system is burned), and restored into any number
+    // of devices without re-building the memory map or re-loading the operating system.
+    class Snapshot;
+    QSharedPointer<const Snapshot> snapshot() const;
+    // Replace the state of this device with that of the snapshot. Outstanding
+    // errors are cleared. No change signals are emitted.
+    void restore(const QSharedPointer<const Snapshot>& snapshot);
+
+    // Non-virtual accessors that complete without leaving the header for
+    // ordinary RAM, and defer to the out-of-line versions otherwise.
+    inline bool readByteInline(quint16 address, quint8& output) const;
+    inline bool writeByteInline(quint16 address, quint8 value);
+    inline bool getByteInline(quint16 address, quint8& output) const;
+    inline bool setByteInline(quint16 address, quint8 value);
+    inline bool readWordInline(quint16 address, quint16& output) const;
+    inline bool writeWordInline(quint16 address, quint16 value);
+
+public slots:
+    // Set all memory to 0, clear all outstanding IO operations.
+    void clearMemory() override;
+
+    // Flat memory doesn't need to provide dynamic aging of any memory contents,
+    // so these methods do nothing.
+    void onCycleStarted() override;
+    void onCycleFinished() override;
+
+    bool readByte(quint16 address, quint8 &output) const override;
+    bool writeByte(quint16 address, quint8 value) override;
+    bool getByte(quint16 address, quint8 &output) const override;
+    bool setByte(quint16 address, quint8 value) override;
+    // Avoid composing words from two virtual byte accesses.
+    bool readWord(quint16 address, quint16& output) const override;
+    bool writeWord(quint16 address, quint16 value) override;
+    bool getWord(quint16 address, quint16& output) const override;
+    bool setWord(quint16 address, quint16 value) override;
+    // Perform a whole range through the inline accessors, rather than through
+    // one virtual call per byte.
+    bool readRange(quint16 address, quint32 length, quint8* output) const override;
+    bool writeRange(quint16 address, quint32 length, const quint8* values) override;
+    bool getRange(quint16 address, quint32 length, quint8* output) const override;
+    bool setRange(quint16 address, quint32 length, const quint8* values) override;
+
+    // Clear any saved input, and cancel any outstanding IO requests.
+    void clearIO();
+
+    // If no input is currently requested for the address, it will be
+    // buffered internally for future usage.
+    void onInputReceived(quint16 address, quint8 input);
+    void onInputReceived(quint16 address, QChar input);
+    void onInputReceived(quint16 address, QString input);
+
+    void onInputCanceled(quint16 address);
+    void onInputAborted(quint16 address);
+
+signals:
+    void inputRequested(quint16 address) const;
+    void outputWritten(quint16 address, quint8 value);
+
+private:
+    enum Attributes: quint8 {
+        NONE = 0,
+        // Writes are ignored, but sets are permitted.
+        READ_ONLY = 1<<0,
+        // The address is not backed by any storage. All accesses are errors.
+        UNINSTALLED = 1<<1,
+        // Reads and / or writes trap to an entry in the IO side table.
+        MEMORY_MAPPED = 1<<2,
+    };
+    // State for a single memory-mapped IO port.
+    struct IOPort {
+        AMemoryChip::ChipTypes type = AMemoryChip::ChipTypes::IDEV;
+        // Last value received by / written to the port.
+        quint8 value = 0;
+        // Input that arrived before it was requested.
+        QByteArray buffer = {};
+        bool waiting = false, canceled = false, aborted = false;
+    };
+public:
+    class Snapshot {
+        friend class FlatMemory;
+        std::array<quint8, 1<<16> memory, attributes;
+        QMap<quint16, IOPort> ports;
+        quint32 maxAddr;
+    };
+private:
+    // If IO is aborted, which character shall be returned. Matches InputChip.
+    static constexpr quint8 errorChar = 0x04;
+    std::array<quint8, 1<<16> memory;
+    std::array<quint8, 1<<16> attributes;
+    mutable QMap<quint16, IOPort> ports;
+    quint32 maxAddr;
+
+    // Out-of-line handlers for addresses with attributes.
+    bool readSlow(quint16 address, quint8& output) const;
+    bool writeSlow(quint16 address, quint8 value);
+    bool getSlow(quint16 address, quint8& output) const;
+    bool setSlow(quint16 address, quint8 value);
+    IOPort& inputPortAt(quint16 address);
+};
+
+inline bool FlatMemory::readByteInline(quint16 address, quint8 &output) const
+{
+    if(attributes[address] != NONE) return readSlow(address, output);
+    output = memory[address];
+    return true;
+}
+
+inline bool FlatMemory::writeByteInline(quint16 address, quint8 value)
+{
+    if(attributes[address] != NONE) return writeSlow(address, value);
+    memory[address] = value;
+    notifyChanged(address, value);
+    return true;
+}
+
+inline bool FlatMemory::getByteInline(quint16 address, quint8 &output) const
+{
+    if(attributes[address] != NONE) return getSlow(address, output);
+    output = memory[address];
+    return true;
+}
+
+inline bool FlatMemory::setByteInline(quint16 address, quint8 value)
+{
+    if(attributes[address] != NONE) return setSlow(address, value);
+    memory[address] = value;
+    notifyChanged(address, value);
+    return true;
+}
+
+inline bool FlatMemory::readWordInline(quint16 address, quint16 &output) const
+{
+    quint8 hi = 0, lo = 0;
+    bool retVal = readByteInline(address, hi);
+    retVal &= readByteInline(static_cast<quint16>(address + 1), lo);
+    output = static_cast<quint16>(hi << 8 | lo);
+    return retVal;
+}
+
+inline bool FlatMemory::writeWordInline(quint16 address, quint16 value)
+{
+    bool retVal = writeByteInline(address, static_cast<quint8>(value >> 8));
+    retVal &= writeByteInline(static_cast<quint16>(address + 1), static_cast<quint8>(value & 0xff));
+    return retVal;
+}
+
+#endif // FLATMEMORY_H
@@ -28,7 +28,7 @@
 #include "mainmemory.h"
 
 MainMemory::MainMemory(QObject* parent) noexcept: AMemoryDevice (parent), updateMemMap(true),
-    endChip(new NilChip(0xffff, 0, this)), addressToChipLookupTable(1 << 16), maxAddr(0)
+    endChip(new NilChip(0xffff, 0, this)), addressToChipLookupTable(1 << 16), abortOnMissingInput(false), maxAddr(0)
 {
 
 }
@@ -64,10 +64,10 @@ void MainMemory::insertChip(QSharedPointer<AMemoryChip> chip, quint16 address)
     // so make sure to explicitly reset its address to prevent mapping errors.
     chip->setBaseAddress(address);
     if(chip->getChipType() == AMemoryChip::ChipTypes::IDEV) {
-        connect(static_cast<InputChip*>(chip.get()), &InputChip::inputRequested, this,  &MainMemory::onChipInputRequested);
-    }
-    else if(chip->getChipType() == AMemoryChip::ChipTypes::ODEV) {
-        connect(static_cast<OutputChip*>(chip.get()), &OutputChip::outputGenerated, this,  &MainMemory::onChipOutputWritten);
+        // Chips are only ever accessed through this device, so their requests must always be
+        // handled immediately, even if the CPU is executing on a thread other than the UI's.
+        connect(static_cast<InputChip*>(chip.get()), &InputChip::inputRequested, this,  &MainMemory::onChipInputRequested,
+                Qt::DirectConnection);
     }
     if(updateMemMap) calculateAddressToChip();
 }
@@ -90,6 +90,11 @@ const AMemoryChip* MainMemory::chipAt(quint16 address) const noexcept
     return endChip.get();
 }
 
+bool MainMemory::isCachable(quint16 address) const noexcept
+{
+    return chipAt(address)->isCachable();
+}
+
 void MainMemory::constructMemoryDevice(QList<MemoryChipSpec> specList)
 {
     // Prevent interim memory map updates, as many chips will be inserted and removed.
@@ -170,9 +175,6 @@ QVector<QSharedPointer<AMemoryChip> > MainMemory::removeAllChips()
         if(it->getChipType() == AMemoryChip::ChipTypes::IDEV) {
             disconnect(static_cast<InputChip*>(it.get()), &InputChip::inputRequested, this,  &MainMemory::onChipInputRequested);
         }
-        else if(it->getChipType() == AMemoryChip::ChipTypes::ODEV) {
-            disconnect(static_cast<OutputChip*>(it.get()), &OutputChip::outputGenerated, this,  &MainMemory::onChipOutputWritten);
-        }
     }
     if(temp.contains(endChip)) {
         auto isNilChip = [this](QSharedPointer<AMemoryChip> chip) {return chip == endChip;};
@@ -191,20 +193,115 @@ void MainMemory::autoUpdateMemoryMap(bool update) noexcept
     if(updateMemMap) calculateAddressToChip();
 }
 
+template <typename Func>
+bool MainMemory::forEachChipBlock(quint16 address, quint32 length, Func func) const
+{
+    bool retVal = true;
+    quint32 offset = 0;
+    while(offset < length) {
+        quint16 start = static_cast<quint16>(address + offset);
+        const AMemoryChip *chip = chipAt(start);
+        // A block may not extend past the end of its chip, nor past the top of memory.
+        quint32 chipEnd = qMin<quint32>(chip->getBaseAddress() + chip->getSize(), 1 << 16);
+        quint32 count = qMin<quint32>(length - offset, chipEnd > start ? chipEnd - start : 1);
+        // A failing block must not prevent the remaining blocks from being accessed,
+        // so errors are recorded per block.
+        try {
+            retVal &= func(start, offset, count);
+        }
+        // Did the memory access fall out of range?
+        catch (std::range_error &e) {
+            this->error = true;
+            this->errorMessage = e.what();
+            retVal = false;
+        }
+        catch (std::out_of_range &e) {
+            this->error = true;
+            this->errorMessage = e.what();
+            retVal = false;
+        }
+        // Input was requested, but it was aborted in an error-inducing way.
+        catch(io_aborted &e) {
+            this->error = true;
+            this->errorMessage = e.what();
+            retVal = false;
+        }
+        // An invalid chip (such as the nil chip) was accessed.
+        catch (bad_chip_write& e){
+            error = true;
+            errorMessage = e.what();
+            retVal = false;
+        }
+        offset += count;
+    }
+    return retVal;
+}
+
+void MainMemory::setAbortOnMissingInput(bool abort) noexcept
+{
+    abortOnMissingInput = abort;
+}
+
 void MainMemory::loadValues(quint16 address, QVector<quint8> values) noexcept
 {
     // Block signals being omitted, as it was causing issues with large heap sizes.
     bool block = signalsBlocked();
     blockSignals(true);
-    // For ever value in the values array that falls in range of the memory module.
-    for(quint16 idx = 0;idx < values.length()
-        && idx + address <= static_cast<qint32>(maxAddress()); idx++) {
-        bytesSet.insert(idx + address);
-        setByte(idx + address, values[idx]);
+    // Only copy the values that fall in range of the memory module.
+    qint64 count = qMin<qint64>(values.length(), qint64{maxAddress()} - address + 1);
+    if(count > 0) {
+        setRange(address, static_cast<quint32>(count), values.constData());
     }
     blockSignals(block);
 }
 
+bool MainMemory::readRange(quint16 address, quint32 length, quint8 *output) const
+{
+    return forEachChipBlock(address, length, [this, output](quint16 start, quint32 offset, quint32 count) {
+        const AMemoryChip *chip = chipAt(start);
+        return chip->readRange(start - chip->getBaseAddress(), count, output + offset);
+    });
+}
+
+bool MainMemory::writeRange(quint16 address, quint32 length, const quint8 *values)
+{
+    return forEachChipBlock(address, length, [this, values](quint16 start, quint32 offset, quint32 count) {
+        AMemoryChip *chip = chipAt(start);
+        bool retVal = chip->writeRange(start - chip->getBaseAddress(), count, values + offset);
+        bytesWritten.markRange(start, static_cast<quint16>(start + count - 1));
+        bool isOutput = chip->getChipType() == AMemoryChip::ChipTypes::ODEV;
+        for(quint32 it = 0; it < count; it++) {
+            notifyChanged(static_cast<quint16>(start + it), values[offset + it]);
+            if(isOutput) onChipOutputWritten(static_cast<quint16>(start + it), values[offset + it]);
+        }
+        return retVal;
+    });
+}
+
+bool MainMemory::getRange(quint16 address, quint32 length, quint8 *output) const
+{
+    return forEachChipBlock(address, length, [this, output](quint16 start, quint32 offset, quint32 count) {
+        const AMemoryChip *chip = chipAt(start);
+        return chip->getRange(start - chip->getBaseAddress(), count, output + offset);
+    });
+}
+
+bool MainMemory::setRange(quint16 address, quint32 length, const quint8 *values)
+{
+    return forEachChipBlock(address, length, [this, values](quint16 start, quint32 offset, quint32 count) {
+        AMemoryChip *chip = chipAt(start);
+        bool retVal = chip->setRange(start - chip->getBaseAddress(), count, values + offset);
+        bytesSet.markRange(start, static_cast<quint16>(start + count - 1));
+        // Don't bother visiting each byte if no one will be notified.
+        if(changeListeners.load(std::memory_order_relaxed)) {
+            for(quint32 it = 0; it < count; it++) {
+                notifyChanged(static_cast<quint16>(start + it), values[offset + it]);
+            }
+        }
+        return retVal;
+    });
+}
+
 void MainMemory::clearMemory()
 {
     // Inform each chip that it needs to be zero'ed out.
@@ -263,8 +360,13 @@ bool MainMemory::writeByte(quint16 address, quint8 value)
     AMemoryChip *chip = chipAt(address);
     try {
         bool retVal = chip->writeByte(address - chip->getBaseAddress(), value);
-        bytesWritten.insert(address);
-        emit changed(address, value);
+        bytesWritten.mark(address);
+        notifyChanged(address, value);
+        // Output is reported by memory rather than by the chip, so that the
+        // hot path does not go through a signal connection.
+        if(chip->getChipType() == AMemoryChip::ChipTypes::ODEV) {
+            onChipOutputWritten(address, value);
+        }
         return retVal;
     } catch (std::range_error& e) {
         error = true;
@@ -299,8 +401,8 @@ bool MainMemory::setByte(quint16 address, quint8 value)
     AMemoryChip *chip = chipAt(address);
     try {
         bool retVal = chip->setByte(address - chip->getBaseAddress(), value);
-        bytesSet.insert(address);
-        emit changed(address, value);
+        bytesSet.mark(address);
+        notifyChanged(address, value);
         return retVal;
     } catch (std::range_error& e) {
         error = true;
@@ -400,8 +502,19 @@ void MainMemory::onChipInputRequested(quint16 address)
         }
         dynamic_cast<InputChip*>(chipAt(address))->onInputReceived(offsetFromBase, first);
     }
+    else if(abortOnMissingInput) {
+        quint16 offsetFromBase = address - chipAt(address)->getBaseAddress();
+        dynamic_cast<InputChip*>(chipAt(address))->onInputAborted(offsetFromBase);
+    }
     else {
         waitingOnInput.insert(address);
+        // Observers may answer the request without a round trip through the event loop.
+        notifyInputRequested(address);
+        quint16 offsetFromBase = address - chipAt(address)->getBaseAddress();
+        if(!dynamic_cast<InputChip*>(chipAt(address))->waitingForInput(offsetFromBase)) {
+            waitingOnInput.remove(address);
+            return;
+        }
         emit inputRequested(address);
         // Make sure the signal is handled by the UI immediately
         QApplication::processEvents();
@@ -410,6 +523,7 @@ void MainMemory::onChipInputRequested(quint16 address)
 
 void MainMemory::onChipOutputWritten(quint16 address, quint8 value)
 {
+    notifyOutputWritten(address, value);
     emit outputWritten(address, value);
 }
 
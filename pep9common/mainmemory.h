@@ -24,6 +24,7 @@
 
 #include <QMap>
 #include <QObject>
+#include <QSet>
 #include <QSharedPointer>
 #include <QVector>
 
@@ -62,6 +63,9 @@ class MainMemory : public AMemoryDevice
     mutable QMap<quint16, QByteArray> inputBuffer;
     // A list of all memory locations that have a pending input request.
     mutable QSet<quint16> waitingOnInput;
+    // If true, a request for input that cannot be served from the input buffer
+    // is aborted immediately, rather than waiting on a response from the UI.
+    bool abortOnMissingInput;
     // Highest accessible address in memory.
     mutable quint32 maxAddr;
 
@@ -71,6 +75,8 @@ public:
 
     // AMemoryDevice interface
     quint32 maxAddress() const noexcept override;
+    // An address is only cachable if the chip containing it is cachable.
+    bool isCachable(quint16 address) const noexcept override;
     void insertChip(QSharedPointer<AMemoryChip> chip, quint16 address);
     // Return the chip containing address. Will return nullptr
     // if the address is out-of-range of the current memory space (e.g. address
@@ -99,9 +105,21 @@ public:
     // performance.
     void autoUpdateMemoryMap(bool update) noexcept;
 
+    // When enabled, reading an input address with an empty input buffer aborts the read
+    // instead of emitting inputRequested(). Needed when the CPU runs on a different thread than
+    // the UI, since the UI would be unable to respond before the read completes.
+    void setAbortOnMissingInput(bool abort) noexcept;
+
     // Copies the bytes from values into main memory starting at address.
     void loadValues(quint16 address, QVector<quint8> values) noexcept;
 
+    // Split the range into one block per chip, and perform a single range
+    // operation on each chip.
+    bool readRange(quint16 address, quint32 length, quint8* output) const override;
+    bool writeRange(quint16 address, quint32 length, const quint8* values) override;
+    bool getRange(quint16 address, quint32 length, quint8* output) const override;
+    bool setRange(quint16 address, quint32 length, const quint8* values) override;
+
 public slots:
     // Set the values in all memory chips to 0, clear all outstanding IO operations.
     void clearMemory() override;
@@ -138,6 +156,13 @@ protected slots:
 
 private:
     void calculateAddressToChip() noexcept;
+    // Invoke func(quint16 address, quint32 offset, quint32 count) for each block
+    // of the range [address, address + length) that is contained by a single chip,
+    // where offset is the distance of the block from the start of the range.
+    // Errors thrown by chips are converted to memory errors, and do not stop the
+    // remaining blocks from being visited.
+    template <typename Func>
+    bool forEachChipBlock(quint16 address, quint32 length, Func func) const;
 };
 
 #endif // MAINMEMORY_H
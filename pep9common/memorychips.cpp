@@ -19,6 +19,7 @@
     You should have received a copy of the GNU General Public License
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include <cstring>
 #include <QApplication>
 
 #include "memorychips.h"
@@ -196,8 +197,11 @@ bool InputChip::readByte(quint16 offsetFromBase, quint8 &output) const
     requestCanceled[offsetFromBase] = false;
     requestAborted[offsetFromBase] = false;
     emit inputRequested(baseAddress + offsetFromBase);
-    // Let the UI handle I/O before returning to this device
-    QApplication::processEvents();
+    // Let the UI handle I/O before returning to this device, unless
+    // the request was already served by the receiver.
+    if(waiting[offsetFromBase]) {
+        QApplication::processEvents();
+    }
     if(requestCanceled[offsetFromBase]) return false;
     else if(requestAborted[offsetFromBase]) {
         memory[offsetFromBase] = errorChar;
@@ -391,6 +395,36 @@ bool RAMChip::setByte(quint16 offsetFromBase, quint8 value)
 }
 
 
+bool RAMChip::readRange(quint16 offsetFromBase, quint32 length, quint8 *output) const
+{
+    return getRange(offsetFromBase, length, output);
+}
+
+bool RAMChip::writeRange(quint16 offsetFromBase, quint32 length, const quint8 *values)
+{
+    return setRange(offsetFromBase, length, values);
+}
+
+bool RAMChip::getRange(quint16 offsetFromBase, quint32 length, quint8 *output) const
+{
+    // If any byte of the get would be out of bounds, throw an error.
+    if(offsetFromBase + length > size) outOfBoundsReadHelper(static_cast<quint16>(qMax<quint32>(offsetFromBase, size)));
+    std::memcpy(output, memory.constData() + offsetFromBase, length);
+    return true;
+}
+
+bool RAMChip::setRange(quint16 offsetFromBase, quint32 length, const quint8 *values)
+{
+    // If any byte of the set would be out of bounds, throw an error.
+    if(offsetFromBase + length > size) {
+        quint32 firstBad = qMax<quint32>(offsetFromBase, size);
+        outOfBoundsWriteHelper(static_cast<quint16>(firstBad), values[firstBad - offsetFromBase]);
+    }
+    std::memcpy(memory.data() + offsetFromBase, values, length);
+    return true;
+}
+
+
 
 ROMChip::ROMChip(quint32 size, quint16 baseAddress, QObject *parent): AMemoryChip (size, baseAddress, parent),
     memory(QVector<quint8>(static_cast<qint32>(size), 0))
@@ -459,3 +493,32 @@ bool ROMChip::setByte(quint16 offsetFromBase, quint8 value)
     return true;
 }
 
+bool ROMChip::readRange(quint16 offsetFromBase, quint32 length, quint8 *output) const
+{
+    return getRange(offsetFromBase, length, output);
+}
+
+bool ROMChip::writeRange(quint16 /*offsetFromBase*/, quint32, const quint8 *)
+{
+    // Don't allow users to change (write to) read only memory.
+    return true;
+}
+
+bool ROMChip::getRange(quint16 offsetFromBase, quint32 length, quint8 *output) const
+{
+    // If any byte of the get would be out of bounds, throw an error.
+    if(offsetFromBase + length > size) outOfBoundsReadHelper(static_cast<quint16>(qMax<quint32>(offsetFromBase, size)));
+    std::memcpy(output, memory.constData() + offsetFromBase, length);
+    return true;
+}
+
+bool ROMChip::setRange(quint16 offsetFromBase, quint32 length, const quint8 *values)
+{
+    // If any byte of the set would be out of bounds, throw an error.
+    if(offsetFromBase + length > size) {
+        quint32 firstBad = qMax<quint32>(offsetFromBase, size);
+        outOfBoundsWriteHelper(static_cast<quint16>(firstBad), values[firstBad - offsetFromBase]);
+    }
+    std::memcpy(memory.data() + offsetFromBase, values, length);
+    return true;
+}
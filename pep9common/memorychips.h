@@ -153,6 +153,11 @@ public:
     bool writeByte(quint16 offsetFromBase, quint8 value) override;
     bool getByte(quint16 offsetFromBase, quint8 &output) const override;
     bool setByte(quint16 offsetFromBase, quint8 value) override;
+    // Copy blocks directly to / from the backing storage.
+    bool readRange(quint16 offsetFromBase, quint32 length, quint8* output) const override;
+    bool writeRange(quint16 offsetFromBase, quint32 length, const quint8* values) override;
+    bool getRange(quint16 offsetFromBase, quint32 length, quint8* output) const override;
+    bool setRange(quint16 offsetFromBase, quint32 length, const quint8* values) override;
 };
 
 /*
@@ -175,6 +180,11 @@ public:
     bool writeByte(quint16 offsetFromBase, quint8 value) override;
     bool getByte(quint16 offsetFromBase, quint8 &output) const override;
     bool setByte(quint16 offsetFromBase, quint8 value) override;
+    // Copy blocks directly to / from the backing storage.
+    bool readRange(quint16 offsetFromBase, quint32 length, quint8* output) const override;
+    bool writeRange(quint16 offsetFromBase, quint32 length, const quint8* values) override;
+    bool getRange(quint16 offsetFromBase, quint32 length, quint8* output) const override;
+    bool setRange(quint16 offsetFromBase, quint32 length, const quint8* values) override;
 };
 
 #endif // MEMORYCHIPS_H
@@ -30,6 +30,7 @@
 #include "mainmemory.h"
 #include "memorydumppane.h"
 #include "pep.h"
+#include "simulationsnapshot.h"
 #include "ui_memorydumppane.h"
 #include <QtAlgorithms>
 #include <QtCore>
@@ -134,6 +135,20 @@ void MemoryDumpPane::refreshMemoryLines(quint16 firstByte, quint16 lastByte)
     // get the line number.
     quint16 firstLine = firstByte / bytesPerLine;
     quint16 lastLine = lastByte / bytesPerLine;
+    // Fetch every in-range byte of the affected lines in a single bulk access,
+    // rather than performing a virtual call for each cell.
+    quint32 firstAddr = static_cast<quint32>(firstLine * bytesPerLine);
+    quint32 lastAddr = qMin(static_cast<quint32>((lastLine + 1) * bytesPerLine - 1), memDevice->maxAddress());
+    QVector<quint8> buffer(firstAddr <= lastAddr ? static_cast<int>(lastAddr - firstAddr + 1) : 0);
+    if(!buffer.isEmpty()) {
+        memDevice->getRange(static_cast<quint16>(firstAddr), static_cast<quint32>(buffer.size()), buffer.data());
+    }
+    renderLines(firstLine, lastLine, firstAddr, lastAddr, buffer.data());
+}
+
+void MemoryDumpPane::renderLines(quint16 firstLine, quint16 lastLine, quint32 firstAddr, quint32 lastAddr,
+                                 const quint8 *buffer)
+{
     quint8 tempData;
     QChar ch;
     QString memoryDumpLine;
@@ -145,9 +160,9 @@ void MemoryDumpPane::refreshMemoryLines(quint16 firstByte, quint16 lastByte)
         memoryDumpLine.clear();
         for(int col = 0; col < bytesPerLine; col++) {
             // Only access memory if it is in range
-            if(quint32(row * bytesPerLine + col) <= memDevice->maxAddress()) {
+            if(quint32(row * bytesPerLine + col) <= lastAddr) {
                 // Use the data in the memory section to set the value in the model.
-                memDevice->getByte(static_cast<quint16>(row * bytesPerLine + col), tempData);
+                tempData = buffer[row * bytesPerLine + col - firstAddr];
                 data->setData(data->index(row, col + 1), QString("%1").arg(tempData, 2, 16, QChar('0')).toUpper());
                 ch = QChar(tempData);
                 if (ch.isPrint()) {
@@ -223,17 +238,15 @@ void MemoryDumpPane::highlight()
         highlightedData.append(pc);
     }
 
-    for(quint16 byte : lastModifiedBytes) {
+    lastModifiedBytes.forEachAddress([this](quint16 byte) {
         highlightByte(byte, colors->arrowColorOn, colors->memoryHighlightChanged);
         highlightedData.append(byte);
-    }
+    });
 
 }
 
 void MemoryDumpPane::updateMemory()
 {
-    QList<quint16> list;
-    QSet<quint16> linesToBeUpdated;
     // Don't clear the memDevice's written / set bytes, since other UI components might
     // need access to them.
     // However, must clear the local cache of modified bytes, or there is the potential to over-highlight.
@@ -241,17 +254,18 @@ void MemoryDumpPane::updateMemory()
     modifiedBytes.unite(memDevice->getBytesSet());
     modifiedBytes.unite(memDevice->getBytesWritten());
     lastModifiedBytes = memDevice->getBytesWritten();
-    list = modifiedBytes.toList();
-    while(!list.isEmpty()) {
-        linesToBeUpdated.insert(list.takeFirst() / bytesPerLine);
-    }
-    list = linesToBeUpdated.toList();
-    std::sort(list.begin(), list.end());
 
-    for(auto x: list) {
-        // Multiply by 8 to convert from line # to address of first byte on a line.
-        refreshMemoryLines(x * bytesPerLine, x * bytesPerLine);
-    }
+    // Dirty ranges are visited in ascending order, so only the most recently
+    // refreshed line may be shared between consecutive ranges.
+    int lastRefreshedLine = -1;
+    modifiedBytes.forEachRange([&](quint16 firstByte, quint16 lastByte) {
+        int firstLine = firstByte / bytesPerLine, lastLine = lastByte / bytesPerLine;
+        if(firstLine <= lastRefreshedLine) firstLine = lastRefreshedLine + 1;
+        if(firstLine > lastLine) return;
+        // Multiply by bytesPerLine to convert from line # to address of first byte on a line.
+        refreshMemoryLines(static_cast<quint16>(firstLine * bytesPerLine), lastByte);
+        lastRefreshedLine = lastLine;
+    });
     ui->tableView->resizeColumnsToContents();
 
 }
@@ -337,11 +351,21 @@ void MemoryDumpPane::onMemoryChanged(quint16 address, quint8)
     // Do not use address+1 or address-1, as an address at the end of a line
     // would incorrectly trigger a refresh of an adjacent line.
     // Refresh memoryLines(...) will work correctly if both start and end addresses are the same.
-    modifiedBytes.insert(address);
+    modifiedBytes.mark(address);
     this->refreshMemoryLines(address, address);
     //ui->tableView->resizeColumnsToContents();
 }
 
+void MemoryDumpPane::onSimulationSnapshot(const SimulationSnapshot &snapshot)
+{
+    // Snapshot blocks cover whole lines, so each block can be rendered without consulting memory.
+    for(const auto& block : snapshot.getMemoryBlocks()) {
+        quint32 lastAddr = block.base + static_cast<quint32>(block.bytes.size()) - 1;
+        renderLines(block.base / bytesPerLine, static_cast<quint16>(lastAddr / bytesPerLine), block.base, lastAddr,
+                    reinterpret_cast<const quint8*>(block.bytes.constData()));
+    }
+}
+
 void MemoryDumpPane::onSimulationStarted()
 {
     inSimulation = true;
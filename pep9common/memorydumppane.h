@@ -29,11 +29,13 @@
 #include <QStyledItemDelegate>
 #include <QWidget>
 #include "colors.h"
+#include "dirtybitmap.h"
 namespace Ui {
     class MemoryDumpPane;
 }
 class MainMemory;
 class ACPUModel;
+class SimulationSnapshot;
 class MemoryDumpDelegate;
 class MemoryDumpPane : public QWidget {
     Q_OBJECT
@@ -114,6 +116,10 @@ public slots:
     // Allow memory lines to be updated whenever an address is changed.
     void onMemoryChanged(quint16 address, quint8 newValue);
 
+    // Render memory published by a CPU running on another thread.
+    // Only the blocks contained in the snapshot are redrawn.
+    void onSimulationSnapshot(const SimulationSnapshot& snapshot);
+
     void onSimulationStarted();
     void onSimulationFinished();
 
@@ -129,7 +135,7 @@ private:
     QList<quint16> highlightedData;
     // This is a list of bytes that are currently highlighted.
 
-    QSet<quint16> modifiedBytes, lastModifiedBytes;
+    DirtyBitmap modifiedBytes, lastModifiedBytes;
     // This is a list of bytes that were modified since the last update. This is cached for a convenient time to update
     // such as when we hit a breakpoint, the program finishes, or the end of the single step.
     // lastModifiedBytes indicates which bytes were written in the last ISA instruction.
@@ -146,6 +152,10 @@ private:
 
     void scrollToByte(quint16 address);
 
+    // Render the lines [firstLine, lastLine], whose bytes in [firstAddr, lastAddr] are stored in buffer.
+    // Bytes after lastAddr are rendered as inaccessible.
+    void renderLines(quint16 firstLine, quint16 lastLine, quint32 firstAddr, quint32 lastAddr, const quint8* buffer);
+
 private slots:
     void scrollToPC();
     void scrollToSP();
@@ -589,6 +589,7 @@ QMap<Enu::EMnemonic, QString> Pep::defaultEnumToMicrocodeInstrSymbol;
 QMap<Enu::EAddrMode, QString> Pep::defaultEnumToMicrocodeAddrSymbol;
 QVector<QString> Pep::instSpecToMicrocodeInstrSymbol;
 QVector<QString> Pep::instSpecToMicrocodeAddrSymbol;
+QAtomicInt Pep::microDecoderTableGeneration;
 QString Pep::defaultStartSymbol;
 void Pep::initMicroDecoderTables()
 {
@@ -636,4 +637,5 @@ void Pep::initMicroDecoderTables()
         instSpecToMicrocodeInstrSymbol[it] = defaultEnumToMicrocodeInstrSymbol[Pep::decodeMnemonic[it]].toLower();
         instSpecToMicrocodeAddrSymbol[it] = defaultEnumToMicrocodeAddrSymbol[Pep::decodeAddrMode[it]];
     }
+    microDecoderTableGeneration.ref();
 }
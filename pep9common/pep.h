@@ -22,6 +22,7 @@
 #ifndef PEP_H
 #define PEP_H
 
+#include <QAtomicInt>
 #include <QColor>
 #include <QMap>
 #include <QString>
@@ -131,6 +132,9 @@ public:
 
     static QVector<QString> instSpecToMicrocodeInstrSymbol;
     static QVector<QString> instSpecToMicrocodeAddrSymbol;
+    // Incremented whenever either of the above tables is changed, so that
+    // decodings cached against the tables can tell that they are stale.
+    static QAtomicInt microDecoderTableGeneration;
     // The default symbol to denote the start of the von-Neumann cycle
     static QString defaultStartSymbol;
     static void initMicroDecoderTables();
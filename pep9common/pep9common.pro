@@ -20,6 +20,7 @@ HEADERS += \
     aboutpep.h \
     acpumodel.h \
     amemorychip.h \
+    alutable.h \
     amemorydevice.h \
     byteconverterbin.h \
     byteconverterchar.h \
@@ -28,6 +29,7 @@ HEADERS += \
     byteconverterinstr.h \
     colors.h \
     enu.h \
+    flatmemory.h \
     inputpane.h \
     interrupthandler.h \
     iowidget.h \
@@ -43,12 +45,18 @@ HEADERS += \
     updatechecker.h \
     registerfile.h \
     darkhelper.h \
+    dirtybitmap.h \
+    yieldpolicy.h \
+    simulationsnapshot.h \
+    simulationworker.h \
+    spscqueue.h \
 
 
 SOURCES += \
     aboutpep.cpp \
     acpumodel.cpp \
     amemorychip.cpp \
+    alutable.cpp \
     amemorydevice.cpp \
     byteconverterbin.cpp \
     byteconverterchar.cpp \
@@ -56,6 +64,8 @@ SOURCES += \
     byteconverterhex.cpp \
     byteconverterinstr.cpp \
     colors.cpp \
+    dirtybitmap.cpp \
+    flatmemory.cpp \
     inputpane.cpp \
     interrupthandler.cpp \
     iowidget.cpp \
@@ -69,6 +79,9 @@ SOURCES += \
     symbolvalue.cpp \
     terminalpane.cpp \
     updatechecker.cpp \
+    yieldpolicy.cpp \
+    simulationsnapshot.cpp \
+    simulationworker.cpp \
     enu.cpp \
     registerfile.cpp
 
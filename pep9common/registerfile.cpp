@@ -22,7 +22,7 @@
 #include "registerfile.h"
 
 RegisterFile::RegisterFile(): registersStart(),
-    registersCurrent(),
+    registersCurrent(), dirtyMask(0),
     statusBitsStart(0),
     statusBitsCurrent(0), irCache(0)
 {
@@ -140,6 +140,7 @@ void RegisterFile::writeRegisterWord(quint8 reg, quint16 val)
     if(reg + 1 <= Enu::maxRegisterNumber) {
         registersCurrent[reg] = static_cast<quint8>(val >> 8);
         registersCurrent[reg + 1] = static_cast<quint8>(val & 0xff);
+        dirtyMask |= 0b11u << reg;
     }
 }
 
@@ -152,6 +153,7 @@ void RegisterFile::writeRegisterByte(quint8 reg, quint8 val)
 {
     if(reg <= Enu::maxRegisterNumber) {
         registersCurrent[reg] = val;
+        dirtyMask |= 1u << reg;
     }
 }
 
@@ -164,6 +166,7 @@ void RegisterFile::clearRegisters()
 {
     registersStart.fill(0);
     registersCurrent.fill(0);
+    dirtyMask = 0;
 }
 
 void RegisterFile::writePCStart(quint16 val)
@@ -172,6 +175,8 @@ void RegisterFile::writePCStart(quint16 val)
     if(reg + 1 < Enu::maxRegisterNumber) {
         registersStart[reg] = static_cast<quint8>(val >> 8);
         registersStart[reg + 1] = static_cast<quint8>(val & 0xff);
+        // The starting PC now differs from the current PC, so the next flatten must copy it.
+        dirtyMask |= 0b11u << reg;
     }
 }
 
@@ -188,13 +193,17 @@ quint8 RegisterFile::getIRCache() const
 void RegisterFile::flattenFile()
 {
     /*
-     * Compilers might complain about this, but this can be optimized more easily to use SIMD
-     * or vector instructions, hopefully making the cost of copying registers neglibible.
-     *
-     * Since the arrays are declared to be the same size using std::array, no need
-     * to verify that both arrays are indeed the same length at runtime.
+     * Bytes that were not written since the last flatten already hold the same value
+     * in both arrays, so visit only the set bits of the dirty mask, lowest first.
      */
-    memcpy(registersStart.data(), registersCurrent.data(), static_cast<std::size_t>(registersStart.size()));
+    quint32 mask = dirtyMask;
+    while(mask != 0) {
+        int reg = qCountTrailingZeroBits(mask);
+        registersStart[static_cast<std::size_t>(reg)] = registersCurrent[static_cast<std::size_t>(reg)];
+        // Clear the lowest set bit.
+        mask &= mask - 1;
+    }
+    dirtyMask = 0;
     statusBitsStart = statusBitsCurrent;
 }
 
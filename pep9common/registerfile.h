@@ -36,6 +36,10 @@ class RegisterFile
     // QVector, but guarantee that both arrays will always have the same number of elements is
     // more valuable.
     std::array<quint8, Enu::maxRegisterNumber + 1> registersStart, registersCurrent;
+    // Bit i is set if byte i of registersCurrent may differ from byte i of registersStart.
+    // An instruction only writes a handful of registers, so flattenFile() copies just those bytes.
+    quint32 dirtyMask;
+    static_assert(Enu::maxRegisterNumber < 32, "Each register byte needs a bit in dirtyMask.");
     // Allocate storage for |'ed together bit flags, and provide a way to cahce the instruction register./
     quint8 statusBitsStart, statusBitsCurrent, irCache;
     // Given a quint8 that contains several status bits, mask out the value of the desired bit.
@@ -104,6 +108,7 @@ public:
     quint8 getIRCache() const;
 
     // Copy all current values to the starting values.
+    // Only the bytes written since the last flatten are copied.
     void flattenFile();
 };
 
@@ -0,0 +1,113 @@
+// File: simulationsnapshot.cpp
+/*
+    The Pep/9 suite of applications (Pep9, Pep9CPU, Pep9Micro) are
+    simulators for the Pep/9 virtual machine, and allow users to
+    create, simulate, and debug across various levels of abstraction.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "simulationsnapshot.h"
+
+#include <algorithm>
+
+#include "acpumodel.h"
+#include "amemorydevice.h"
+#include "dirtybitmap.h"
+
+SimulationSnapshot::SimulationSnapshot() noexcept: instructionCount(0), cycleCount(0),
+    registers(), pcStart(0), statusBits(0), memoryBlocks()
+{
+    registers.fill(0);
+}
+
+void SimulationSnapshot::capture(const ACPUModel &cpu)
+{
+    for(quint8 it = 0; it <= Enu::maxRegisterNumber; it++) {
+        registers[it] = cpu.getCPURegByteCurrent(static_cast<Enu::CPURegisters>(it));
+    }
+    pcStart = cpu.getCPURegWordStart(Enu::CPURegisters::PC);
+    statusBits = 0;
+    for(auto bit : {Enu::STATUS_N, Enu::STATUS_Z, Enu::STATUS_V, Enu::STATUS_C, Enu::STATUS_S}) {
+        if(cpu.getStatusBitCurrent(bit)) statusBits |= 1 << bit;
+    }
+
+    // Widen each dirty range to whole blocks, and merge blocks which then overlap.
+    memoryBlocks.clear();
+    const AMemoryDevice* memory = cpu.getMemoryDevice();
+    quint32 maxAddress = memory->maxAddress();
+    quint32 blockFirst = 0, blockLast = 0;
+    bool inBlock = false;
+    auto emitBlock = [&]() {
+        if(blockFirst > maxAddress) return;
+        blockLast = std::min(blockLast, maxAddress);
+        MemoryBlock block{static_cast<quint16>(blockFirst), QByteArray(static_cast<int>(blockLast - blockFirst + 1), 0)};
+        memory->getRange(block.base, static_cast<quint32>(block.bytes.size()),
+                         reinterpret_cast<quint8*>(block.bytes.data()));
+        memoryBlocks.append(block);
+    };
+    memory->getBytesWritten().forEachRange([&](quint16 first, quint16 last) {
+        quint32 alignedFirst = first - first % blockAlignment;
+        quint32 alignedLast = last - last % blockAlignment + blockAlignment - 1;
+        if(inBlock && alignedFirst <= blockLast + 1) {
+            blockLast = alignedLast;
+            return;
+        }
+        if(inBlock) emitBlock();
+        inBlock = true;
+        blockFirst = alignedFirst;
+        blockLast = alignedLast;
+    });
+    if(inBlock) emitBlock();
+}
+
+quint8 SimulationSnapshot::getRegisterByte(Enu::CPURegisters reg) const noexcept
+{
+    return registers[static_cast<quint8>(reg)];
+}
+
+quint16 SimulationSnapshot::getRegisterWord(Enu::CPURegisters reg) const noexcept
+{
+    quint8 index = static_cast<quint8>(reg);
+    // Words are stored in big endian order, just like in the register file.
+    return static_cast<quint16>(registers[index] << 8 | registers[(index + 1) % registers.size()]);
+}
+
+quint16 SimulationSnapshot::getPCStart() const noexcept
+{
+    return pcStart;
+}
+
+bool SimulationSnapshot::getStatusBit(Enu::EStatusBit bit) const noexcept
+{
+    return statusBits & (1 << bit);
+}
+
+bool SimulationSnapshot::getByte(quint16 address, quint8 &output) const noexcept
+{
+    // Blocks are sorted by base address, so find the last block starting at or before address.
+    auto block = std::upper_bound(memoryBlocks.cbegin(), memoryBlocks.cend(), address,
+                                  [](quint16 addr, const MemoryBlock& blk) {return addr < blk.base;});
+    if(block == memoryBlocks.cbegin()) return false;
+    --block;
+    if(address - block->base >= block->bytes.size()) return false;
+    output = static_cast<quint8>(block->bytes.at(address - block->base));
+    return true;
+}
+
+const QVector<SimulationSnapshot::MemoryBlock> &SimulationSnapshot::getMemoryBlocks() const noexcept
+{
+    return memoryBlocks;
+}
@@ -0,0 +1,77 @@
+// File: simulationsnapshot.h
+/*
+    The Pep/9 suite of applications (Pep9, Pep9CPU, Pep9Micro) are
+    simulators for the Pep/9 virtual machine, and allow users to
+    create, simulate, and debug across various levels of abstraction.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SIMULATIONSNAPSHOT_H
+#define SIMULATIONSNAPSHOT_H
+
+#include <array>
+
+#include <QByteArray>
+#include <QVector>
+#include <QtGlobal>
+
+#include "enu.h"
+
+class ACPUModel;
+
+/*
+ * An immutable copy of the state of a running CPU which is safe to hand to
+ * the UI thread. It contains the current value of every register and status bit,
+ * as well as the contents of every block of memory written since the simulation started.
+ *
+ * Memory blocks are widened to multiples of blockAlignment, so that a block always
+ * covers entire lines of a memory dump.
+ */
+class SimulationSnapshot
+{
+public:
+    struct MemoryBlock {
+        quint16 base;
+        QByteArray bytes;
+    };
+    // Must be at least as large as the maximum number of bytes per line in MemoryDumpPane.
+    static const quint16 blockAlignment = 16;
+
+    SimulationSnapshot() noexcept;
+
+    // Capture the registers & written memory of cpu. Must be called on the thread executing cpu.
+    void capture(const ACPUModel& cpu);
+
+    quint8 getRegisterByte(Enu::CPURegisters reg) const noexcept;
+    quint16 getRegisterWord(Enu::CPURegisters reg) const noexcept;
+    // Value of the program counter at the start of the current instruction.
+    quint16 getPCStart() const noexcept;
+    bool getStatusBit(Enu::EStatusBit bit) const noexcept;
+    // Returns false if the address was not written, in which case output is not modified.
+    bool getByte(quint16 address, quint8& output) const noexcept;
+    const QVector<MemoryBlock>& getMemoryBlocks() const noexcept;
+
+    // Statistics which are not available through ACPUModel are filled in by the caller.
+    quint64 instructionCount, cycleCount;
+
+private:
+    std::array<quint8, Enu::maxRegisterNumber + 1> registers;
+    quint16 pcStart;
+    quint8 statusBits;
+    QVector<MemoryBlock> memoryBlocks;
+};
+
+#endif // SIMULATIONSNAPSHOT_H
@@ -0,0 +1,149 @@
+// File: simulationworker.cpp
+/*
+    The Pep/9 suite of applications (Pep9, Pep9CPU, Pep9Micro) are
+    simulators for the Pep/9 virtual machine, and allow users to
+    create, simulate, and debug across various levels of abstraction.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "simulationworker.h"
+
+#include <QElapsedTimer>
+#include <QtConcurrent>
+
+#include "acpumodel.h"
+#include "yieldpolicy.h"
+
+/*
+ * Instead of processing events, capture a snapshot of the CPU once per refresh interval
+ * and publish it to the UI thread. Runs exclusively on the simulation thread.
+ */
+class SimulationWorker::PublishingYieldPolicy : public AYieldPolicy
+{
+public:
+    PublishingYieldPolicy(const ACPUModel& cpu, SPSCQueue<SimulationSnapshot, 4>& snapshots):
+        hook(), cpu(cpu), snapshots(snapshots), timer()
+    {
+        timer.start();
+    }
+    ~PublishingYieldPolicy() override
+    {
+
+    }
+
+    void yield() override
+    {
+        if(!timer.hasExpired(refreshIntervalMS)) return;
+        timer.restart();
+        SimulationSnapshot snapshot;
+        snapshot.capture(cpu);
+        if(hook) hook(snapshot);
+        // If the UI has fallen behind, drop this snapshot rather than wait.
+        // A later snapshot supersedes it entirely.
+        snapshots.push(snapshot);
+    }
+
+    void reset() override
+    {
+        timer.restart();
+    }
+
+    std::function<void(SimulationSnapshot&)> hook;
+private:
+    const ACPUModel& cpu;
+    SPSCQueue<SimulationSnapshot, 4>& snapshots;
+    QElapsedTimer timer;
+};
+
+SimulationWorker::SimulationWorker(QSharedPointer<ACPUModel> cpu, QObject *parent): QObject(parent),
+    cpu(cpu), publisher(QSharedPointer<PublishingYieldPolicy>::create(*cpu, snapshots)),
+    previousPolicy(nullptr), snapshots(), watcher(), refreshTimer(), running(false)
+{
+    refreshTimer.setInterval(refreshIntervalMS);
+    connect(&refreshTimer, &QTimer::timeout, this, &SimulationWorker::onRefresh);
+    connect(&watcher, &QFutureWatcher<bool>::finished, this, &SimulationWorker::onWorkerFinished);
+}
+
+SimulationWorker::~SimulationWorker()
+{
+    // The simulation thread references the CPU and the snapshot queue,
+    // so it must stop before either is destroyed.
+    if(running) {
+        cpu->requestCancel();
+        waitForFinished();
+    }
+}
+
+void SimulationWorker::setCaptureHook(std::function<void (SimulationSnapshot &)> hook)
+{
+    publisher->hook = hook;
+}
+
+void SimulationWorker::start()
+{
+    if(running) return;
+    running = true;
+    // Discard snapshots left over from a previous run.
+    SimulationSnapshot stale;
+    while(snapshots.pop(stale)) {}
+
+    previousPolicy = cpu->getYieldPolicy();
+    cpu->setYieldPolicy(publisher);
+    publisher->reset();
+    QSharedPointer<ACPUModel> runCPU = cpu;
+    watcher.setFuture(QtConcurrent::run([runCPU]() {
+        return runCPU->onRun();
+    }));
+    refreshTimer.start();
+}
+
+bool SimulationWorker::isRunning() const noexcept
+{
+    return running;
+}
+
+void SimulationWorker::waitForFinished()
+{
+    watcher.waitForFinished();
+    finishRun();
+}
+
+void SimulationWorker::onRefresh()
+{
+    SimulationSnapshot snapshot;
+    bool any = false;
+    // Only the newest snapshot matters, since each contains the complete state of the CPU.
+    while(snapshots.pop(snapshot)) {
+        any = true;
+    }
+    if(any) emit snapshotPublished(snapshot);
+}
+
+void SimulationWorker::onWorkerFinished()
+{
+    finishRun();
+}
+
+void SimulationWorker::finishRun()
+{
+    // The watcher signals completion even if waitForFinished() already handled the run.
+    if(!running) return;
+    running = false;
+    refreshTimer.stop();
+    cpu->setYieldPolicy(previousPolicy);
+    previousPolicy.clear();
+    emit runFinished(watcher.result());
+}
@@ -0,0 +1,98 @@
+// File: simulationworker.h
+/*
+    The Pep/9 suite of applications (Pep9, Pep9CPU, Pep9Micro) are
+    simulators for the Pep/9 virtual machine, and allow users to
+    create, simulate, and debug across various levels of abstraction.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SIMULATIONWORKER_H
+#define SIMULATIONWORKER_H
+
+#include <functional>
+
+#include <QFutureWatcher>
+#include <QObject>
+#include <QSharedPointer>
+#include <QTimer>
+
+#include "simulationsnapshot.h"
+#include "spscqueue.h"
+
+class ACPUModel;
+class AYieldPolicy;
+
+/*
+ * Runs ACPUModel::onRun() on a worker thread, so that the simulator may run at full
+ * speed while the UI remains responsive.
+ *
+ * While running, the simulation thread captures a SimulationSnapshot at the display refresh rate
+ * and publishes it through a lock-free single producer / single consumer queue. The UI thread
+ * drains the queue at the same rate and re-emits the newest snapshot through snapshotPublished().
+ *
+ * Between start() and runFinished(), the CPU and its memory device are owned by the
+ * simulation thread. UI elements must consume snapshots rather than query the CPU.
+ * The only safe ways to affect a running CPU are ACPUModel::requestCancel()
+ * and ACPUModel::requestInterrupt(), followed by waitForFinished().
+ */
+class SimulationWorker : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SimulationWorker(QSharedPointer<ACPUModel> cpu, QObject *parent = nullptr);
+    virtual ~SimulationWorker() override;
+
+    // Add values that are not available through ACPUModel (e.g. statistics) to each snapshot.
+    // The hook is called on the simulation thread.
+    void setCaptureHook(std::function<void(SimulationSnapshot&)> hook);
+
+    // Call onRun() on the worker thread and return immediately.
+    // The simulation must have already been started via onSimulationStarted().
+    void start();
+    // Returns true between start() and the emission of runFinished().
+    bool isRunning() const noexcept;
+    // Block until the simulation thread returns from onRun(). If a run was in progress,
+    // runFinished() is emitted before this method returns.
+    void waitForFinished();
+
+    // Snapshots are published roughly this often.
+    static const int refreshIntervalMS = 16;
+
+signals:
+    // Emitted on the UI thread when the newest published snapshot changes.
+    void snapshotPublished(const SimulationSnapshot& snapshot);
+    // Emitted on the UI thread once onRun() returns, with the value it returned.
+    void runFinished(bool result);
+
+private slots:
+    void onRefresh();
+    void onWorkerFinished();
+
+private:
+    class PublishingYieldPolicy;
+    QSharedPointer<ACPUModel> cpu;
+    QSharedPointer<PublishingYieldPolicy> publisher;
+    // Policy of the CPU before the run began, restored once the run finishes.
+    QSharedPointer<AYieldPolicy> previousPolicy;
+    SPSCQueue<SimulationSnapshot, 4> snapshots;
+    QFutureWatcher<bool> watcher;
+    QTimer refreshTimer;
+    bool running;
+    // Finish the current run on the UI thread. Safe to call more than once.
+    void finishRun();
+};
+
+#endif // SIMULATIONWORKER_H
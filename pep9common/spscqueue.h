@@ -0,0 +1,89 @@
+// File: spscqueue.h
+/*
+    The Pep/9 suite of applications (Pep9, Pep9CPU, Pep9Micro) are
+    simulators for the Pep/9 virtual machine, and allow users to
+    create, simulate, and debug across various levels of abstraction.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/*
+ * A fixed capacity, lock-free ring buffer for exactly one producer thread
+ * and exactly one consumer thread.
+ *
+ * Only the producer may call push(), and only the consumer may call pop().
+ * Neither call ever blocks; push() fails when the queue is full, and pop()
+ * fails when the queue is empty. One slot is always left unused to tell a
+ * full queue apart from an empty one.
+ */
+template <typename T, std::size_t Capacity>
+class SPSCQueue
+{
+    static_assert(Capacity >= 2, "An SPSCQueue must have room for at least one element.");
+public:
+    SPSCQueue() noexcept: head(0), tail(0), slots() {}
+
+    // Copy value into the queue. Returns false if the queue was full.
+    bool push(const T& value)
+    {
+        std::size_t currentTail = tail.load(std::memory_order_relaxed);
+        std::size_t nextTail = increment(currentTail);
+        if(nextTail == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        slots[currentTail] = value;
+        tail.store(nextTail, std::memory_order_release);
+        return true;
+    }
+
+    // Move the oldest value out of the queue. Returns false if the queue was empty.
+    bool pop(T& output)
+    {
+        std::size_t currentHead = head.load(std::memory_order_relaxed);
+        if(currentHead == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        output = std::move(slots[currentHead]);
+        head.store(increment(currentHead), std::memory_order_release);
+        return true;
+    }
+
+    // Only a hint, since the other thread may modify the queue at any moment.
+    bool isEmpty() const noexcept
+    {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+private:
+    static std::size_t increment(std::size_t index) noexcept
+    {
+        return (index + 1) % Capacity;
+    }
+    // Keep the indices on separate cache lines, so that the producer and
+    // consumer do not invalidate each other's caches on every operation.
+    alignas(64) std::atomic<std::size_t> head;
+    alignas(64) std::atomic<std::size_t> tail;
+    std::array<T, Capacity> slots;
+};
+
+#endif // SPSCQUEUE_H
@@ -24,18 +24,11 @@
 #include "symbolentry.h"
 #include "symbolvalue.h"
 
-typedef QAtomicInt SymbolID;
+typedef SymbolTable::SymbolID SymbolID;
 typedef QSharedPointer<SymbolEntry> SymbolEntryPtr;
 typedef QSharedPointer<AbstractSymbolValue> AbstractSymbolValuePtr;
-SymbolID SymbolTable::nextUserSymbolID = 0;
 
-SymbolID SymbolTable::getNextUserSymbolID()
-{
-    QAtomicInt newSymbolID = ++nextUserSymbolID;
-	return newSymbolID;
-}
-
-SymbolTable::SymbolTable():symbolDictionary(), symbolLookup()
+SymbolTable::SymbolTable():entries(), nameSlots(initialNameSlots, NameSlot{0, emptySlot})
 {
 }
 
@@ -45,32 +38,38 @@ SymbolTable::~SymbolTable()
 
 SymbolEntryPtr SymbolTable::getValue(SymbolID symbolID) const
 {
-
-    auto index = symbolDictionary.find(symbolID);
-    if(index == symbolDictionary.end()) return QSharedPointer<SymbolEntry>();
-    return index.value();
+    if(!exists(symbolID)) return QSharedPointer<SymbolEntry>();
+    return entries[symbolID];
 }
 
 SymbolEntryPtr SymbolTable::getValue(const QString & symbolName) const
 {
-    auto index = symbolLookup.find(symbolName);
-    if(index == symbolLookup.end())  return nullptr;
-    return getValue(index.value());
+    SymbolID id = nameSlots[findNameSlot(symbolName, qHash(symbolName))].id;
+    if(id == emptySlot) return nullptr;
+    return entries[id];
 }
 
 SymbolEntryPtr SymbolTable::insertSymbol(const QString & symbolName)
 {
+    uint hash = qHash(symbolName);
+    int slot = findNameSlot(symbolName, hash);
     // We don't want multiple symbols to exists in the same table with the same name.
-    if(exists(symbolName)) return getValue(symbolName);
-	SymbolID id = SymbolTable::getNextUserSymbolID();
-    symbolLookup.insert(symbolName, id);
-    auto val = symbolDictionary.insert(id, QSharedPointer<SymbolEntry>::create(this, id, symbolName));
-	return val.value();
+    if(nameSlots[slot].id != emptySlot) return entries[nameSlots[slot].id];
+    // Keep the load factor at or below one half, so that probe sequences remain short.
+    if(2 * (entries.size() + 1) > nameSlots.size()) {
+        growNameSlots();
+        slot = findNameSlot(symbolName, hash);
+    }
+    SymbolID id = entries.size();
+    SymbolEntryPtr entry = QSharedPointer<SymbolEntry>::create(this, id, symbolName);
+    entries.append(entry);
+    nameSlots[slot] = NameSlot{hash, id};
+    return entry;
 }
 
 SymbolEntryPtr SymbolTable::setValue(SymbolID symbolID, AbstractSymbolValuePtr value)
 {
-    SymbolEntryPtr rval = symbolDictionary[symbolID];
+    SymbolEntryPtr rval = entries[symbolID];
     // If the symbol has already been defined, this function vall constitutes a redefinition.
     if(rval->isDefined()) {
         rval->setMultiplyDefined();
@@ -82,24 +81,28 @@ SymbolEntryPtr SymbolTable::setValue(SymbolID symbolID, AbstractSymbolValuePtr v
 SymbolEntryPtr SymbolTable::setValue(const QString & symbolName, AbstractSymbolValuePtr value)
 {
     // If the table doesn't contain a symbol, create it first.
-    if(!exists(symbolName)) insertSymbol(symbolName);
-    return setValue(symbolLookup.find(symbolName).value(), value);
+    return setValue(insertSymbol(symbolName)->getSymbolID(), value);
 }
 
 bool SymbolTable::exists(const QString& symbolName) const
 {
-    return symbolLookup.find(symbolName) != symbolLookup.end();
+    return nameSlots[findNameSlot(symbolName, qHash(symbolName))].id != emptySlot;
 }
 
 bool SymbolTable::exists(SymbolID symbolID) const
 {
-    return symbolDictionary.find(symbolID) != symbolDictionary.end();
+    return symbolID >= 0 && symbolID < entries.size();
+}
+
+bool SymbolTable::isEmpty() const
+{
+    return entries.isEmpty();
 }
 
 quint32 SymbolTable::numMultiplyDefinedSymbols() const
 {
     quint32 count = 0;
-    for(SymbolTable::SymbolEntryPtr ptr : this->symbolDictionary) {
+    for(const SymbolTable::SymbolEntryPtr& ptr : this->entries) {
         count += ptr->isMultiplyDefined() ? 1 : 0;
     }
     return count;
@@ -108,7 +111,7 @@ quint32 SymbolTable::numMultiplyDefinedSymbols() const
 quint32 SymbolTable::numUndefinedSymbols() const
 {
     quint32 count = 0;
-    for(SymbolTable::SymbolEntryPtr ptr : this->symbolDictionary) {
+    for(const SymbolTable::SymbolEntryPtr& ptr : this->entries) {
         count += ptr->isUndefined() ? 1 : 0;
     }
     return count;
@@ -116,7 +119,7 @@ quint32 SymbolTable::numUndefinedSymbols() const
 
 void SymbolTable::setOffset(quint16 value, quint16 threshhold)
 {
-    for(SymbolEntryPtr ptr:this->symbolDictionary) {
+    for(const SymbolEntryPtr& ptr : this->entries) {
         if(ptr->getRawValue()->getSymbolType() == SymbolType::ADDRESS && ptr->getValue() >= threshhold) {
             static_cast<SymbolValueLocation*>(ptr->getRawValue().data())->setOffset(value);
         }
@@ -129,16 +132,40 @@ void SymbolTable::clearOffset()
     setOffset(0, 0);
 }
 
-QList<SymbolEntryPtr> SymbolTable::getSymbolEntries() const
+const QVector<SymbolEntryPtr> SymbolTable::getSymbolEntries() const
 {
-    return symbolDictionary.values();
+    return entries;
 }
 
-const QMap<SymbolTable::SymbolID, SymbolTable::SymbolEntryPtr> SymbolTable::getSymbolMap() const
+int SymbolTable::findNameSlot(const QString &symbolName, uint hash) const
 {
-    return symbolDictionary;
+    // At least one slot is always empty, so probing terminates.
+    uint mask = static_cast<uint>(nameSlots.size()) - 1;
+    for(uint slot = hash & mask; ; slot = (slot + 1) & mask) {
+        const NameSlot& candidate = nameSlots[static_cast<int>(slot)];
+        if(candidate.id == emptySlot) return static_cast<int>(slot);
+        // Only compare names when the hashes match, since the hash is stored in the slot.
+        else if(candidate.hash == hash && entries[candidate.id]->getName() == symbolName) {
+            return static_cast<int>(slot);
+        }
+    }
 }
 
+void SymbolTable::growNameSlots()
+{
+    QVector<NameSlot> oldSlots(nameSlots.size() * 2, NameSlot{0, emptySlot});
+    oldSlots.swap(nameSlots);
+    uint mask = static_cast<uint>(nameSlots.size()) - 1;
+    for(const NameSlot& oldSlot : oldSlots) {
+        if(oldSlot.id == emptySlot) continue;
+        // Names are unique, so there is no need to compare them while re-inserting.
+        uint slot = oldSlot.hash & mask;
+        while(nameSlots[static_cast<int>(slot)].id != emptySlot) {
+            slot = (slot + 1) & mask;
+        }
+        nameSlots[static_cast<int>(slot)] = oldSlot;
+    }
+}
 
 QString SymbolTable::getSymbolTableListing() const
 {
@@ -147,7 +174,7 @@ QString SymbolTable::getSymbolTableListing() const
     static const QString symTableStr = "Symbol table\n";
     static const QString headerStr = "Symbol    Value        Symbol    Value\n";
     QString build;
-    QList<QSharedPointer<SymbolEntry>> list = getSymbolEntries();
+    QVector<QSharedPointer<SymbolEntry>> list = getSymbolEntries();
     std::sort(list.begin(),list.end(), SymbolAlphabeticComparator);
 
     for(auto it = list.begin(); it != list.end(); ++it) {
@@ -26,6 +26,7 @@
 #include <QMap>
 #include <QMutex>
 #include <QSharedPointer>
+#include <QVector>
 
 class SymbolEntry;
 class AbstractSymbolValue;
@@ -34,22 +35,41 @@ class AbstractSymbolValue;
  * The SymbolTable class provides lookups base on the names and unique identifiers of a group of SymbolEntries.
  * A SymbolEntry is created by calling insertSymbol(...), and can then be looked up by name or by its unique identifier.
  *
+ * Entries are stored contiguously in order of insertion, and a symbol's identifier is its index in that array.
+ * Names are looked up through an open addressing hash table with linear probing, whose slots refer to entries
+ * by identifier. Each name is stored once, in its entry. Since symbols are never removed, slots are never deleted.
+ *
+ * Lookups do not modify the table, so an assembled table may be read from multiple threads.
  */
 class SymbolTable
 {
 public:
     // This type uniquely identifies a SymbolEntry within a symbol table.
     // It is not gaurenteed to be unique across runs or between multiple SymbolTable instances at runtime.
-    typedef QAtomicInt SymbolID;
+    typedef int SymbolID;
     // Convenience typdefs of commonly used templated types to reduce code verbosity.
     typedef QSharedPointer<SymbolEntry> SymbolEntryPtr;
     typedef QSharedPointer<AbstractSymbolValue> AbstractSymbolValuePtr;
 
 private:
-    static SymbolID nextUserSymbolID;
-	static SymbolID getNextUserSymbolID();
-    QMap<SymbolID, SymbolEntryPtr> symbolDictionary;
-    QMap<QString, SymbolID> symbolLookup;
+    // A slot in the name hash table.
+    struct NameSlot {
+        uint hash;
+        SymbolID id;
+    };
+    // ID of a name slot that does not refer to any entry.
+    static const SymbolID emptySlot = -1;
+    // Number of name slots in an empty table. Must be a power of 2.
+    static const int initialNameSlots = 16;
+
+    QVector<SymbolEntryPtr> entries;
+    // Size is always a power of 2, and at most half of the slots are in use.
+    QVector<NameSlot> nameSlots;
+
+    // Return the slot holding symbolName, or the empty slot where it would be inserted.
+    int findNameSlot(const QString& symbolName, uint hash) const;
+    // Double the number of name slots.
+    void growNameSlots();
 
 public:
     explicit SymbolTable();
@@ -68,6 +88,8 @@ public:
     // Check if a symbol exists.
     bool exists(const QString& symbolName) const;
     bool exists(SymbolID symbolID) const;
+    // Returns true if the table contains no symbols.
+    bool isEmpty() const;
     // Get the count of symbols that have definition problems.
 	quint32 numMultiplyDefinedSymbols() const;
 	quint32 numUndefinedSymbols() const;
@@ -76,10 +98,8 @@ public:
     void setOffset(quint16 value, quint16 threshhold = 0);
     // Set the offset of all relocatable symbols to 0.
     void clearOffset();
-    QList<SymbolEntryPtr> getSymbolEntries() const;
-    // Return the map of all symbolic definitions. Used to provide access to iterators
-    // to perform custom operations and comparisions over all symbols.
-    const QMap<SymbolID, SymbolEntryPtr> getSymbolMap() const;
+    // Return all symbols in order of insertion. The entries are shared rather than copied.
+    const QVector<SymbolEntryPtr> getSymbolEntries() const;
 
     QString getSymbolTableListing() const;
 };
@@ -0,0 +1,69 @@
+// File: yieldpolicy.cpp
+/*
+    The Pep/9 suite of applications (Pep9, Pep9CPU, Pep9Micro) are
+    simulators for the Pep/9 virtual machine, and allow users to
+    create, simulate, and debug across various levels of abstraction.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "yieldpolicy.h"
+
+#include <QCoreApplication>
+
+AYieldPolicy::~AYieldPolicy()
+{
+
+}
+
+void AYieldPolicy::reset()
+{
+
+}
+
+NoYieldPolicy::~NoYieldPolicy()
+{
+
+}
+
+void NoYieldPolicy::yield()
+{
+
+}
+
+TimeSlicedYieldPolicy::TimeSlicedYieldPolicy(qint64 sliceMS): sliceMS(sliceMS), timer()
+{
+    timer.start();
+}
+
+TimeSlicedYieldPolicy::~TimeSlicedYieldPolicy()
+{
+
+}
+
+void TimeSlicedYieldPolicy::yield()
+{
+    if(timer.hasExpired(sliceMS)) {
+        QCoreApplication::processEvents();
+        // Restart after processing events, so that time spent in the
+        // event loop is not charged against the next slice.
+        timer.restart();
+    }
+}
+
+void TimeSlicedYieldPolicy::reset()
+{
+    timer.restart();
+}
@@ -0,0 +1,74 @@
+// File: yieldpolicy.h
+/*
+    The Pep/9 suite of applications (Pep9, Pep9CPU, Pep9Micro) are
+    simulators for the Pep/9 virtual machine, and allow users to
+    create, simulate, and debug across various levels of abstraction.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef YIELDPOLICY_H
+#define YIELDPOLICY_H
+
+#include <QElapsedTimer>
+
+/*
+ * Decides when a running simulation gives up control to the event loop.
+ *
+ * A CPU calls yield() every few hundred steps while it is running, so a policy
+ * only pays for its own bookkeeping at that granularity.
+ */
+class AYieldPolicy
+{
+public:
+    virtual ~AYieldPolicy();
+    // Called periodically by the simulation loop.
+    virtual void yield() = 0;
+    // Called when a simulation begins running, so that a policy may reset its state.
+    virtual void reset();
+};
+
+/*
+ * Never yields. Used when there is no event loop waiting on the simulator,
+ * such as in Pep9Term.
+ */
+class NoYieldPolicy : public AYieldPolicy
+{
+public:
+    ~NoYieldPolicy() override;
+    void yield() override;
+};
+
+/*
+ * Processes pending events once every sliceMS milliseconds of simulation,
+ * regardless of how many instructions were executed in that time.
+ * Used by the GUIs, so that responsiveness does not depend on program speed.
+ */
+class TimeSlicedYieldPolicy : public AYieldPolicy
+{
+public:
+    explicit TimeSlicedYieldPolicy(qint64 sliceMS = defaultSliceMS);
+    ~TimeSlicedYieldPolicy() override;
+    void yield() override;
+    void reset() override;
+
+    // Roughly one frame at 60Hz.
+    static const qint64 defaultSliceMS = 16;
+private:
+    qint64 sliceMS;
+    QElapsedTimer timer;
+};
+
+#endif // YIELDPOLICY_H
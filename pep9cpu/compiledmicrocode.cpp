@@ -0,0 +1,81 @@
+// File: compiledmicrocode.cpp
+/*
+    Pep9CPU is a CPU simulator for executing microcode sequences to
+    implement instructions in the instruction set of the Pep/9 computer.
+
+    Copyright (C) 2018  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "compiledmicrocode.h"
+
+#include "microcode.h"
+#include "microcodeprogram.h"
+#include "pep.h"
+#include "symbolentry.h"
+
+CompiledMicrocode::CompiledMicrocode() noexcept: source(), words()
+{
+
+}
+
+CompiledMicrocode::CompiledMicrocode(QSharedPointer<const MicrocodeProgram> program): source(program), words()
+{
+    if(program.isNull()) return;
+    words.reserve(program->codeLength());
+    for(int it = 0; it < program->codeLength(); it++) {
+        words.append(compileLine(*program->getCodeLine(static_cast<quint16>(it))));
+    }
+}
+
+MicroControlWord CompiledMicrocode::compileLine(const MicroCode &line)
+{
+    Q_ASSERT(Pep::numControlSignals() == MicroControl::controlSignalCount);
+    Q_ASSERT(Pep::numClockSignals() == MicroControl::clockSignalCount);
+    MicroControlWord word;
+    const QVector<quint8> control = line.getControlSignals();
+    const QVector<bool> clock = line.getClockSignals();
+    for(int it = 0; it < MicroControl::controlSignalCount; it++) {
+        word.controlSignals[static_cast<std::size_t>(it)] = control[it];
+    }
+    for(int it = 0; it < MicroControl::clockSignalCount; it++) {
+        word.clockSignals[static_cast<std::size_t>(it)] = clock[it];
+    }
+    word.clockMask = MicroControl::clockMaskOf(word.clockSignals);
+    word.branchFunction = line.getBranchFunction();
+    // MicrocodeProgram guarantees that both targets are set,
+    // defaulting to the line itself when there is no explicit target.
+    word.trueTarget = static_cast<quint16>(line.getTrueTarget()->getValue());
+    word.falseTarget = static_cast<quint16>(line.getFalseTarget()->getValue());
+    return word;
+}
+
+CompiledMicrocode CompiledMicrocode::rebind(QSharedPointer<const MicrocodeProgram> program) const
+{
+    CompiledMicrocode other;
+    other.source = program;
+    // QVector is implicitly shared, so the words are not copied.
+    other.words = words;
+    return other;
+}
+
+const MicrocodeProgram *CompiledMicrocode::getSource() const noexcept
+{
+    return source.get();
+}
+
+int CompiledMicrocode::length() const noexcept
+{
+    return words.length();
+}
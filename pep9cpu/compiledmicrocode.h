@@ -0,0 +1,122 @@
+// File: compiledmicrocode.h
+/*
+    Pep9CPU is a CPU simulator for executing microcode sequences to
+    implement instructions in the instruction set of the Pep/9 computer.
+
+    Copyright (C) 2018  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef COMPILEDMICROCODE_H
+#define COMPILEDMICROCODE_H
+
+#include <array>
+
+#include <QSharedPointer>
+#include <QVector>
+
+#include "enu.h"
+class MicroCode;
+class MicrocodeProgram;
+
+namespace MicroControl {
+    // Number of control / clock signals in a control word. Must match the number of
+    // enumerators in Enu::EControlSignals and Enu::EClockSignals.
+    static constexpr int controlSignalCount = Enu::EControlSignals::PValid + 1;
+    static constexpr int clockSignalCount = Enu::EClockSignals::PValidCk + 1;
+    using ControlSignals = std::array<quint8, controlSignalCount>;
+    using ClockSignals = std::array<bool, clockSignalCount>;
+    // One bit per clock signal, set if the clock is asserted.
+    using ClockMask = quint16;
+    static_assert(clockSignalCount <= 16, "Clock signals must fit in a ClockMask");
+
+    constexpr ClockMask clockBit(Enu::EClockSignals clock) noexcept
+    {
+        return static_cast<ClockMask>(1u << clock);
+    }
+    inline ClockMask clockMaskOf(const ClockSignals& clocks) noexcept
+    {
+        ClockMask mask = 0;
+        for(int it = 0; it < clockSignalCount; it++) {
+            if(clocks[static_cast<std::size_t>(it)]) mask |= static_cast<ClockMask>(1u << it);
+        }
+        return mask;
+    }
+
+    // Clocks that latch the value on the C bus (provided that their mux selects it).
+    constexpr ClockMask cBusClocks = clockBit(Enu::LoadCk) | clockBit(Enu::MDRCk)
+            | clockBit(Enu::MDRECk) | clockBit(Enu::MDROCk);
+    // Clocks that latch the status bits computed by the ALU.
+    constexpr ClockMask statusClocks = clockBit(Enu::NCk) | clockBit(Enu::ZCk) | clockBit(Enu::VCk)
+            | clockBit(Enu::CCk) | clockBit(Enu::SCk);
+}
+
+/*
+ * A single line of microcode, lowered into a fixed size record.
+ *
+ * The signals are stored in the same layout used by CPUDataSection, so that
+ * loading a line is a plain copy of two small arrays. Branch targets are the
+ * index of the target line, rather than the symbol naming it.
+ *
+ * The clock mask summarizes which clocks the line asserts, so that the data section
+ * may skip evaluating any part of the datapath whose result would not be clocked in.
+ */
+struct MicroControlWord
+{
+    MicroControl::ControlSignals controlSignals;
+    MicroControl::ClockSignals clockSignals;
+    MicroControl::ClockMask clockMask;
+    Enu::EBranchFunctions branchFunction;
+    quint16 trueTarget, falseTarget;
+};
+
+/*
+ * A MicrocodeProgram lowered into a contiguous array of control words, indexed
+ * by microprogram counter.
+ *
+ * Compilation is done once when a simulation starts, so that each cycle does not copy
+ * the QVectors held by MicroCode, or chase SymbolEntry pointers to find branch targets.
+ * The source program is retained, so that a CPU may cheaply detect that it was given a
+ * new program and must recompile.
+ */
+class CompiledMicrocode
+{
+public:
+    CompiledMicrocode() noexcept;
+    explicit CompiledMicrocode(QSharedPointer<const MicrocodeProgram> program);
+
+    // Lower a single line of microcode into a control word.
+    static MicroControlWord compileLine(const MicroCode& line);
+
+    // Share these control words with program, which must compile to the same words
+    // (e.g. a reassembly of the same microcode text). Nothing is recompiled.
+    CompiledMicrocode rebind(QSharedPointer<const MicrocodeProgram> program) const;
+
+    // The program that these control words were compiled from.
+    const MicrocodeProgram* getSource() const noexcept;
+    int length() const noexcept;
+    // Pre: line < length().
+    inline const MicroControlWord& at(quint16 line) const noexcept;
+
+private:
+    QSharedPointer<const MicrocodeProgram> source;
+    QVector<MicroControlWord> words;
+};
+
+inline const MicroControlWord &CompiledMicrocode::at(quint16 line) const noexcept
+{
+    return words.constData()[line];
+}
+
+#endif // COMPILEDMICROCODE_H
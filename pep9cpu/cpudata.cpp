@@ -19,6 +19,7 @@
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "cpudata.h"
+#include "alutable.h"
 #include "microcode.h"
 #include "microcodeprogram.h"
 #include "amemorydevice.h"
@@ -29,10 +30,12 @@
 #include <registerfile.h>
 CPUDataSection::CPUDataSection(Enu::CPUType type, QSharedPointer<AMemoryDevice> memDev, QObject *parent): QObject(parent), memDevice(memDev),
     cpuFeatures(type), mainBusState(Enu::None),
-    registerBank(QSharedPointer<RegisterFile>::create()), memoryRegisters(6), controlSignals(Pep::numControlSignals()),
-    clockSignals(Pep::numClockSignals()), emitEvents(true), hadDataError(false), errorMessage(""),
+    registerBank(QSharedPointer<RegisterFile>::create()), memoryRegisters(6), controlSignals(),
+    clockSignals(), activeClocks(0), emitEvents(true), hadDataError(false), errorMessage(""),
     isALUCacheValid(false), ALUHasOutputCache(false), ALUOutputCache(0), ALUStatusBitCache(0)
 {
+    clearControlSignals();
+    clearClockSignals();
     presetStaticRegisters();
 }
 
@@ -103,7 +106,7 @@ bool CPUDataSection::calculateALUOutput(quint8 &res, quint8 &NZVC) const
     }
     // This function should not set any errors.
     // Errors will be handled by step(..)
-    quint8 a, b;
+    quint8 a = 0, b = 0;
     bool carryIn = false;
     bool hasA = getAMuxOutput(a), hasB = valueOnBBus(b);
     bool hasCIn = calculateCSMuxOutput(carryIn);
@@ -113,94 +116,24 @@ bool CPUDataSection::calculateALUOutput(quint8 &res, quint8 &NZVC) const
         ALUHasOutputCache = false;
         return ALUHasOutputCache;
     }
-    // Unless otherwise noted, do not return true (sucessfully) early, or the calculation for the NZ bits will be skipped.
-    switch(controlSignals[Enu::ALU]) {
-    case Enu::A_func: // A
-        res = a;
-        break;
-    case Enu::ApB_func: // A plus B
-        res = a + b;
-        NZVC |= Enu::CMask * quint8{res<a||res<b}; // Carry out if result is unsigned less than a or b.
-        // There is a signed overflow iff the high order bits of the input are the same,
-        // and the inputs & output differs in sign.
-        // Shifts in 0's (unsigned chars), so after shift, only high order bit remain.
-        NZVC |= Enu::VMask * ((~(a ^ b) & (a ^ res)) >> 7) ;
-        break;
-    case Enu::ApnBp1_func: // A plus ~B plus 1
-        hasCIn = true;
-        carryIn = 1;
-        [[fallthrough]];
-    case Enu::ApnBpCin_func: // A plus ~B plus Cin
-        // Clang thinks this is a garbage value. It isn't.
-        // Lots of "errors" spawn from this, but this is well-defined behavior.
-        b = ~b;
-        [[fallthrough]];
-    case Enu::ApBpCin_func: // A plus B plus Cin
+    quint8 func = controlSignals[Enu::ALU];
+    switch(func) {
+    case Enu::ApBpCin_func:
+    case Enu::ApnBpCin_func:
+    case Enu::ROLA_func:
+    case Enu::RORA_func:
         // Expected carry in, none was provided, so ALU calculation yeilds a meaningless result
         if (!hasCIn) return false;
-        // Might cause overflow, but overflow is well defined for unsigned ints
-        res = a + b + quint8{carryIn};
-        NZVC |= Enu::CMask * quint8{res<a||res<b}; // Carry out if result is unsigned less than a or b.
-        // There is a signed overflow iff the high order bits of the input are the same,
-        // and the inputs & output differs in sign.
-        // Shifts in 0's (unsigned chars), so after shift, only high order bit remain.
-        NZVC |= Enu::VMask * ((~(a ^ b) & (a ^ res)) >> 7) ;
-        break;
-    case Enu::AandB_func: // A * B
-        res = a & b;
-        break;
-    case Enu::nAandB_func: // ~(A * B)
-        res = ~(a & b);
-        break;
-    case Enu::AorB_func: // A + B
-        res = a | b;
-        break;
-    case Enu::nAorB_func: // ~(A + B)
-        res = ~(a | b);
-        break;
-    case Enu::AxorB_func: // A xor B
-        res = a ^ b;
         break;
-    case Enu::nA_func: // ~A
-        res = ~a;
-        break;
-    case Enu::ASLA_func: // ASL A
-        res = static_cast<quint8>(a<<1);
-        NZVC |= Enu::CMask * ((a & 0x80) >> 7); // Carry out equals the hi order bit
-        NZVC |= Enu::VMask * (((a << 1) ^ a) >>7); // Signed overflow if a<hi> doesn't match a<hi-1>
-        break;
-    case Enu::ROLA_func: // ROL A
-        if (!hasCIn) return false;
-        res = static_cast<quint8>(a<<1 | quint8{carryIn});
-        NZVC |= Enu::CMask * ((a & 0x80) >> 7); // Carry out equals the hi order bit
-        NZVC |= Enu::VMask * (((a << 1) ^a) >>7); // Signed overflow if a<hi> doesn't match a<hi-1>
-        break;
-    case Enu::ASRA_func: // ASR A
-        hasCIn = true;
-        carryIn = a & 128; // RORA and ASRA only differ by how the carryIn is calculated
-        [[fallthrough]];
-    case Enu::RORA_func: // ROR a
-        if (!hasCIn) return false;
-        // A will not be sign extended since it is unsigned.
-        // Widen carryIn so that << yields a meaningful result.
-        res = static_cast<quint8>(a >> 1 | static_cast<quint8>(carryIn) << 7);
-        // Carry out is lowest order bit of a
-        NZVC |= Enu::CMask * (a & 1);
+    default:
+        // If the default has been hit, then an invalid function was selected
+        if(func >= ALU::functionCount) return false;
         break;
-    case Enu::NZVCA_func: // Move A to NZVC
-        res = 0;
-        NZVC |= Enu::NMask & a;
-        NZVC |= Enu::ZMask & a;
-        NZVC |= Enu::VMask & a;
-        NZVC |= Enu::CMask & a;
-        return true; // Must return early to avoid NZ calculation
-    default: // If the default has been hit, then an invalid function was selected
-        return false;
     }
-    // Calculate N, then shift to correct position
-    NZVC |= (res & 0x80) ? Enu::NMask : 0; // Result is negative if high order bit is 1
-    // Calculate Z, then shift to correct position
-    NZVC |= (res == 0) ? Enu::ZMask : 0;
+    // The result and all status bits, including the NZ bits, are precomputed for every input.
+    quint16 entry = ALU::lookup(func, a, b, carryIn);
+    res = ALU::result(entry);
+    NZVC |= ALU::status(entry);
     // Save the result of the ALU calculation
     ALUOutputCache = res;
     ALUStatusBitCache = NZVC;
@@ -353,6 +286,8 @@ void CPUDataSection::onSetMemoryRegister(Enu::EMemoryRegisters reg, quint8 val)
 void CPUDataSection::onSetClock(Enu::EClockSignals clock, bool value)
 {
     clockSignals[clock] = value;
+    if(value) activeClocks |= MicroControl::clockBit(clock);
+    else activeClocks &= ~MicroControl::clockBit(clock);
 }
 
 void CPUDataSection::onSetControlSignal(Enu::EControlSignals control, quint8 value)
@@ -371,11 +306,12 @@ bool CPUDataSection::setSignalsFromMicrocode(const MicroCode *line)
      * to be the most time consuming piece of the simulation. Memcpy yielded a ~30%
      * increase in perfomance.
      */
-    if(controlSignals.length() == line->getControlSignals().length()) {
+    const QVector<quint8> lineControlSignals = line->getControlSignals();
+    if(controlSignals.size() == static_cast<std::size_t>(lineControlSignals.length())) {
         // Memcpy is safe as long as both arrays match in size.
         memcpy(controlSignals.data(),
-               line->getControlSignals().data(),
-               static_cast<std::size_t>(controlSignals.length()));
+               lineControlSignals.data(),
+               controlSignals.size());
     }
     else {
         hadDataError = true;
@@ -385,11 +321,13 @@ bool CPUDataSection::setSignalsFromMicrocode(const MicroCode *line)
     }
 
     // Same verification as described above, except for clock signals.
-    if(clockSignals.length() == line->getClockSignals().length()) {
+    const QVector<bool> lineClockSignals = line->getClockSignals();
+    if(clockSignals.size() == static_cast<std::size_t>(lineClockSignals.length())) {
         // Memcpy is safe as long as both arrays match in size.
         memcpy(clockSignals.data(),
-               line->getClockSignals().data(),
-               static_cast<std::size_t>(clockSignals.length()));
+               lineClockSignals.data(),
+               clockSignals.size() * sizeof(bool));
+        activeClocks = MicroControl::clockMaskOf(clockSignals);
     }
     else {
         hadDataError = true;
@@ -474,16 +412,10 @@ void CPUDataSection::handleMainBusState() noexcept
 void CPUDataSection::stepOneByte() noexcept
 {
     //Update the bus state first, as the rest of the read / write functionality depends on it
-    handleMainBusState();
+    if(mainBusMayChange()) handleMainBusState();
     if(hadErrorOnStep()) return; //If the bus had an error, give up now
 
     isALUCacheValid = false;
-    //Set up all variables needed by stepping calculation
-    Enu::EALUFunc aluFunc = static_cast<Enu::EALUFunc>(controlSignals[Enu::ALU]);
-    quint8 a = 0, b = 0, c = 0, alu = 0, NZVC = 0;
-    bool hasA = valueOnABus(a), hasB = valueOnBBus(b), hasC = valueOnCBus(c), statusBitError = false;
-    bool hasALUOutput = calculateALUOutput(alu,NZVC);
-
     //Handle write to memory
     if(mainBusState == Enu::MemWriteReady) {
         // << upcasts from quint8 to int32, must explicitly narrow.
@@ -492,19 +424,35 @@ void CPUDataSection::stepOneByte() noexcept
         memDevice->writeByte(address, memoryRegisters[Enu::MEM_MDR]);
     }
 
+    // If nothing is clocked, no part of the datapath needs to be evaluated.
+    const MicroControl::ClockMask clocks = activeClocks;
+    if(clocks == 0) return;
+
+    //Set up all variables needed by stepping calculation, skipping
+    //the parts of the datapath that feed no asserted clock.
+    Enu::EALUFunc aluFunc = static_cast<Enu::EALUFunc>(controlSignals[Enu::ALU]);
+    quint8 a = 0, b = 0, c = 0, alu = 0, NZVC = 0;
+    bool hasA = false, hasB = false, hasC = false, statusBitError = false, hasALUOutput = false;
+    if(clocks & MicroControl::clockBit(Enu::MARCk)) {
+        hasA = valueOnABus(a);
+        hasB = valueOnBBus(b);
+    }
+    if(clocks & MicroControl::cBusClocks) hasC = valueOnCBus(c);
+    if(clocks & MicroControl::statusClocks) hasALUOutput = calculateALUOutput(alu, NZVC);
+
     //MARCk
-    if(clockSignals[Enu::MARCk] && hasA && hasB) {
+    if((clocks & MicroControl::clockBit(Enu::MARCk)) && hasA && hasB) {
         onSetMemoryRegister(Enu::MEM_MARA, a);
         onSetMemoryRegister(Enu::MEM_MARB, b);
     }
-    else if(clockSignals[Enu::MARCk]) {//Handle error where no data is present
+    else if(clocks & MicroControl::clockBit(Enu::MARCk)) {//Handle error where no data is present
         hadDataError = true;
         errorMessage = "No values on A & B during MARCk.";
         return;
     }
 
     //LoadCk
-    if(clockSignals[Enu::LoadCk]) {
+    if(clocks & MicroControl::clockBit(Enu::LoadCk)) {
         if(controlSignals[Enu::C] == Enu::signalDisabled) {
             hadDataError = true;
             errorMessage = "No destination register specified for LoadCk.";
@@ -519,7 +467,7 @@ void CPUDataSection::stepOneByte() noexcept
     quint8 value;
 
     //MDRCk
-    if(clockSignals[Enu::MDRCk]) {
+    if(clocks & MicroControl::clockBit(Enu::MDRCk)) {
         switch(controlSignals[Enu::MDRMux]) {
         case 0: //Pick memory
             address = static_cast<quint16>(memoryRegisters[Enu::MEM_MARA]<<8) + memoryRegisters[Enu::MEM_MARB];
@@ -548,13 +496,13 @@ void CPUDataSection::stepOneByte() noexcept
     }
 
     //NCk
-    if(clockSignals[Enu::NCk]) {
+    if(clocks & MicroControl::clockBit(Enu::NCk)) {
         if(aluFunc!=Enu::UNDEFINED_func && hasALUOutput) onSetStatusBit(Enu::STATUS_N,Enu::NMask & NZVC);
         else statusBitError = true;
     }
 
     //ZCk
-    if(clockSignals[Enu::ZCk]) {
+    if(clocks & MicroControl::clockBit(Enu::ZCk)) {
         if(aluFunc!=Enu::UNDEFINED_func && hasALUOutput)
         {
             if(controlSignals[Enu::AndZ] == 0) {
@@ -569,19 +517,19 @@ void CPUDataSection::stepOneByte() noexcept
     }
 
     //VCk
-    if(clockSignals[Enu::VCk]) {
+    if(clocks & MicroControl::clockBit(Enu::VCk)) {
         if(aluFunc != Enu::UNDEFINED_func && hasALUOutput) onSetStatusBit(Enu::STATUS_V,Enu::VMask & NZVC);
         else statusBitError = true;
     }
 
     //CCk
-    if(clockSignals[Enu::CCk]) {
+    if(clocks & MicroControl::clockBit(Enu::CCk)) {
         if(aluFunc!=Enu::UNDEFINED_func && hasALUOutput) onSetStatusBit(Enu::STATUS_C,Enu::CMask & NZVC);
         else statusBitError = true;
     }
 
     //SCk
-    if(clockSignals[Enu::SCk]) {
+    if(clocks & MicroControl::clockBit(Enu::SCk)) {
         if(aluFunc!=Enu::UNDEFINED_func && hasALUOutput) onSetStatusBit(Enu::STATUS_S,Enu::CMask & NZVC);
         else statusBitError = true;
     }
@@ -596,17 +544,10 @@ void CPUDataSection::stepOneByte() noexcept
 void CPUDataSection::stepTwoByte() noexcept
 {
     //Update the bus state first, as the rest of the read / write functionality depends on it
-    handleMainBusState();
+    if(mainBusMayChange()) handleMainBusState();
     if(hadErrorOnStep()) return; //If the bus had an error, give up now
 
     isALUCacheValid = false;
-    // Set up all variables needed by stepping calculation
-    Enu::EALUFunc aluFunc = static_cast<Enu::EALUFunc>(controlSignals[Enu::ALU]);
-    quint8 a = 0, b = 0, c = 0, alu = 0, NZVC = 0, temp = 0;
-    quint16 address;
-    bool memSigError = false, hasA = valueOnABus(a), hasB = valueOnBBus(b), hasC = valueOnCBus(c);
-    bool statusBitError = false, hasALUOutput = calculateALUOutput(alu, NZVC);
-
     // Handle write to memory
     if(mainBusState == Enu::MemWriteReady) {
         // << widens quint8 to int32, must explictly narrow.
@@ -616,8 +557,27 @@ void CPUDataSection::stepTwoByte() noexcept
         memDevice->writeWord(address, memoryRegisters[Enu::MEM_MDRE]*256 + memoryRegisters[Enu::MEM_MDRO]);
     }
 
+    // Many cycles only wait on memory, and clock nothing. In that case,
+    // no part of the datapath needs to be evaluated.
+    const MicroControl::ClockMask clocks = activeClocks;
+    if(clocks == 0) return;
+
+    // Set up all variables needed by stepping calculation, skipping
+    // the parts of the datapath that feed no asserted clock.
+    Enu::EALUFunc aluFunc = static_cast<Enu::EALUFunc>(controlSignals[Enu::ALU]);
+    quint8 a = 0, b = 0, c = 0, alu = 0, NZVC = 0, temp = 0;
+    quint16 address;
+    bool memSigError = false, hasA = false, hasB = false, hasC = false;
+    bool statusBitError = false, hasALUOutput = false;
+    if(clocks & MicroControl::clockBit(Enu::MARCk)) {
+        hasA = valueOnABus(a);
+        hasB = valueOnBBus(b);
+    }
+    if(clocks & MicroControl::cBusClocks) hasC = valueOnCBus(c);
+    if(clocks & MicroControl::statusClocks) hasALUOutput = calculateALUOutput(alu, NZVC);
+
     // MARCk
-    if(clockSignals[Enu::MARCk]) {
+    if(clocks & MicroControl::clockBit(Enu::MARCk)) {
         if(controlSignals[Enu::MARMux] == 0) {
             // If MARMux is 0, route MDRE, MDRO to MARA, MARB
             onSetMemoryRegister(Enu::MEM_MARA, memoryRegisters[Enu::MEM_MDRE]);
@@ -636,7 +596,7 @@ void CPUDataSection::stepTwoByte() noexcept
     }
 
     // LoadCk
-    if(clockSignals[Enu::LoadCk]) {
+    if(clocks & MicroControl::clockBit(Enu::LoadCk)) {
         if(controlSignals[Enu::C] == Enu::signalDisabled) {
             hadDataError = true;
             errorMessage = "No destination register specified for LoadCk.";
@@ -649,7 +609,7 @@ void CPUDataSection::stepTwoByte() noexcept
     }
 
     // MDRECk
-    if(clockSignals[Enu::MDRECk]) {
+    if(clocks & MicroControl::clockBit(Enu::MDRECk)) {
         switch(controlSignals[Enu::MDREMux])
         {
         case 0: // Pick memory
@@ -689,7 +649,7 @@ void CPUDataSection::stepTwoByte() noexcept
     }
 
     //MDRECk
-    if(clockSignals[Enu::MDROCk]) {
+    if(clocks & MicroControl::clockBit(Enu::MDROCk)) {
         switch(controlSignals[Enu::MDROMux])
         {
         case 0: //Pick memory
@@ -730,14 +690,14 @@ void CPUDataSection::stepTwoByte() noexcept
     }
 
     //NCk
-    if(clockSignals[Enu::NCk]) {
+    if(clocks & MicroControl::clockBit(Enu::NCk)) {
         if(aluFunc != Enu::UNDEFINED_func && hasALUOutput) onSetStatusBit(Enu::STATUS_N, Enu::NMask & NZVC);
         else statusBitError = true;
     }
 
     //If no ALU output, don't set flags.
     //ZCk
-    if(clockSignals[Enu::ZCk]) {
+    if(clocks & MicroControl::clockBit(Enu::ZCk)) {
         if(aluFunc != Enu::UNDEFINED_func && hasALUOutput) {
             if(controlSignals[Enu::AndZ] == 0) {
                 onSetStatusBit(Enu::STATUS_Z,Enu::ZMask & NZVC);
@@ -751,19 +711,19 @@ void CPUDataSection::stepTwoByte() noexcept
     }
 
     //VCk
-    if(clockSignals[Enu::VCk]) {
+    if(clocks & MicroControl::clockBit(Enu::VCk)) {
         if(aluFunc != Enu::UNDEFINED_func && hasALUOutput) onSetStatusBit(Enu::STATUS_V, Enu::VMask & NZVC);
         else statusBitError = true;
     }
 
     //CCk
-    if(clockSignals[Enu::CCk]) {
+    if(clocks & MicroControl::clockBit(Enu::CCk)) {
         if(aluFunc != Enu::UNDEFINED_func && hasALUOutput) onSetStatusBit(Enu::STATUS_C, Enu::CMask & NZVC);
         else statusBitError = true;
     }
 
     //SCk
-    if(clockSignals[Enu::SCk]) {
+    if(clocks & MicroControl::clockBit(Enu::SCk)) {
         if(aluFunc != Enu::UNDEFINED_func && hasALUOutput) onSetStatusBit(Enu::STATUS_S, Enu::CMask & NZVC);
         else statusBitError = true;
     }
@@ -792,17 +752,14 @@ void CPUDataSection::presetStaticRegisters() noexcept
 void CPUDataSection::clearControlSignals() noexcept
 {
     //Set all control signals to disabled
-    for(int it = 0; it < controlSignals.length(); it++) {
-        controlSignals[it] = Enu::signalDisabled;
-    }
+    controlSignals.fill(Enu::signalDisabled);
 }
 
 void CPUDataSection::clearClockSignals() noexcept
 {
     //Set all clock signals to low
-    for(int it = 0; it < clockSignals.length(); it++) {
-        clockSignals[it]=false;
-    }
+    clockSignals.fill(false);
+    activeClocks = 0;
 }
 
 void CPUDataSection::clearRegisters() noexcept
@@ -26,6 +26,7 @@
 #include <QVector>
 #include <QException>
 #include <QString>
+#include "compiledmicrocode.h"
 #include "enu.h"
 class AMemoryDevice;
 class InterfaceMCCPU;
@@ -64,6 +65,9 @@ public:
     bool getStatusBit(Enu::EStatusBit) const;
 
     bool setSignalsFromMicrocode(const MicroCode* line);
+    // Load the signals of a precompiled line of microcode. Since the control word
+    // shares the data section's layout, this cannot fail.
+    inline void setSignalsFromControlWord(const MicroControlWord& word) noexcept;
     void setEmitEvents(bool b);
     //Return information about errors on the last step
     bool hadErrorOnStep() const;
@@ -99,8 +103,11 @@ private:
     QVector<quint8> memoryRegisters;
 
     //Control Signals
-    QVector<quint8> controlSignals;
-    QVector<bool> clockSignals;
+    MicroControl::ControlSignals controlSignals;
+    MicroControl::ClockSignals clockSignals;
+    // Mask of the asserted clockSignals. Must be kept in sync with clockSignals,
+    // as stepping only considers the clocks in this mask.
+    MicroControl::ClockMask activeClocks;
 
     //Error handling
     bool hadDataError;
@@ -120,6 +127,8 @@ private:
     void clearErrors() noexcept;
 
     //Simulation stepping logic
+    // The bus state machine can only change state if it is already busy, or a memory signal is asserted.
+    inline bool mainBusMayChange() const noexcept;
     void handleMainBusState() noexcept;
     void stepOneByte() noexcept;
     void stepTwoByte() noexcept;
@@ -144,4 +153,18 @@ signals:
 
 };
 
+inline void CPUDataSection::setSignalsFromControlWord(const MicroControlWord &word) noexcept
+{
+    controlSignals = word.controlSignals;
+    clockSignals = word.clockSignals;
+    activeClocks = word.clockMask;
+}
+
+inline bool CPUDataSection::mainBusMayChange() const noexcept
+{
+    return mainBusState != Enu::None
+            || controlSignals[Enu::MemRead] == 1
+            || controlSignals[Enu::MemWrite] == 1;
+}
+
 #endif // CPUDATASECTION_H
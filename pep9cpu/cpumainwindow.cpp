@@ -54,6 +54,7 @@
 #include "microcodeprogram.h"
 #include "microobjectcodepane.h"
 #include "partialmicrocodedcpu.h"
+#include "simulationworker.h"
 #include "symboltable.h"
 #include "updatechecker.h"
 
@@ -62,7 +63,7 @@ CPUMainWindow::CPUMainWindow(QWidget *parent) :
     ui(new Ui::CPUMainWindow), debugState(DebugState::DISABLED), codeFont(QFont(Pep::codeFont, Pep::codeFontSize)),
     updateChecker(new UpdateChecker()),  isInDarkMode(false),
     memDevice(new MainMemory(nullptr)), controlSection(new PartialMicrocodedCPU(Enu::CPUType::OneByteDataBus, memDevice)),
-    dataSection(controlSection->getDataSection()),
+    dataSection(controlSection->getDataSection()), simulationWorker(new SimulationWorker(controlSection, this)),
     cpuModesGroup(new QActionGroup(this))
 {
     // Initialize the memory subsystem
@@ -132,6 +133,14 @@ CPUMainWindow::CPUMainWindow(QWidget *parent) :
 
 
     connect(this, &CPUMainWindow::simulationStarted, ui->microobjectWidget, &MicroObjectCodePane::onSimulationStarted);
+    // While the CPU runs on the simulation worker, views are refreshed from published snapshots.
+    PartialMicrocodedCPU* cpu = controlSection.get();
+    simulationWorker->setCaptureHook([cpu](SimulationSnapshot& snapshot) {
+        snapshot.cycleCount = cpu->getCycleCounter();
+    });
+    connect(simulationWorker, &SimulationWorker::snapshotPublished, ui->cpuWidget, &CpuPane::onSimulationSnapshot);
+    connect(simulationWorker, &SimulationWorker::snapshotPublished, ui->memoryWidget, &MemoryDumpPane::onSimulationSnapshot);
+    connect(simulationWorker, &SimulationWorker::runFinished, this, &CPUMainWindow::onBackgroundRunFinished);
     // Post finished events to the event queue so that they are processed after simulation updates.
     connect(this, &CPUMainWindow::simulationFinished, ui->microobjectWidget, &MicroObjectCodePane::onSimulationFinished, Qt::QueuedConnection);
     connect(this, &CPUMainWindow::simulationFinished, controlSection.get(), &PartialMicrocodedCPU::onSimulationFinished, Qt::QueuedConnection);
@@ -744,11 +753,9 @@ void CPUMainWindow::on_actionBuild_Run_triggered()
         memDevice->clearBytesSet();
         memDevice->clearBytesWritten();
         controlSection->onSimulationStarted();
-        controlSection->onRun();
-        // Make sure to highlight modified memory addresses to make it clear to the user
-        // what has been modified over the course of execution.
-        highlightActiveLines();
-        connectViewUpdate();
+        // Microprograms never wait on input, so they may always run off of the UI thread.
+        simulationWorker->start();
+        return;
 
     }
     else {
@@ -815,6 +822,12 @@ bool CPUMainWindow::on_actionDebug_Start_Debugging_triggered()
 
 void CPUMainWindow::on_actionDebug_Stop_Debugging_triggered()
 {
+    // Stopping the worker will finish the simulation, which stops debugging.
+    if(simulationWorker->isRunning()) {
+        controlSection->requestCancel();
+        simulationWorker->waitForFinished();
+        return;
+    }
     connectViewUpdate();
     highlightActiveLines();
     debugState = DebugState::DISABLED;
@@ -907,6 +920,9 @@ void CPUMainWindow::on_actionSystem_Two_Byte_triggered()
 
 void CPUMainWindow::onSimulationFinished()
 {
+    // The CPU signals completion from the worker thread before it is done running.
+    // Wait for onBackgroundRunFinished(), which is only called once the worker is idle.
+    if(simulationWorker->isRunning()) return;
     QString errorString;
     on_actionDebug_Stop_Debugging_triggered();
 
@@ -941,6 +957,16 @@ void CPUMainWindow::onSimulationFinished()
     else ui->statusBar->showMessage("Execution finished", 4000);
 }
 
+void CPUMainWindow::onBackgroundRunFinished()
+{
+    // Make sure to highlight modified memory addresses to make it clear to the user
+    // what has been modified over the course of execution.
+    highlightActiveLines();
+    connectViewUpdate();
+    // If somehow the simulation is not finished, then make sure to terminate it.
+    if(debugState != DebugState::DISABLED) onSimulationFinished();
+}
+
 void CPUMainWindow::onDarkModeChanged()
 {
     isInDarkMode = inDarkMode();
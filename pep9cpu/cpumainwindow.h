@@ -45,6 +45,7 @@ class QActionGroup;
 class PartialMicrocodedCPU;
 class CPUDataSection;
 class MainMemory;
+class SimulationWorker;
 
 /*
  * The set of possible states for the debugger.
@@ -86,6 +87,8 @@ private:
     QSharedPointer<MainMemory> memDevice;
     QSharedPointer<PartialMicrocodedCPU> controlSection;
     QSharedPointer<CPUDataSection> dataSection;
+    // Runs the CPU off of the UI thread, since microprograms never wait on the UI.
+    SimulationWorker *simulationWorker;
 
     CPUHelpDialog *helpDialog;
     AboutPep *aboutPepDialog;
@@ -207,6 +210,7 @@ private slots:
 
     //Run events
     void onSimulationFinished();
+    void onBackgroundRunFinished();
 
     // Byte converter
     void slotByteConverterDecEdited(const QString &);
@@ -35,6 +35,7 @@
 #include "pep.h"
 #include "microcode.h"
 #include "cpudata.h"
+#include "simulationsnapshot.h"
 using namespace Enu;
 CpuPane::CpuPane( QWidget *parent) :
         QWidget(parent),
@@ -1027,6 +1028,28 @@ void CpuPane::onSimulationUpdate()
     ui->graphicsView->invalidateScene();
 }
 
+void CpuPane::onSimulationSnapshot(const SimulationSnapshot &snapshot)
+{
+    setRegister(Enu::Acc, snapshot.getRegisterWord(CPURegisters::A));
+    setRegister(Enu::X, snapshot.getRegisterWord(CPURegisters::X));
+    setRegister(Enu::SP, snapshot.getRegisterWord(CPURegisters::SP));
+    setRegister(Enu::PC, snapshot.getRegisterWord(CPURegisters::PC));
+    setRegister(Enu::IR, static_cast<int>(snapshot.getRegisterByte(CPURegisters::IS)<<16) +
+                snapshot.getRegisterWord(CPURegisters::OS));
+    setRegister(Enu::T1, snapshot.getRegisterByte(CPURegisters::T1));
+    setRegister(Enu::T2, snapshot.getRegisterWord(CPURegisters::T2));
+    setRegister(Enu::T3, snapshot.getRegisterWord(CPURegisters::T3));
+    setRegister(Enu::T4, snapshot.getRegisterWord(CPURegisters::T4));
+    setRegister(Enu::T5, snapshot.getRegisterWord(CPURegisters::T5));
+    setRegister(Enu::T6, snapshot.getRegisterWord(CPURegisters::T6));
+    setStatusBit(Enu::N, snapshot.getStatusBit(Enu::STATUS_N));
+    setStatusBit(Enu::Z, snapshot.getStatusBit(Enu::STATUS_Z));
+    setStatusBit(Enu::V, snapshot.getStatusBit(Enu::STATUS_V));
+    setStatusBit(Enu::Cbit, snapshot.getStatusBit(Enu::STATUS_C));
+    setStatusBit(Enu::S, snapshot.getStatusBit(Enu::STATUS_S));
+    ui->graphicsView->invalidateScene();
+}
+
 void CpuPane::onSimulationFinished()
 {
     // Update any registers changed since start.
@@ -35,6 +35,7 @@ namespace Ui {
 }
 class InterfaceMCCPU;
 class CPUDataSection;
+class SimulationSnapshot;
 class CpuPane : public QWidget {
     Q_OBJECT
 public:
@@ -96,6 +97,9 @@ public slots:
     void onStatusBitChanged(Enu::EStatusBit,bool value);
     void repaintOnScroll(int distance);
     void onSimulationUpdate();
+    // Display the registers published by a CPU running on another thread.
+    // Memory registers and control signals are not part of a snapshot, and are left unchanged.
+    void onSimulationSnapshot(const SimulationSnapshot& snapshot);
     void onSimulationFinished();
     void onDarkModeChanged(bool darkMode, QString styleSheet);
     // Instead of passing the type it changed to
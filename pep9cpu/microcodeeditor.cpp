@@ -28,7 +28,8 @@
 #include "interfacemccpu.h"
 #include <QScrollBar>
 
-MicrocodeEditor::MicrocodeEditor(bool highlightCurrentLine, bool isReadOnly, QWidget *parent): QPlainTextEdit(parent), cpu(nullptr), colors(&PepColors::lightMode)
+MicrocodeEditor::MicrocodeEditor(bool highlightCurrentLine, bool isReadOnly, QWidget *parent): QPlainTextEdit(parent), cpu(nullptr), colors(&PepColors::lightMode),
+    lineProfile(), profileTotal(0)
 {
     highlightCurLine = highlightCurrentLine;
 
@@ -61,7 +62,13 @@ int MicrocodeEditor::lineNumberAreaWidth()
 
     int space = 4 + fontMetrics().horizontalAdvance(QLatin1Char('9')) * digits;
 
-    return space + fontMetrics().height();
+    return space + fontMetrics().height() + profileAreaWidth();
+}
+
+int MicrocodeEditor::profileAreaWidth()
+{
+    if(lineProfile.isEmpty()) return 0;
+    return 4 + fontMetrics().horizontalAdvance(QStringLiteral("100.0%"));
 }
 
 void MicrocodeEditor::lineAreaMousePress(QMouseEvent *event)
@@ -325,6 +332,25 @@ const QSet<quint16> MicrocodeEditor::getBreakpoints() const
     return breakpoints;
 }
 
+void MicrocodeEditor::setLineProfile(QVector<quint64> lineCycles)
+{
+    lineProfile = lineCycles;
+    profileTotal = 0;
+    for(quint64 cycles : lineProfile) profileTotal += cycles;
+    // Nothing to annotate if no cycles executed.
+    if(profileTotal == 0) lineProfile.clear();
+    updateLineNumberAreaWidth(0);
+    lineNumberArea->update();
+}
+
+void MicrocodeEditor::clearLineProfile()
+{
+    lineProfile.clear();
+    profileTotal = 0;
+    updateLineNumberAreaWidth(0);
+    lineNumberArea->update();
+}
+
 void MicrocodeEditor::onDarkModeChanged(bool darkMode)
 {
     if(darkMode) colors = &PepColors::darkMode;
@@ -385,6 +411,18 @@ void MicrocodeEditor::lineNumberAreaPaintEvent(QPaintEvent *event)
                 // Undo antialias mode, so as not to accidentally antialias text
                 painter.setRenderHint(QPainter::Antialiasing, antialias);
             }
+            // Between the breakpoint and the line number, show the share of cycles spent on this line.
+            // Cycle numbers start at 1, but microprogram lines start at 0.
+            if(blockToCycle.contains(blockNumber) && blockToCycle[blockNumber] - 1 < lineProfile.size()) {
+                quint64 cycles = lineProfile[blockToCycle[blockNumber] - 1];
+                if(cycles != 0) {
+                    QString share = QString::number(100.0 * cycles / profileTotal, 'f', 1) + "%";
+                    painter.setPen(colors->lineAreaText);
+                    painter.setFont(QFont(Pep::codeFont, Pep::codeFontSize));
+                    painter.drawText(fontMetrics().height(), top, profileAreaWidth(), fontMetrics().height(),
+                                     Qt::AlignRight | Qt::AlignVCenter, share);
+                }
+            }
             // Determine the line number text, or the empty string otherwise
             QString number = !blockToCycle.contains(blockNumber) ? QString("") : QString::number(blockToCycle[blockNumber]);
             painter.setPen(colors->lineAreaText); // grey
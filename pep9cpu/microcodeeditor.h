@@ -51,6 +51,10 @@ public:
     void readSettings(QSettings& settings);
     void writeSettings(QSettings& settings);
     const QSet<quint16> getBreakpoints() const;
+    // Annotate each line of microcode with its share of lineCycles,
+    // which is indexed by microprogram line.
+    void setLineProfile(QVector<quint64> lineCycles);
+    void clearLineProfile();
 public slots:
     void onDarkModeChanged(bool darkMode);
     void onRemoveAllBreakpoints();
@@ -68,8 +72,12 @@ private:
     QMap<int, quint16> blockToCycle;
     QSet<quint16> breakpoints;
     bool highlightCurLine;
+    QVector<quint64> lineProfile;
+    quint64 profileTotal;
 
     int getMicrocodeBlockNumbers();
+    // Width of the cycle share column, or 0 if there is no profile.
+    int profileAreaWidth();
 signals:
     void breakpointAdded(quint16 line);
     void breakpointRemoved(quint16 line);
@@ -336,6 +336,16 @@ void MicrocodePane::clearSimulationView()
     editor->clearSimulationView();
 }
 
+void MicrocodePane::setLineProfile(QVector<quint64> lineCycles)
+{
+    editor->setLineProfile(lineCycles);
+}
+
+void MicrocodePane::clearLineProfile()
+{
+    editor->clearLineProfile();
+}
+
 void MicrocodePane::unCommentSelection()
 {
     editor->unCommentSelection();
@@ -96,6 +96,11 @@ public:
     void updateSimulationView();
     void clearSimulationView();
 
+    void setLineProfile(QVector<quint64> lineCycles);
+    // Post: Each line of microcode is annotated with its share of the cycles in lineCycles.
+    void clearLineProfile();
+    // Post: Line annotations are removed.
+
     void unCommentSelection();
 
     void readSettings(QSettings &settings);
@@ -19,10 +19,12 @@
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "microcodeprogram.h"
+#include <QCryptographicHash>
 #include "microcode.h"
 #include "symbolentry.h"
 #include "symbolvalue.h"
-MicrocodeProgram::MicrocodeProgram(): programVec(), preconditionsVec(), postconditionsVec(), microcodeVec()
+MicrocodeProgram::MicrocodeProgram(): programVec(), preconditionsVec(), postconditionsVec(), microcodeVec(),
+    sourceDigest()
 {
 
 }
@@ -37,7 +39,7 @@ MicrocodeProgram::~MicrocodeProgram()
 
 MicrocodeProgram::MicrocodeProgram(QVector<AMicroCode*>objectCode, QSharedPointer<SymbolTable> symbolTable):
     symTable(symbolTable), programVec(objectCode),
-    preconditionsVec(), postconditionsVec(), microcodeVec()
+    preconditionsVec(), postconditionsVec(), microcodeVec(), sourceDigest()
 {
     AMicroCode* item;
     for(int it=0; it<objectCode.size();it++) {
@@ -81,6 +83,9 @@ MicrocodeProgram::MicrocodeProgram(QVector<AMicroCode*>objectCode, QSharedPointe
             line->setFalseTarget(static_cast<MicroCode*>(programVec[microcodeVec[it]])->getSymbol());
         }
     }
+    // Digest the formatted source once all symbols and branch targets are resolved,
+    // so that simulators may cache work derived from the program.
+    sourceDigest = QCryptographicHash::hash(format().toUtf8(), QCryptographicHash::Sha1);
 }
 
 QSharedPointer<const SymbolTable> MicrocodeProgram::getSymTable() const
@@ -138,3 +143,8 @@ int MicrocodeProgram::codeLength() const
     return microcodeVec.length();
 }
 
+const QByteArray &MicrocodeProgram::getSourceDigest() const
+{
+    return sourceDigest;
+}
+
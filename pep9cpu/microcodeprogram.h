@@ -21,6 +21,7 @@
 #ifndef MICROCODEPROGRAM_H
 #define MICROCODEPROGRAM_H
 #include "enu.h"
+#include <QByteArray>
 #include <QVector>
 class AMicroCode;
 class MicroCode;
@@ -31,6 +32,7 @@ private:
     QSharedPointer<SymbolTable> symTable;
     QVector<AMicroCode*> programVec;
     QVector<int> preconditionsVec,postconditionsVec,microcodeVec;
+    QByteArray sourceDigest;
 public:
     MicrocodeProgram();
     ~MicrocodeProgram();
@@ -44,6 +46,8 @@ public:
     const MicroCode* getCodeLine(quint16 codeLine) const;
     MicroCode* getCodeLine(quint16 codeLine);
     int codeLength() const;
+    // A digest of the program's source text. Programs assembled from the same text have the same digest.
+    const QByteArray& getSourceDigest() const;
 };
 
 #endif // MICROCODEPROGRAM_H
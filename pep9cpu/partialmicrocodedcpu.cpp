@@ -121,6 +121,7 @@ void PartialMicrocodedCPU::onSimulationStarted()
     microBreakpointHit = false;
     memoizer->clear();
     memory->clearErrors();
+    resetYieldPolicy();
     ACPUModel::handler->clearQueuedInterrupts();
 }
 
@@ -254,6 +255,9 @@ void PartialMicrocodedCPU::onMCStep()
 
     }
 
+    // Give the event loop a chance to run, and honor external cancellation.
+    pollYield();
+
     // Upon entering an instruction that is going to trap
     // If running in debug mode, first check if this line has any microcode breakpoints.
     if(inDebug && sharedProgram->getCodeLine(microprogramCounter)->hasBreakpoint()) {
@@ -11,6 +11,7 @@ FORMS += \
     microobjectcodepane.ui \
 
 HEADERS += \
+    compiledmicrocode.h \
     cpudata.h \
     cpupane.h \
     cpugraphicsitems.h \
@@ -32,6 +33,7 @@ HEADERS += \
     tristatelabel.h \
 
 SOURCES += \
+    compiledmicrocode.cpp \
     cpudata.cpp \
     cpupane.cpp \
     cpugraphicsitems.cpp \
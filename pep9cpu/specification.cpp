@@ -19,6 +19,8 @@
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <QVector>
+
 #include "specification.h"
 #include "cpudata.h"
 #include "amemorydevice.h"
@@ -37,13 +39,16 @@ void MemSpecification::setUnitPre(CPUDataSection *, AMemoryDevice *memDevice) no
         memDevice->setByte(static_cast<quint16>(memAddress), static_cast<quint8>(memValue));
     }
     else {
+        QVector<quint8> bytes(numBytes);
         int temp = memValue;
         for(int it = numBytes-1; it >= 0; it--) {
             // Treat the low order byte of temp as the value at it
-            memDevice->setByte(static_cast<quint16>(memAddress + it), static_cast<quint8>(temp & 0xff));
+            bytes[it] = static_cast<quint8>(temp & 0xff);
             // Perform a logical shift left by 8.
             temp /= 256;
         }
+        // Store all bytes of the value in a single bulk access.
+        memDevice->setRange(static_cast<quint16>(memAddress), static_cast<quint32>(numBytes), bytes.constData());
     }
 }
 
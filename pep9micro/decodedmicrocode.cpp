@@ -0,0 +1,127 @@
+// File: decodedmicrocode.cpp
+/*
+    Pep9Micro is a complete CPU simulator for the Pep/9 instruction set,
+    and is capable of assembling programs to object code, executing
+    object code programs, and executing microcode fragments.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "decodedmicrocode.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QQueue>
+
+#include "microcodeprogram.h"
+#include "pep.h"
+#include "symbolentry.h"
+#include "symboltable.h"
+
+namespace {
+    // Build a decoder table by looking up the symbol named by symbols[instrSpec] for every instruction specifier.
+    std::array<DecodedMicrocode::decoder_entry, 256> buildJT(const SymbolTable& symTable, const QVector<QString>& symbols)
+    {
+        std::array<DecodedMicrocode::decoder_entry, 256> table;
+        QSharedPointer<SymbolEntry> val;
+        DecodedMicrocode::decoder_entry entry;
+        for(int it = 0; it <= 255; ++it) {
+            val = symTable.getValue(symbols[it]);
+            // Instead of causing an error before execution starts,
+            // flag the entry as invalid so that the error can be caught at runtime.
+            // This allows microprogram fragments that do not define all instructions
+            // to be created, which is of instructional value to students
+            if(val == nullptr || !val->isDefined()) {
+                entry.isValid = false;
+                entry.addr = 0;
+            }
+            else {
+                entry.isValid = true;
+                entry.addr = static_cast<quint16>(val->getValue());
+            }
+            table[static_cast<quint8>(it)] = entry;
+        }
+        return table;
+    }
+
+    struct decode_cache {
+        QMutex mutex;
+        // Keyed by the digest of the microcode text.
+        QHash<QByteArray, QSharedPointer<const DecodedMicrocode>> entries;
+        // Keys in order of insertion, so that the oldest decoding is evicted first.
+        QQueue<QByteArray> order;
+        // Decoder table generation that every entry was decoded against.
+        int generation = 0;
+    };
+
+    decode_cache& cache()
+    {
+        static decode_cache instance;
+        return instance;
+    }
+}
+
+DecodedMicrocode::DecodedMicrocode(QSharedPointer<const MicrocodeProgram> program):
+    // Don't let a cached decoding keep the program it was decoded from alive.
+    compiled(CompiledMicrocode(program).rebind(QSharedPointer<const MicrocodeProgram>())),
+    startLine(0), instrSpecJT(), addrModeJT()
+{
+    QSharedPointer<const SymbolTable> symTable = program->getSymTable();
+    // Without a start symbol, execution begins at the first line of microcode.
+    if(symTable->exists(Pep::defaultStartSymbol)) {
+        startLine = static_cast<quint16>(symTable->getValue(Pep::defaultStartSymbol)->getValue());
+    }
+    // This calculation is redone whenever the decoder tables change, since
+    // the cached decodings are discarded then.
+    instrSpecJT = buildJT(*symTable, Pep::instSpecToMicrocodeInstrSymbol);
+    addrModeJT = buildJT(*symTable, Pep::instSpecToMicrocodeAddrSymbol);
+}
+
+QSharedPointer<const DecodedMicrocode> DecodedMicrocode::decode(QSharedPointer<const MicrocodeProgram> program)
+{
+    // Programs that were not assembled from text have no digest, and can't be cached.
+    if(program->getSourceDigest().isEmpty()) {
+        return QSharedPointer<const DecodedMicrocode>(new DecodedMicrocode(program));
+    }
+    int generation = Pep::microDecoderTableGeneration.load();
+    QByteArray key = program->getSourceDigest();
+    decode_cache& shared = cache();
+    QMutexLocker lock(&shared.mutex);
+    // Decodings made against older decoder tables can never be used again.
+    if(shared.generation != generation) {
+        shared.entries.clear();
+        shared.order.clear();
+        shared.generation = generation;
+    }
+    auto it = shared.entries.constFind(key);
+    if(it != shared.entries.constEnd()) return *it;
+
+    QSharedPointer<const DecodedMicrocode> decoded(new DecodedMicrocode(program));
+    if(shared.order.size() >= cacheSize) {
+        shared.entries.remove(shared.order.dequeue());
+    }
+    shared.entries.insert(key, decoded);
+    shared.order.enqueue(key);
+    return decoded;
+}
+
+void DecodedMicrocode::clearCache()
+{
+    decode_cache& shared = cache();
+    QMutexLocker lock(&shared.mutex);
+    shared.entries.clear();
+    shared.order.clear();
+}
@@ -0,0 +1,74 @@
+// File: decodedmicrocode.h
+/*
+    Pep9Micro is a complete CPU simulator for the Pep/9 instruction set,
+    and is capable of assembling programs to object code, executing
+    object code programs, and executing microcode fragments.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef DECODEDMICROCODE_H
+#define DECODEDMICROCODE_H
+
+#include <array>
+
+#include <QSharedPointer>
+
+#include "compiledmicrocode.h"
+
+class MicrocodeProgram;
+
+/*
+ * A microprogram prepared for execution by FullMicrocodedCPU: the control words,
+ * the first line of the von Neumann cycle, and the jump tables used by the
+ * instruction specifier and addressing mode decoders.
+ *
+ * Building the jump tables takes 512 string-keyed symbol lookups, so decoded
+ * programs are cached. The cache key is the digest of the microcode text and
+ * Pep::microDecoderTableGeneration, which changes whenever the decoder symbols in
+ * Pep::instSpecToMicrocodeInstrSymbol / instSpecToMicrocodeAddrSymbol are edited.
+ * Reassembling unchanged microcode therefore reuses the earlier decoding.
+ */
+class DecodedMicrocode
+{
+public:
+    // A single item in the instruction specifier or addressing mode decoder.
+    struct decoder_entry {
+        quint16 addr;
+        bool isValid;
+    };
+
+    // Return the decoding of program, reusing a cached decoding if possible.
+    // Safe to call from multiple threads.
+    static QSharedPointer<const DecodedMicrocode> decode(QSharedPointer<const MicrocodeProgram> program);
+    // Discard all cached decodings.
+    static void clearCache();
+
+    // Control words, which are not bound to any program.
+    // Use CompiledMicrocode::rebind() to bind them to the program being run.
+    CompiledMicrocode compiled;
+    quint16 startLine;
+    // For each instruction specifier, the first line of microcode implementing the instruction.
+    std::array<decoder_entry, 256> instrSpecJT;
+    // For each instruction specifier, the first line of microcode implementing its addressing mode.
+    std::array<decoder_entry, 256> addrModeJT;
+
+private:
+    explicit DecodedMicrocode(QSharedPointer<const MicrocodeProgram> program);
+    // Maximum number of decodings retained by the cache.
+    static const int cacheSize = 8;
+};
+
+#endif // DECODEDMICROCODE_H
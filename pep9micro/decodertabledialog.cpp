@@ -126,4 +126,5 @@ void DecoderTableDelegate::setModelData(QWidget *editor, QAbstractItemModel *mod
     else if(index.column() == 2){
         Pep::instSpecToMicrocodeAddrSymbol[index.row()] = index.data().toString();
     }
+    Pep::microDecoderTableGeneration.ref();
 }
@@ -36,7 +36,8 @@
 #include "symbolentry.h"
 FullMicrocodedCPU::FullMicrocodedCPU(const AsmProgramManager* manager, QSharedPointer<AMemoryDevice> memoryDev, QObject* parent) noexcept: ACPUModel (memoryDev, parent),
     InterfaceMCCPU(Enu::CPUType::TwoByteDataBus),
-    InterfaceISACPU(memoryDev.get(), manager), memoizer(new FullMicrocodedMemoizer(*this))
+    InterfaceISACPU(memoryDev.get(), manager), memoizer(new FullMicrocodedMemoizer(*this)),
+    blockFusion(false), fusedBlocks(), profiling(false), profilingRequested(false), profiler()
 {
     data = new CPUDataSection(Enu::CPUType::TwoByteDataBus, memoryDev, parent);
     dataShared = QSharedPointer<CPUDataSection>(data);
@@ -71,6 +72,31 @@ void FullMicrocodedCPU::setMicroPCToStart() noexcept
     microprogramCounter = startLine;
 }
 
+void FullMicrocodedCPU::setBlockFusion(bool fuse) noexcept
+{
+    blockFusion = fuse;
+}
+
+bool FullMicrocodedCPU::getBlockFusion() const noexcept
+{
+    return blockFusion;
+}
+
+void FullMicrocodedCPU::setProfiling(bool profile) noexcept
+{
+    profilingRequested = profile;
+}
+
+bool FullMicrocodedCPU::getProfiling() const noexcept
+{
+    return profiling;
+}
+
+const MicrocodeProfiler &FullMicrocodedCPU::getProfiler() const noexcept
+{
+    return profiler;
+}
+
 bool FullMicrocodedCPU::getStatusBitCurrent(Enu::EStatusBit bit) const
 {
     return data->getRegisterBank().readStatusBitCurrent(bit);
@@ -136,15 +162,12 @@ void FullMicrocodedCPU::onSimulationStarted()
     executionFinished = false;
     microBreakpointHit = false;
     asmBreakpointHit = false;
-    if(sharedProgram->getSymTable()->exists(Pep::defaultStartSymbol)) {
-        startLine = static_cast<quint16>(sharedProgram->getSymTable()->getValue(Pep::defaultStartSymbol)->getValue());
-    } else {
-        qDebug() << "Default start symbol did not exists: " << Pep::defaultStartSymbol;
-        startLine = 0;
-    }
     memoizer->clear();
-    calculateInstrJT();
-    calculateAddrJT();
+    resetYieldPolicy();
+    loadProgram();
+    profiling = profilingRequested;
+    // Don't keep counters around when they will not be used.
+    profiler.reset(profiling ? compiledProgram.length() : 0);
     ACPUModel::handler->clearQueuedInterrupts();
 }
 
@@ -241,6 +264,9 @@ void FullMicrocodedCPU::onResetCPU()
     data->onClearCPU();
     ACPUModel::memory->clearErrors();
     memoizer->clear();
+    fusedBlocks.clear();
+    profiling = profilingRequested;
+    profiler.reset(profiling ? compiledProgram.length() : 0);
     InterfaceMCCPU::reset();
     InterfaceISACPU::reset();
     inSimulation = false;
@@ -266,35 +292,43 @@ void FullMicrocodedCPU::onMCStep()
         // Also, must initialize InterfaceISACPU:opValCache here for FullMicrocoded CPU
         // to fulfill its contract with InterfaceISACPU.
         memoizer->storeStateInstrStart();
+        if(profiling) {
+            profiler.onInstructionStart(getCPURegWordStart(Enu::CPURegisters::PC),
+                                        data->getRegisterBank().getIRCache());
+        }
         memory->onCycleStarted();
         InterfaceISACPU::calculateStackChangeStart(this->getCPURegByteStart(Enu::CPURegisters::IS));
     }
 
     // Do step logic
-    const MicroCode* prog = sharedProgram->getCodeLine(microprogramCounter);
-
-    this->setSignalsFromMicrocode(prog);
-    try {
-        data->setSignalsFromMicrocode(prog);
+    // The program may have been replaced without starting a new simulation.
+    if(compiledProgram.getSource() != sharedProgram.get()) {
+        loadProgram();
+        if(profiling) profiler.reset(compiledProgram.length());
     }
-    /*
-     * An invalid_argument execption will be thrown if data's memcpy would fail.
-     * By catching this exception, we convert a hard failure to a friendly error message
-     * for the user application. Any other exceptions should crash the program, because
-     * we do not expect other issues to arise from memcpy.
-     *
-     * Since exceptions are zero-cost during error-free execution, and failing to set microcode
-     * signals would be irreparable, the decisions to communicate failure through execptions
-     * was made as a perfomance decision.
-     */
-    catch (std::invalid_argument &) {
+    if(microprogramCounter >= compiledProgram.length()) {
+        executionFinished = true;
+        controlError = true;
+        errorMessage = "ERROR: µPC is past the end of the microprogram.";
         return;
     }
+    // Fused blocks never check microcode breakpoints, so they may only be used while not debugging.
+    if(blockFusion && !inDebug) {
+        executeFusedBlock();
+    }
+    else {
+        const MicroControlWord& word = compiledProgram.at(microprogramCounter);
 
-    // Step inside the data section, then hnalde updating microprogram counter.
-    data->onStep();
-    branchHandler();
-    microCycleCounter++;
+        this->setSignalsFromControlWord(word);
+        // Control words share the data section's signal layout, so loading them cannot fail.
+        data->setSignalsFromControlWord(word);
+
+        // Step inside the data section, then hnalde updating microprogram counter.
+        data->onStep();
+        if(profiling) profiler.onCycle(microprogramCounter);
+        branchHandler();
+        microCycleCounter++;
+    }
 
     // If we just finished an entire ISA level instruction, perform additional
     // simulation logic needed to mantain ISA level state.
@@ -320,13 +354,10 @@ void FullMicrocodedCPU::onMCStep()
 
     }
 
-    // Modulus must be greater than 1, or there will be no gaurentee of forward progress.
-    // If modulus were 1, then debug debug breakpoints that were signaled externally
-    // during process events would never be cleared by branch handler.
-    if(microCycleCounter % 5000 == 0) {
-        QApplication::processEvents();
+    // Give the event loop a chance to run, and honor external cancellation.
+    if(pollYield()) {
         if(inDebug && (microBreakpointHit || asmBreakpointHit)) {
-            // If a breakpoint was forced on us by the processEvents(), react to it now.
+            // If a breakpoint was forced on us while yielding, react to it now.
             // Clear breakpoint flags, otherwise we might get stuck
             // reacting to this breakpoint forever.
             return;
@@ -349,6 +380,68 @@ void FullMicrocodedCPU::onMCStep()
     ACPUModel::handler->handleQueuedInterrupts();
 }
 
+const FullMicrocodedCPU::fused_block &FullMicrocodedCPU::fusedBlockAt(quint16 line, quint8 instrSpec)
+{
+    quint32 key = static_cast<quint32>(line) << 8 | instrSpec;
+    auto it = fusedBlocks.find(key);
+    if(it != fusedBlocks.end()) return *it;
+
+    fused_block block;
+    // Once a line clocks a new value into the IS, branches that decode the
+    // IS can no longer be resolved using the IS at entry.
+    bool instrSpecKnown = true;
+    quint16 current = line;
+    while(true) {
+        block.lines.append(current);
+        const MicroControlWord& word = compiledProgram.at(current);
+        if(word.clockSignals[Enu::LoadCk] && word.controlSignals[Enu::C] == static_cast<quint8>(Enu::CPURegisters::IS)) {
+            instrSpecKnown = false;
+        }
+        quint16 next;
+        if(word.branchFunction == Enu::Unconditional) {
+            next = word.trueTarget;
+        }
+        else if(word.branchFunction == Enu::IsUnary && instrSpecKnown) {
+            Enu::EMnemonic mnemon = Pep::decodeMnemonic.at(instrSpec);
+            next = Pep::isUnaryMap.value(mnemon) || Pep::isTrapMap.value(mnemon) ? word.trueTarget : word.falseTarget;
+        }
+        else if(word.branchFunction == Enu::AddressingModeDecoder && instrSpecKnown
+                && addrModeJT[instrSpec].isValid) {
+            next = addrModeJT[instrSpec].addr;
+        }
+        else if(word.branchFunction == Enu::InstructionSpecifierDecoder && instrSpecKnown
+                && instrSpecJT[instrSpec].isValid) {
+            next = instrSpecJT[instrSpec].addr;
+        }
+        // Branches on data, stops, and decoding errors are resolved by branchHandler().
+        else break;
+        // End blocks on instruction boundaries, so that ISA level bookkeeping happens
+        // between instructions. Let branchHandler() report invalid targets, and
+        // do not unroll loops.
+        if(next == startLine || next >= compiledProgram.length() || block.lines.contains(next)) break;
+        current = next;
+    }
+    return *fusedBlocks.insert(key, block);
+}
+
+void FullMicrocodedCPU::executeFusedBlock()
+{
+    const fused_block& block = fusedBlockAt(microprogramCounter,
+                                            data->getRegisterBankByte(Enu::CPURegisters::IS));
+    for(quint16 line : block.lines) {
+        microprogramCounter = line;
+        const MicroControlWord& word = compiledProgram.at(line);
+        this->setSignalsFromControlWord(word);
+        data->setSignalsFromControlWord(word);
+        data->onStep();
+        if(profiling) profiler.onCycle(line);
+        microCycleCounter++;
+        // Leave the µPC on the failing line, and let branchHandler() finish execution.
+        if(hadErrorOnStep()) break;
+    }
+    branchHandler();
+}
+
 void FullMicrocodedCPU::onClock()
 {
     //Do clock logic
@@ -404,8 +497,8 @@ bool FullMicrocodedCPU::canStepInto() const
 {
     quint8 byte;
     memory->getByte(getCPURegWordStart(Enu::CPURegisters::PC), byte);
-    Enu::EMnemonic mnemon = Pep::decodeMnemonic[byte];
-    return (mnemon == Enu::EMnemonic::CALL) || Pep::isTrapMap[mnemon];
+    Enu::EMnemonic mnemon = Pep::decodeMnemonic.at(byte);
+    return (mnemon == Enu::EMnemonic::CALL) || Pep::isTrapMap.value(mnemon);
 }
 
 void FullMicrocodedCPU::stepInto()
@@ -444,119 +537,124 @@ const QVector<quint32> FullMicrocodedCPU::getInstructionHistogram()
     return memoizer->getInstructionHistogram();
 }
 
+const QVector<quint64> FullMicrocodedCPU::getInstructionCycleHistogram()
+{
+    if(!profiling) return InterfaceISACPU::getInstructionCycleHistogram();
+    return profiler.getInstructionCycles();
+}
+
 void FullMicrocodedCPU::branchHandler()
 {
     // If execution is already finished, then nothing to update.
     if(executionFinished) return;
     else if(hadErrorOnStep()) executionFinished = true;
-    const MicroCode* prog = sharedProgram->getCodeLine(microprogramCounter);
+    const MicroControlWord& word = compiledProgram.at(microprogramCounter);
     int temp = microprogramCounter;
     quint8 byte = 0;
     QString tempString;
-    QSharedPointer<const SymbolTable> symTable = this->sharedProgram->getSymTable();
     QSharedPointer<SymbolEntry> val;
-    switch(prog->getBranchFunction())
+    switch(word.branchFunction)
     {
     case Enu::Unconditional:
-        temp = prog->getTrueTarget()->getValue();
+        temp = word.trueTarget;
         break;
     case Enu::uBRGT:
         if((!data->getStatusBit(Enu::STATUS_N) && !data->getStatusBit(Enu::STATUS_Z))) {
-            temp = prog->getTrueTarget()->getValue();
+            temp = word.trueTarget;
         }
         else {
-            temp = prog->getFalseTarget()->getValue();
+            temp = word.falseTarget;
         }
         break;
     case Enu::uBRGE:
         if((!data->getStatusBit(Enu::STATUS_N))) {
-            temp = prog->getTrueTarget()->getValue();
+            temp = word.trueTarget;
         }
         else {
-            temp = prog->getFalseTarget()->getValue();
+            temp = word.falseTarget;
         }
         break;
     case Enu::uBREQ:
         if(data->getStatusBit(Enu::STATUS_Z)) {
-            temp = prog->getTrueTarget()->getValue();
+            temp = word.trueTarget;
         }
         else {
-            temp = prog->getFalseTarget()->getValue();
+            temp = word.falseTarget;
         }
         break;
     case Enu::uBRLE:
         if(data->getStatusBit(Enu::STATUS_N) || data->getStatusBit(Enu::STATUS_Z)) {
-            temp = prog->getTrueTarget()->getValue();
+            temp = word.trueTarget;
         }
         else {
-            temp = prog->getFalseTarget()->getValue();
+            temp = word.falseTarget;
         }
         break;
     case Enu::uBRLT:
         if(data->getStatusBit(Enu::STATUS_N)) {
-            temp = prog->getTrueTarget()->getValue();
+            temp = word.trueTarget;
         }
         else {
-            temp = prog->getFalseTarget()->getValue();
+            temp = word.falseTarget;
         }
         break;
     case Enu::uBRNE:
         if((!data->getStatusBit(Enu::STATUS_Z))) {
-            temp = prog->getTrueTarget()->getValue();
+            temp = word.trueTarget;
         }
         else {
-            temp = prog->getFalseTarget()->getValue();
+            temp = word.falseTarget;
         }
         break;
     case Enu::uBRV:
         if(data->getStatusBit(Enu::STATUS_V)) {
-            temp = prog->getTrueTarget()->getValue();
+            temp = word.trueTarget;
         }
         else {
-            temp = prog->getFalseTarget()->getValue();
+            temp = word.falseTarget;
         }
         break;
     case Enu::uBRC:
         if(data->getStatusBit(Enu::STATUS_C))  {
-            temp = prog->getTrueTarget()->getValue();
+            temp = word.trueTarget;
         }
         else {
-            temp = prog->getFalseTarget()->getValue();
+            temp = word.falseTarget;
         }
         break;
     case Enu::uBRS:
         if(data->getStatusBit(Enu::STATUS_S)) {
-            temp = prog->getTrueTarget()->getValue();
+            temp = word.trueTarget;
         }
         else {
-            temp = prog->getFalseTarget()->getValue();
+            temp = word.falseTarget;
         }
         break;
     case Enu::IsPrefetchValid:
         if(isPrefetchValid) {
-            temp = prog->getTrueTarget()->getValue();
+            temp = word.trueTarget;
         }
         else {
-            temp = prog->getFalseTarget()->getValue();
+            temp = word.falseTarget;
         }
         break;
     case Enu::IsUnary:
         byte = data->getRegisterBankByte(8);
         // At the hardware level, all traps are unary.
         // If it is a non-unary trap at the ASM level, loading the argument is part of the microcode trap handlers responsibility.
-        if(Pep::isUnaryMap[Pep::decodeMnemonic[byte]] || Pep::isTrapMap[Pep::decodeMnemonic[byte]]) {
-            temp = prog->getTrueTarget()->getValue();
+        if(Pep::isUnaryMap.value(Pep::decodeMnemonic.at(byte)) || Pep::isTrapMap.value(Pep::decodeMnemonic.at(byte))) {
+            temp = word.trueTarget;
         }
         else {
-            temp = prog->getFalseTarget()->getValue();
+            temp = word.falseTarget;
         }
         break;
     case Enu::IsPCEven:
         if(data->getRegisterBankByte(7)%2 == 0) {
-            temp = prog->getTrueTarget()->getValue();
+            temp = word.trueTarget;
         }
         else {
-            temp = prog->getFalseTarget()->getValue();
+            temp = word.falseTarget;
         }
         break;
     case Enu::AddressingModeDecoder:
@@ -566,8 +664,8 @@ void FullMicrocodedCPU::branchHandler()
             executionFinished = true;
             controlError = true;
             // Get the enumerated & string values of current instruction.
-            Enu::EAddrMode addrMode = Pep::decodeAddrMode[data->getRegisterBankByte(8)];
-            tempString = Pep::defaultEnumToMicrocodeAddrSymbol[addrMode];
+            Enu::EAddrMode addrMode = Pep::decodeAddrMode.at(data->getRegisterBankByte(8));
+            tempString = Pep::defaultEnumToMicrocodeAddrSymbol.value(addrMode);
             // Attempt to lookup the symbol associated with the instruction
             QSharedPointer<const SymbolTable> symTable = this->sharedProgram->getSymTable();
             val = symTable->getValue(tempString);
@@ -588,8 +686,8 @@ void FullMicrocodedCPU::branchHandler()
             executionFinished = true;
             controlError = true;
             // Get the enumerated & string values of current instruction.
-            Enu::EMnemonic mnemon = Pep::decodeMnemonic[data->getRegisterBankByte(8)];
-            tempString = Pep::defaultEnumToMicrocodeInstrSymbol[mnemon];
+            Enu::EMnemonic mnemon = Pep::decodeMnemonic.at(data->getRegisterBankByte(8));
+            tempString = Pep::defaultEnumToMicrocodeInstrSymbol.value(mnemon);
             // Attempt to lookup the symbol associated with the instruction
             QSharedPointer<const SymbolTable> symTable = this->sharedProgram->getSymTable();
             val = symTable->getValue(tempString);
@@ -617,7 +715,7 @@ void FullMicrocodedCPU::branchHandler()
         //If there was an error in the control section, make sure the CPU stops
         executionFinished = true;
     }
-    else if(temp == microprogramCounter && prog->getBranchFunction() != Enu::Stop) {
+    else if(temp == microprogramCounter && word.branchFunction != Enu::Stop) {
         executionFinished  = true;
         controlError = true;
         errorMessage = "ERROR: µInstructions cannot branch to themselves";
@@ -630,66 +728,29 @@ void FullMicrocodedCPU::branchHandler()
 void FullMicrocodedCPU::updateAtInstructionEnd()
 {
     // Handle changing of call stack depth if the executed instruction affects the call stack.
-    if(Pep::decodeMnemonic[data->getRegisterBankByte(Enu::CPURegisters::IS)] == Enu::EMnemonic::CALL){
+    if(Pep::decodeMnemonic.at(data->getRegisterBankByte(Enu::CPURegisters::IS)) == Enu::EMnemonic::CALL){
         callDepth++;
     }
-    else if(Pep::isTrapMap[Pep::decodeMnemonic[data->getRegisterBankByte(Enu::CPURegisters::IS)]]){
+    else if(Pep::isTrapMap.value(Pep::decodeMnemonic.at(data->getRegisterBankByte(Enu::CPURegisters::IS)))){
         callDepth++;
     }
-    else if(Pep::decodeMnemonic[data->getRegisterBankByte(Enu::CPURegisters::IS)] == Enu::EMnemonic::RET){
+    else if(Pep::decodeMnemonic.at(data->getRegisterBankByte(Enu::CPURegisters::IS)) == Enu::EMnemonic::RET){
         callDepth--;
     }
-    else if(Pep::decodeMnemonic[data->getRegisterBankByte(Enu::CPURegisters::IS)] == Enu::EMnemonic::RETTR){
+    else if(Pep::decodeMnemonic.at(data->getRegisterBankByte(Enu::CPURegisters::IS)) == Enu::EMnemonic::RETTR){
         callDepth--;
     }
 }
 
-void FullMicrocodedCPU::calculateInstrJT()
+void FullMicrocodedCPU::loadProgram()
 {
-    // Symbol table of the current microprogram
-    QSharedPointer<const SymbolTable> symTable = this->sharedProgram->getSymTable();
-    QSharedPointer<SymbolEntry> val;
-    FullMicrocodedCPU::decoder_entry entry;
-    for(int it = 0; it <= 255; ++it) {
-        QString tempString = Pep::instSpecToMicrocodeInstrSymbol[it];
-        val = symTable->getValue(tempString);
-        // Instead of causing an error before execution starts,
-        // flag the entry as invalid so that the error can be caught at runtime.
-        // This allows microprogram fragments that do not define all instructions
-        // to be created, which is of instructional value to students
-        if(val == nullptr || !val->isDefined()) {
-            entry.isValid = false;
-        }
-        else {
-            entry.isValid = true;
-            entry.addr = static_cast<quint16>(val->getValue());
-        }
-        instrSpecJT[static_cast<quint8>(it)] = entry;
-    }
-}
-
-void FullMicrocodedCPU::calculateAddrJT()
-{
-    // Symbol table of the current microprogram
-    QSharedPointer<const SymbolTable> symTable = this->sharedProgram->getSymTable();
-    QSharedPointer<SymbolEntry> val;
-    FullMicrocodedCPU::decoder_entry entry;
-    for(int it = 0; it <= 255; ++it) {
-        QString tempString = Pep::instSpecToMicrocodeAddrSymbol[it];
-        val = symTable->getValue(tempString);
-        // Instead of causing an error before execution starts,
-        // flag the entry as invalid so that the error can be caught at runtime.
-        // This allows microprogram fragments that do not define all instructions
-        // to be created, which is of instructional value to students
-        if(val == nullptr || !val->isDefined()) {
-            entry.isValid = false;
-        }
-        else {
-            entry.isValid = true;
-            entry.addr = static_cast<quint16>(val->getValue());
-        }
-        addrModeJT[static_cast<quint8>(it)] = entry;
-    }
+    QSharedPointer<const DecodedMicrocode> decoded = DecodedMicrocode::decode(sharedProgram);
+    compiledProgram = decoded->compiled.rebind(sharedProgram);
+    startLine = decoded->startLine;
+    instrSpecJT = decoded->instrSpecJT;
+    addrModeJT = decoded->addrModeJT;
+    // Blocks are resolved using the jump tables, so they must be recorded again.
+    fusedBlocks.clear();
 }
 
 void FullMicrocodedCPU::breakpointAsmHandler()
@@ -706,11 +767,11 @@ void FullMicrocodedCPU::breakpointMicroHandler()
     return;
 }
 
-void FullMicrocodedCPU::setSignalsFromMicrocode(const MicroCode *line)
+void FullMicrocodedCPU::setSignalsFromControlWord(const MicroControlWord &word)
 {
     int val;
-    if(line->getClockSignal(Enu::EClockSignals::PValidCk)) {
-        val = line->getControlSignal(Enu::EControlSignals::PValid);
+    if(word.clockSignals[Enu::EClockSignals::PValidCk]) {
+        val = word.controlSignals[Enu::EControlSignals::PValid];
         if(val == Enu::signalDisabled) {
             errorMessage = "Error: Asserted PValidCk, but PValid was disabled.";
             controlError = true;
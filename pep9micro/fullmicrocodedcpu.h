@@ -22,9 +22,13 @@
 #ifndef FULLMICROCODEDCPU_H
 #define FULLMICROCODEDCPU_H
 
+#include "compiledmicrocode.h"
+#include "decodedmicrocode.h"
 #include "interfacemccpu.h"
 #include "interfaceisacpu.h"
+#include "microcodeprofiler.h"
 #include <QElapsedTimer>
+#include <QHash>
 #include <array>
 class CPUDataSection;
 class FullMicrocodedMemoizer;
@@ -44,6 +48,18 @@ public:
     // This can be used to skip the initialization steps at the top
     // of a microcode program.
     void setMicroPCToStart() noexcept;
+    // When enabled, and debugging is disabled, straight-line runs of microcode
+    // are recorded per instruction specifier and executed as a single macro-step.
+    // Macro-steps skip per-cycle branch dispatch, breakpoint checks and yielding.
+    void setBlockFusion(bool fuse) noexcept;
+    bool getBlockFusion() const noexcept;
+    // When enabled, every cycle is attributed to its line of microcode and ISA instruction.
+    // Takes effect when the CPU is next reset or a simulation is next started,
+    // so that the profile is never resized while the CPU is executing.
+    void setProfiling(bool profile) noexcept;
+    // Returns if the current or last simulation was profiled.
+    bool getProfiling() const noexcept;
+    const MicrocodeProfiler& getProfiler() const noexcept;
 
     // ACPUModel interface
     bool getStatusBitCurrent(Enu::EStatusBit) const override;
@@ -70,6 +86,7 @@ public:
     quint64 getCycleCount() override;
     quint64 getInstructionCount() override;
     const QVector<quint32> getInstructionHistogram() override;
+    const QVector<quint64> getInstructionCycleHistogram() override;
 
 public slots:
     void onSimulationStarted() override;
@@ -90,16 +107,11 @@ private:
     CPUDataSection *data;
     QSharedPointer<CPUDataSection> dataShared;
     FullMicrocodedMemoizer *memoizer;
-    // A class to represent a single item in the instruction specifier
-    // or addressing mode decoder.
-    struct decoder_entry {
-        quint16 addr;
-        bool isValid;
-    };
+    using decoder_entry = DecodedMicrocode::decoder_entry;
 
     // For each instruction in the instruction set, map the instruction to
-    // the first line of microcode that implements it.This calculation is
-    // done each time a microprogram is run to account for mnemonic redefinitons.
+    // the first line of microcode that implements it. The table is reloaded
+    // each time a microprogram is run to account for mnemonic redefinitons.
     // Any modification to the Pep:: instruction mappings while the simulator is running
     // could cause the microprogram to error in unexpected ways.
     std::array<decoder_entry, 256> instrSpecJT;
@@ -111,16 +123,35 @@ private:
     // is running, else a microprogram might fail unexpectedly.
     std::array<decoder_entry, 256> addrModeJT;
     quint16 startLine = 0;
+    // The microprogram lowered into control words. Reloaded whenever
+    // the CPU is handed a different microprogram.
+    CompiledMicrocode compiledProgram;
+
+    // A straight-line run of microcode entered at lines[0]. The successor of
+    // every line but the last is known once the instruction specifier is known,
+    // so only the branch of the last line is resolved at runtime.
+    struct fused_block {
+        QVector<quint16> lines;
+    };
+    bool blockFusion;
+    // Recorded blocks keyed by entry line and the instruction specifier at entry.
+    // Must be cleared whenever the program or jump tables change.
+    QHash<quint32, fused_block> fusedBlocks;
+    const fused_block& fusedBlockAt(quint16 line, quint8 instrSpec);
+    // Execute the block starting at the µPC, then resolve its final branch.
+    void executeFusedBlock();
+
+    bool profiling, profilingRequested;
+    MicrocodeProfiler profiler;
 
     void breakpointAsmHandler();
     void breakpointMicroHandler();
-    void setSignalsFromMicrocode(const MicroCode *line);
+    void setSignalsFromControlWord(const MicroControlWord& word);
     void branchHandler() override;
     void updateAtInstructionEnd() override;
-    // For all 256 instructions in the Pep/9 insturction set,
-    // map the instruction to the first line of microcode that implements it.
-    void calculateInstrJT();
-    void calculateAddrJT();
+    // Load the control words, start line, and jump tables for the current microprogram.
+    // Decoding is shared with any earlier program assembled from the same text.
+    void loadProgram();
 };
 
 #endif // FULLMICROCODEDCPU_H
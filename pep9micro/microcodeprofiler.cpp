@@ -0,0 +1,151 @@
+// File: microcodeprofiler.cpp
+/*
+    Pep9Micro is a complete CPU simulator for the Pep/9 instruction set,
+    and is capable of assembling programs to object code, executing
+    object code programs, and executing microcode fragments.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "microcodeprofiler.h"
+
+#include <QStringBuilder>
+
+#include "asmcode.h"
+#include "asmprogram.h"
+#include "asmprogrammanager.h"
+#include "memoizerhelper.h"
+#include "microcode.h"
+#include "microcodeprogram.h"
+#include "pep.h"
+#include "symbolentry.h"
+
+// Frames are separated by semicolons, and the count by a space,
+// so neither may appear inside a frame.
+static QString toFrame(QString text)
+{
+    return text.simplified().replace(';', ',');
+}
+
+MicrocodeProfiler::MicrocodeProfiler(): programLength(0), currentRow(0),
+    rows(), addressToRow(), cycles()
+{
+    reset(0);
+}
+
+void MicrocodeProfiler::reset(int programLength)
+{
+    this->programLength = programLength;
+    currentRow = 0;
+    rows.clear();
+    // Row 0 collects cycles that do not belong to any instruction.
+    rows.append({0, 0, -1});
+    addressToRow.fill(-1, 1 << 16);
+    cycles.fill(0, programLength);
+}
+
+void MicrocodeProfiler::onInstructionStart(quint16 address, quint8 instrSpec)
+{
+    qint32 row = addressToRow[address];
+    while(row != -1 && rows[row].instrSpec != instrSpec) {
+        row = rows[row].next;
+    }
+    if(row == -1) {
+        row = rows.size();
+        rows.append({address, instrSpec, addressToRow[address]});
+        addressToRow[address] = row;
+        cycles.resize(cycles.size() + programLength);
+    }
+    currentRow = row * programLength;
+}
+
+quint64 MicrocodeProfiler::getTotalCycles() const
+{
+    quint64 total = 0;
+    for(quint64 count : cycles) total += count;
+    return total;
+}
+
+QVector<quint64> MicrocodeProfiler::getLineCycles() const
+{
+    QVector<quint64> lines(programLength, 0);
+    for(int row = 0; row < rows.size(); row++) {
+        for(int line = 0; line < programLength; line++) {
+            lines[line] += cycles[row * programLength + line];
+        }
+    }
+    return lines;
+}
+
+QVector<quint64> MicrocodeProfiler::getInstructionCycles() const
+{
+    QVector<quint64> instructions(256, 0);
+    // Row 0 is not an instruction.
+    for(int row = 1; row < rows.size(); row++) {
+        for(int line = 0; line < programLength; line++) {
+            instructions[rows[row].instrSpec] += cycles[row * programLength + line];
+        }
+    }
+    return instructions;
+}
+
+QString MicrocodeProfiler::collapsedStacks(const MicrocodeProgram &program, const AsmProgramManager &manager) const
+{
+    // Name the routine and line frames once, instead of once per row.
+    QVector<QString> lineFrames(programLength);
+    QString routine = "(no symbol)";
+    for(int line = 0; line < programLength && line < program.codeLength(); line++) {
+        const MicroCode* code = program.getCodeLine(static_cast<quint16>(line));
+        // Symbols starting with an underscore are generated by the microassembler.
+        if(code->hasSymbol() && !code->getSymbol()->getName().startsWith("_")) {
+            routine = toFrame(code->getSymbol()->getName());
+        }
+        // Number lines from 1 to match the cycle numbers in the microcode pane.
+        lineFrames[line] = routine % ";line " % QString::number(line + 1);
+    }
+
+    const AsmProgram* os = manager.getOperatingSystem().data();
+    QString output;
+    for(int row = 0; row < rows.size(); row++) {
+        QString prefix;
+        if(row == 0) {
+            prefix = "(microcode prelude)";
+        }
+        else {
+            const row_info& info = rows[row];
+            const AsmProgram* asmProgram = manager.getProgramAt(info.address);
+            const AsmCode* code = asmProgram == nullptr ? nullptr : asmProgram->memAddressToCode(info.address);
+            QString programName = asmProgram == nullptr ? "(no program)"
+                                                        : asmProgram == os ? "operating system" : "user program";
+            QString source = QString("0x%1").arg(info.address, 4, 16, QLatin1Char('0')).toUpper();
+            if(code != nullptr) {
+                QString text = code->getAssemblerSource();
+                if(code->hasComment()) text.chop(code->getComment().length());
+                source.append(" " % text);
+            }
+            QString instruction = mnemonDecode(info.instrSpec);
+            if(!Pep::isUnaryMap.value(Pep::decodeMnemonic.at(info.instrSpec))) {
+                instruction.append("," % Pep::intToAddrMode(Pep::decodeAddrMode.at(info.instrSpec)).toLower());
+            }
+            prefix = programName % ";" % toFrame(source) % ";" % toFrame(instruction);
+        }
+        for(int line = 0; line < programLength; line++) {
+            quint64 count = cycles[row * programLength + line];
+            if(count == 0) continue;
+            output.append(prefix % ";" % lineFrames[line] % " " % QString::number(count) % "\n");
+        }
+    }
+    return output;
+}
@@ -0,0 +1,85 @@
+// File: microcodeprofiler.h
+/*
+    Pep9Micro is a complete CPU simulator for the Pep/9 instruction set,
+    and is capable of assembling programs to object code, executing
+    object code programs, and executing microcode fragments.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef MICROCODEPROFILER_H
+#define MICROCODEPROFILER_H
+
+#include <QString>
+#include <QVector>
+
+class AsmProgramManager;
+class MicrocodeProgram;
+
+/*
+ * Attributes every microcycle to the line of microcode that executed it,
+ * and to the ISA instruction (address and instruction specifier) that was
+ * executing at the time.
+ *
+ * Each distinct instruction owns a row of counters indexed by microprogram line,
+ * so recording a cycle is a single increment. Rows are allocated the first time an
+ * address executes with a given instruction specifier. Row 0 holds cycles executed
+ * before the first instruction, such as a microprogram's initialization code.
+ */
+class MicrocodeProfiler
+{
+public:
+    explicit MicrocodeProfiler();
+
+    // Discard all counters, and size rows for a microprogram of programLength lines.
+    void reset(int programLength);
+    // Attribute all following cycles to the instruction at address.
+    void onInstructionStart(quint16 address, quint8 instrSpec);
+    // Pre: line < the programLength passed to reset().
+    inline void onCycle(quint16 line)
+    {
+        ++cycles[currentRow + line];
+    }
+
+    quint64 getTotalCycles() const;
+    // Cycles spent on each line of microcode, summed over all instructions.
+    QVector<quint64> getLineCycles() const;
+    // Cycles spent on each of the 256 instruction specifiers.
+    QVector<quint64> getInstructionCycles() const;
+
+    // Render the profile in the collapsed stack format consumed by flame graph tools.
+    // Each line is "program;source line;instruction;microcode routine;microcode line cycles".
+    // A microcode routine is named by the closest symbol at or above a line.
+    QString collapsedStacks(const MicrocodeProgram& program, const AsmProgramManager& manager) const;
+
+private:
+    struct row_info {
+        quint16 address;
+        quint8 instrSpec;
+        // Next row with the same address but a different instruction specifier,
+        // which only happens in self-modifying programs. -1 if none.
+        qint32 next;
+    };
+    int programLength;
+    // Offset of the first counter of the current row.
+    int currentRow;
+    QVector<row_info> rows;
+    // For each of the 65536 addresses, the first row for that address or -1.
+    QVector<qint32> addressToRow;
+    // rows.size() * programLength counters, stored row after row.
+    QVector<quint64> cycles;
+};
+
+#endif // MICROCODEPROFILER_H
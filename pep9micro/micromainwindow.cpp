@@ -71,6 +71,7 @@
 #include "updatechecker.h"
 #include "redefinemnemonicsdialog.h"
 #include "registerfile.h"
+#include "simulationworker.h"
 #include "symboltable.h"
 
 MicroMainWindow::MicroMainWindow(QWidget *parent) :
@@ -78,8 +79,10 @@ MicroMainWindow::MicroMainWindow(QWidget *parent) :
     ui(new Ui::MicroMainWindow), debugState(DebugState::DISABLED), codeFont(QFont(Pep::codeFont, Pep::codeFontSize)),
     updateChecker(new UpdateChecker()), isInDarkMode(false),
     memDevice(new MainMemory(nullptr)), controlSection(new FullMicrocodedCPU(AsmProgramManager::getInstance(), memDevice)),
-    dataSection(controlSection->getDataSection()), redefineMnemonicsDialog(new RedefineMnemonicsDialog(this)),
-    decoderTableDialog(new DecoderTableDialog(nullptr)), programManager(AsmProgramManager::getInstance())
+    dataSection(controlSection->getDataSection()), simulationWorker(new SimulationWorker(controlSection, this)),
+    redefineMnemonicsDialog(new RedefineMnemonicsDialog(this)),
+    decoderTableDialog(new DecoderTableDialog(nullptr)), programManager(AsmProgramManager::getInstance()),
+    afterAssembly(AfterAssembly::NOTHING)
 
 {
     // Initialize the memory subsystem
@@ -145,6 +148,7 @@ MicroMainWindow::MicroMainWindow(QWidget *parent) :
     connect(ui->microcodeWidget, &MicrocodePane::redoAvailable, this, &MicroMainWindow::setRedoability);
     connect(ui->assemblerPane, &AssemblerPane::undoAvailable, this, &MicroMainWindow::setUndoability);
     connect(ui->assemblerPane, &AssemblerPane::redoAvailable, this, &MicroMainWindow::setRedoability);
+    connect(ui->assemblerPane, &AssemblerPane::programAssembled, this, &MicroMainWindow::onProgramAssembled);
     connect(ui->ioWidget, &IOWidget::undoAvailable, this, &MicroMainWindow::setUndoability);
     connect(ui->ioWidget, &IOWidget::redoAvailable, this, &MicroMainWindow::setRedoability);
 
@@ -165,6 +169,23 @@ MicroMainWindow::MicroMainWindow(QWidget *parent) :
     connect(this, &MicroMainWindow::simulationStarted, ui->microObjectCodePane, &MicroObjectCodePane::onSimulationStarted);
     connect(this, &MicroMainWindow::simulationStarted, ui->executionStatisticsWidget, &ExecutionStatisticsWidget::onSimulationStarted);
     connect(ui->actionSystem_Clear_CPU, &QAction::triggered, ui->executionStatisticsWidget, &ExecutionStatisticsWidget::onClear);
+    // A profile describes the last run, so discard its annotations when the CPU is cleared or restarted.
+    connect(this, &MicroMainWindow::simulationStarted, ui->microcodeWidget, &MicrocodePane::clearLineProfile);
+    connect(ui->actionSystem_Clear_CPU, &QAction::triggered, ui->microcodeWidget, &MicrocodePane::clearLineProfile);
+    // While the CPU runs on the simulation worker, views are refreshed from published snapshots.
+    FullMicrocodedCPU* cpu = controlSection.get();
+    simulationWorker->setCaptureHook([cpu](SimulationSnapshot& snapshot) {
+        snapshot.instructionCount = cpu->getInstructionCount();
+        snapshot.cycleCount = cpu->getCycleCount();
+    });
+    connect(simulationWorker, &SimulationWorker::snapshotPublished, ui->cpuWidget, &CpuPane::onSimulationSnapshot);
+    connect(simulationWorker, &SimulationWorker::snapshotPublished, ui->memoryWidget, &MemoryDumpPane::onSimulationSnapshot);
+    connect(simulationWorker, &SimulationWorker::snapshotPublished, ui->memoryTracePane, &NewMemoryTracePane::onSimulationSnapshot);
+    connect(simulationWorker, &SimulationWorker::snapshotPublished, this, [this](const SimulationSnapshot& snapshot) {
+        ui->statusBar->showMessage(QString("Running: %1 instructions executed").arg(snapshot.instructionCount));
+    });
+    connect(simulationWorker, &SimulationWorker::runFinished, this, &MicroMainWindow::onBackgroundRunFinished);
+
     // Post finished events to the event queue so that they are processed after simulation updates.
     connect(this, &MicroMainWindow::simulationFinished, ui->microObjectCodePane, &MicroObjectCodePane::onSimulationFinished, Qt::QueuedConnection);
     connect(this, &MicroMainWindow::simulationFinished, controlSection.get(), &FullMicrocodedCPU::onSimulationFinished, Qt::QueuedConnection);
@@ -433,6 +454,9 @@ void MicroMainWindow::readSettings()
 
     // Restore last used file path
     curPath = settings.value("filePath", QDir::homePath()).toString();
+    // Restore execution engine choice. Setting the check state will update the CPU.
+    ui->actionBuild_Fuse_Microcode->setChecked(settings.value("microcodeFusion", false).toBool());
+    ui->actionBuild_Profile_Microcode->setChecked(settings.value("microcodeProfiling", false).toBool());
     // Restore dark mode state
     onDarkModeChanged();
 
@@ -450,6 +474,8 @@ void MicroMainWindow::writeSettings()
     settings.setValue("geometry", saveGeometry());
     settings.setValue("font", codeFont);
     settings.setValue("filePath", curPath);
+    settings.setValue("microcodeFusion", ui->actionBuild_Fuse_Microcode->isChecked());
+    settings.setValue("microcodeProfiling", ui->actionBuild_Profile_Microcode->isChecked());
     settings.endGroup();
     //Handle writing for all children
     ui->microcodeWidget->writeSettings(settings);
@@ -1363,9 +1389,48 @@ void MicroMainWindow::on_actionBuild_Microcode_triggered()
 }
 
 //Build Events
-bool MicroMainWindow::on_actionBuild_Assemble_triggered()
+void MicroMainWindow::on_actionBuild_Assemble_triggered()
+{
+    assembleProgramThen(AfterAssembly::NOTHING);
+}
+
+void MicroMainWindow::assembleProgramThen(AfterAssembly then)
 {
+    afterAssembly = then;
+    ui->statusBar->showMessage("Assembling...");
     ui->assemblerPane->assembleAsProgram();
+    // Prevent building or starting a program until the assembly finishes, unless it already has.
+    handleDebugButtons();
+}
+
+void MicroMainWindow::onProgramAssembled()
+{
+    AfterAssembly then = afterAssembly;
+    afterAssembly = AfterAssembly::NOTHING;
+    // The assembly was abandoned, such as by opening a different file.
+    if(ui->assemblerPane->getAssemblerOutput().isNull()) {
+        ui->statusBar->clearMessage();
+        handleDebugButtons();
+        return;
+    }
+    else if(!installAssembledProgram()) return;
+    switch(then) {
+    case AfterAssembly::RUN:
+        runAssembledProgram();
+        break;
+    case AfterAssembly::DEBUG:
+        debugAssembledProgram();
+        break;
+    case AfterAssembly::DEBUG_LOADER:
+        debugAssembledProgramWithLoader();
+        break;
+    default:
+        break;
+    }
+}
+
+bool MicroMainWindow::installAssembledProgram()
+{
     if(ui->assemblerPane->getAssemblerOutput()->success){
         programManager->setUserProgram(ui->assemblerPane->getAssemblerOutput()->prog);
         ui->asmProgramTracePane->onRemoveAllBreakpoints();
@@ -1385,6 +1450,7 @@ bool MicroMainWindow::on_actionBuild_Assemble_triggered()
         // ui->pepCodeTraceTab->setCurrentIndex(0); // Make source code pane visible
         loadObjectCodeProgram();
         ui->statusBar->showMessage("Assembly failed", 4000);
+        handleDebugButtons();
         return false;
     }
 
@@ -1408,6 +1474,7 @@ void MicroMainWindow::on_actionBuild_Execute_triggered()
         ui->memoryWidget->clearHighlight();
         ui->memoryWidget->refreshMemory();
         controlSection->onSimulationStarted();
+        if(startBackgroundRun()) return;
         controlSection->onRun();
         connectViewUpdate();
     }
@@ -1430,7 +1497,11 @@ void MicroMainWindow::on_actionBuild_Execute_triggered()
 
 void MicroMainWindow::on_actionBuild_Run_triggered()
 {
-    if(!on_actionBuild_Assemble_triggered()) return;
+    assembleProgramThen(AfterAssembly::RUN);
+}
+
+void MicroMainWindow::runAssembledProgram()
+{
     loadOperatingSystem();
     loadObjectCodeProgram();
     debugState = DebugState::RUN;
@@ -1443,6 +1514,7 @@ void MicroMainWindow::on_actionBuild_Run_triggered()
         ui->memoryWidget->updateMemory();
         ui->memoryTracePane->updateTrace();
         controlSection->onSimulationStarted();
+        if(startBackgroundRun()) return;
         controlSection->onRun();
         connectViewUpdate();
 
@@ -1473,6 +1545,49 @@ void MicroMainWindow::on_actionBuild_Run_Object_triggered()
     }
 }
 
+void MicroMainWindow::on_actionBuild_Fuse_Microcode_toggled(bool checked)
+{
+    // Only affects runs, since the CPU always steps cycle by cycle while debugging.
+    controlSection->setBlockFusion(checked);
+}
+
+void MicroMainWindow::on_actionBuild_Profile_Microcode_toggled(bool checked)
+{
+    // Takes effect the next time a simulation starts.
+    controlSection->setProfiling(checked);
+}
+
+void MicroMainWindow::on_actionBuild_Save_Profile_triggered()
+{
+    if(!controlSection->getProfiling() || controlSection->getProfiler().getTotalCycles() == 0) {
+        QMessageBox::information(this, tr("Pep/9 Micro"),
+                                 tr("There is no profile to save. Enable Profile Microcode, and run a program."));
+        return;
+    }
+    QString fileName = QFileDialog::getSaveFileName(
+                this,
+                "Save Microcode Profile",
+                QDir(curPath).absoluteFilePath("untitled.folded"),
+                "Collapsed Stacks (*.folded *.txt)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+    QFile file(fileName);
+    if (!file.open(QFile::WriteOnly | QFile::Text)) {
+        QMessageBox::warning(this, tr("Pep/9 Micro"),
+                             tr("Cannot write file %1:\n%2.")
+                             .arg(fileName)
+                             .arg(file.errorString()));
+        return;
+    }
+    QTextStream out(&file);
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    out << controlSection->getProfiler().collapsedStacks(*ui->microcodeWidget->getMicrocodeProgram(), *programManager);
+    QApplication::restoreOverrideCursor();
+    curPath = QFileInfo(file).dir().absolutePath();
+    statusBar()->showMessage("Profile saved", 4000);
+}
+
 // Debug slots
 
 void MicroMainWindow::handleDebugButtons()
@@ -1499,6 +1614,12 @@ void MicroMainWindow::handleDebugButtons()
         enabledButtons |= DebugButtons::BUILD_ASM | DebugButtons::BUILD_MICRO;
         enabledButtons |= DebugButtons::OPEN_NEW | DebugButtons::INSTALL_OS | DebugButtons::DEBUG_MICRO;
         enabledButtons |= DebugButtons::CLEAR;
+        // Wait for the program being assembled before building, loading, or starting a program.
+        if(ui->assemblerPane->isAssemblingProgram()) {
+            enabledButtons &= ~(DebugButtons::RUN | DebugButtons::RUN_OBJECT | DebugButtons::DEBUG | DebugButtons::DEBUG_OBJECT
+                                | DebugButtons::DEBUG_LOADER | DebugButtons::DEBUG_MICRO | DebugButtons::BUILD_ASM
+                                | DebugButtons::INSTALL_OS);
+        }
         break;
     case DebugState::RUN:
         enabledButtons = DebugButtons::STOP | DebugButtons::INTERRUPT;
@@ -1528,12 +1649,16 @@ void MicroMainWindow::handleDebugButtons()
     debugButtonEnableHelper(enabledButtons);
 }
 
-bool MicroMainWindow::on_actionDebug_Start_Debugging_triggered()
-{  
-    if(!on_actionBuild_Assemble_triggered()) return false;
+void MicroMainWindow::on_actionDebug_Start_Debugging_triggered()
+{
+    assembleProgramThen(AfterAssembly::DEBUG);
+}
+
+void MicroMainWindow::debugAssembledProgram()
+{
     // Unlike Pep9asm, on_actionDebug_Start_Debugging_Object_triggered switched to the
     // debugger tab. This is because in the event of useless object code there is still microcode to debug.
-    return on_actionDebug_Start_Debugging_Object_triggered();
+    on_actionDebug_Start_Debugging_Object_triggered();
 
 }
 
@@ -1571,9 +1696,13 @@ bool MicroMainWindow::on_actionDebug_Start_Debugging_Object_triggered()
     return false;
 }
 
-bool MicroMainWindow::on_actionDebug_Start_Debugging_Loader_triggered()
+void MicroMainWindow::on_actionDebug_Start_Debugging_Loader_triggered()
+{
+    assembleProgramThen(AfterAssembly::DEBUG_LOADER);
+}
+
+void MicroMainWindow::debugAssembledProgramWithLoader()
 {
-    if(!on_actionBuild_Assemble_triggered()) return false;
     memDevice->clearMemory();
     loadOperatingSystem();
     // Copy object code to batch input pane and make it the active input pane
@@ -1582,7 +1711,7 @@ bool MicroMainWindow::on_actionDebug_Start_Debugging_Loader_triggered()
     objcode = objcode.replace('\n', ' ');
     ui->ioWidget->setBatchInput(objcode);
     ui->ioWidget->setActivePane(Enu::EPane::EBatchIO);
-    if(!on_actionDebug_Start_Debugging_Object_triggered()) return false;
+    if(!on_actionDebug_Start_Debugging_Object_triggered()) return;
     // Skip over any initialization code in the microprogram.
     controlSection->setMicroPCToStart();
     quint16 sp, pc;
@@ -1595,7 +1724,6 @@ bool MicroMainWindow::on_actionDebug_Start_Debugging_Loader_triggered()
     // Memory has been cleared, but will not display as such unless explicitly refreshed.
     ui->memoryWidget->refreshMemory();
     emit simulationUpdate();
-    return true;
 }
 
 bool MicroMainWindow::on_actionDebug_Start_Debugging_Microcode_triggered()
@@ -1666,6 +1794,12 @@ bool MicroMainWindow::on_actionDebug_Start_Debugging_Microcode_triggered()
 
 void MicroMainWindow::on_actionDebug_Stop_Debugging_triggered()
 {
+    // Stopping the worker will finish the simulation, which stops debugging.
+    if(simulationWorker->isRunning()) {
+        controlSection->requestCancel();
+        simulationWorker->waitForFinished();
+        return;
+    }
     connectViewUpdate();
     highlightActiveLines();
     debugState = DebugState::DISABLED;
@@ -1708,8 +1842,17 @@ void MicroMainWindow::on_actionDebug_Single_Step_Assembler_triggered()
 void MicroMainWindow::on_actionDebug_Interupt_Execution_triggered()
 {
     // Enable debugging in CPU and then temporarily pause execution.
-    controlSection->enableDebugging();
-    controlSection->forceBreakpoint(Enu::BreakpointTypes::ASSEMBLER);
+    if(simulationWorker->isRunning()) {
+        // The worker may only be interrupted between steps, so wait for it to pause.
+        controlSection->requestInterrupt(Enu::BreakpointTypes::ASSEMBLER);
+        simulationWorker->waitForFinished();
+        // The program may have terminated before the interrupt was honored.
+        if(debugState == DebugState::DISABLED) return;
+    }
+    else {
+        controlSection->enableDebugging();
+        controlSection->forceBreakpoint(Enu::BreakpointTypes::ASSEMBLER);
+    }
     connectViewUpdate();
     debugState = DebugState::DEBUG_ISA;
     highlightActiveLines();
@@ -1899,8 +2042,14 @@ void MicroMainWindow::redefine_Mnemonics_closed()
 
 void MicroMainWindow::onSimulationFinished()
 {
+    // The CPU signals completion from the worker thread before it is done running.
+    // Wait for onBackgroundRunFinished(), which is only called once the worker is idle.
+    if(simulationWorker->isRunning()) return;
     QString errorString;
     on_actionDebug_Stop_Debugging_triggered();
+    if(controlSection->getProfiling()) {
+        ui->microcodeWidget->setLineProfile(controlSection->getProfiler().getLineCycles());
+    }
 
     QVector<AMicroCode*> prog = ui->microcodeWidget->getMicrocodeProgram()->getObjectCode();
     bool hadPostTest = false;
@@ -1934,6 +2083,33 @@ void MicroMainWindow::onSimulationFinished()
 
 }
 
+bool MicroMainWindow::startBackgroundRun()
+{
+    // Interactive input must be answered by the UI before a read completes,
+    // so only runs using batch input are executed off of the UI thread.
+    if(!ui->ioWidget->inBatchMode()) return false;
+    memDevice->setAbortOnMissingInput(true);
+    simulationWorker->start();
+    return true;
+}
+
+void MicroMainWindow::onBackgroundRunFinished()
+{
+    memDevice->setAbortOnMissingInput(false);
+    connectViewUpdate();
+    // If the simulator finished, then propogate that information to connect components.
+    if(controlSection->getExecutionFinished()) {
+        debugState = DebugState::DISABLED;
+        onSimulationFinished();
+    }
+    // Otherwise, the simulator paused execution, so don't explicitly terminate
+    // the simulator.
+    else {
+        handleDebugButtons();
+        emit simulationUpdate();
+    }
+}
+
 void MicroMainWindow::onDarkModeChanged()
 {
     isInDarkMode = inDarkMode();
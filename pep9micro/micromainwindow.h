@@ -42,6 +42,7 @@ class DecoderTableDialog;
 class FullMicrocodedCPU;
 class MicroHelpDialog;
 class MainMemory;
+class SimulationWorker;
 class MicrocodePane;
 class MicroObjectCodePane;
 class CPUDataSection;
@@ -91,6 +92,8 @@ private:
     QSharedPointer<MainMemory> memDevice;
     QSharedPointer<FullMicrocodedCPU> controlSection;
     QSharedPointer<CPUDataSection> dataSection;
+    // Runs the CPU off of the UI thread when no interaction is needed.
+    SimulationWorker *simulationWorker;
 
     // Dialogues
     MicroHelpDialog *helpDialog;
@@ -104,6 +107,24 @@ private:
     // Disconnecting these events allow for faster execution when running or continuing.
     void connectViewUpdate();
     void disconnectViewUpdate();
+    // Run on the simulation worker if the run needs no input from the UI.
+    // Returns false if the run must instead be executed on the UI thread.
+    bool startBackgroundRun();
+
+    // What to do once the program started by a build or debug action has been assembled.
+    enum class AfterAssembly
+    {
+        NOTHING, RUN, DEBUG, DEBUG_LOADER
+    };
+    AfterAssembly afterAssembly;
+    // Start assembling the source program in the background, and perform then once it has been assembled.
+    void assembleProgramThen(AfterAssembly then);
+    // Make the output of the assembler pane the user program. Returns true if assembly succeeded.
+    bool installAssembledProgram();
+    // Continuations of Run, Start Debugging, and Start Debugging Loader once the program has been assembled.
+    void runAssembledProgram();
+    void debugAssembledProgram();
+    void debugAssembledProgramWithLoader();
 
     // Methods to persist & restore class to file.
     void readSettings();
@@ -193,18 +214,26 @@ private slots:
 
     // Build
     void on_actionBuild_Microcode_triggered();
-    bool on_actionBuild_Assemble_triggered(); //Returns true if assembly succeded.
+    void on_actionBuild_Assemble_triggered();
+    // Install the assembled program and continue the action that requested the assembly.
+    void onProgramAssembled();
     void on_actionBuild_Load_Object_triggered();
     void on_actionBuild_Execute_triggered();
     void on_actionBuild_Run_triggered();
     void on_actionBuild_Run_Object_triggered();
+    // Select whether runs without debugging execute fused microcode blocks.
+    void on_actionBuild_Fuse_Microcode_toggled(bool checked);
+    // Select whether runs attribute cycles to lines of microcode.
+    void on_actionBuild_Profile_Microcode_toggled(bool checked);
+    // Write the profile of the last run in the collapsed stack format used by flame graphs.
+    void on_actionBuild_Save_Profile_triggered();
 
 
     //Debug Events
     void handleDebugButtons();
-    bool on_actionDebug_Start_Debugging_triggered();
+    void on_actionDebug_Start_Debugging_triggered();
     bool on_actionDebug_Start_Debugging_Object_triggered();
-    bool on_actionDebug_Start_Debugging_Loader_triggered();
+    void on_actionDebug_Start_Debugging_Loader_triggered();
     bool on_actionDebug_Start_Debugging_Microcode_triggered();
 
     void on_actionDebug_Interupt_Execution_triggered();
@@ -259,6 +288,7 @@ private slots:
 
     //Run events
     void onSimulationFinished();
+    void onBackgroundRunFinished();
 
     // Byte converter
     void slotByteConverterDecEdited(const QString &);
@@ -3,11 +3,15 @@
 # -------------------------------------------------
 
 HEADERS += \
+    decodedmicrocode.h \
     fullmicrocodedcpu.h \
-    fullmicrocodedmemoizer.h
+    fullmicrocodedmemoizer.h \
+    microcodeprofiler.h
 
 SOURCES += \
+    decodedmicrocode.cpp \
     fullmicrocodedcpu.cpp \
-    fullmicrocodedmemoizer.cpp
+    fullmicrocodedmemoizer.cpp \
+    microcodeprofiler.cpp
 
 
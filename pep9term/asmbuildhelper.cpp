@@ -131,7 +131,7 @@ bool ASMBuildHelper::buildProgram()
         else {
             QTextStream listingStream(&listingFile);
             listingStream << program->getProgramListing();
-            if(!program->getSymbolTable()->getSymbolMap().isEmpty()) {
+            if(!program->getSymbolTable()->isEmpty()) {
                 listingStream << "\n";
                 listingStream << program->getSymbolTable()->getSymbolTableListing();
             }
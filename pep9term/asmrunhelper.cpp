@@ -20,22 +20,21 @@
 */
 #include "asmrunhelper.h"
 
-#include <iostream>
-
 #include "amemorychip.h"
 #include "amemorydevice.h"
 #include "asmcode.h"
 #include "asmprogram.h"
 #include "asmprogrammanager.h"
 #include "boundexecisacpu.h"
+#include "flatmemory.h"
 #include "isaasm.h"
 #include "isacpu.h"
 #include "mainmemory.h"
-#include "memorychips.h"
 #include "pep.h"
 #include "symbolentry.h"
 #include "symboltable.h"
 #include "termhelper.h"
+#include "termioobserver.h"
 
 ASMRunHelper::ASMRunHelper(const QString objectCodeString,quint64 maxSimSteps,
                      QFileInfo programOutput, QFileInfo programInput, AsmProgramManager &manager,
@@ -44,7 +43,7 @@ ASMRunHelper::ASMRunHelper(const QString objectCodeString,quint64 maxSimSteps,
     programOutput(programOutput), programInput(programInput) ,manager(manager),
     // Explicitly initialize both simulation objects to nullptr,
     // so that it is clear to that neither object has been allocated
-    memory(nullptr), cpu(nullptr), outputFile(nullptr), maxSimSteps(maxSimSteps)
+    memory(nullptr), cpu(nullptr), io(nullptr), maxSimSteps(maxSimSteps)
 
 {
 
@@ -52,17 +51,16 @@ ASMRunHelper::ASMRunHelper(const QString objectCodeString,quint64 maxSimSteps,
 
 ASMRunHelper::~ASMRunHelper()
 {
-    // If we allocated an output file, we need to perform special work to free it.
-    if(outputFile != nullptr) {
-        outputFile->flush();
-        // It might seem like we should close the file here, but it causes read / write violations to do so.
-        // Instead, delete it later under the assumption that the operating system will handle that for us.
-        // Schedule the output file for deletion via the event loop.
-        outputFile->deleteLater();
-    }
+
 }
 
 void ASMRunHelper::loadOperatingSystem()
+{
+    installOperatingSystem(manager, *memory, charIn, charOut);
+}
+
+void ASMRunHelper::installOperatingSystem(AsmProgramManager &manager, FlatMemory &memory,
+                                          quint16 &charIn, quint16 &charOut)
 {
     QVector<quint8> values;
     quint16 startAddress;
@@ -84,42 +82,16 @@ void ASMRunHelper::loadOperatingSystem()
     // Character input / output ports are only 1 byte wide by design.
     list.append({AMemoryChip::ChipTypes::IDEV, charIn, 1});
     list.append({AMemoryChip::ChipTypes::ODEV, charOut, 1});
-    memory->constructMemoryDevice(list);
-
+    memory.constructMemoryDevice(list);
 
-    memory->autoUpdateMemoryMap(true);
-    memory->loadValues(manager.getOperatingSystem()->getBurnAddress(), values);
-}
-
-void ASMRunHelper::onInputRequested(quint16 address)
-{
-    // All the input a program will ever receive is loaded into the memory
-    // buffer as the program is started. So we can't satisfy the IO request,
-    // and thus we need to signal the simulation that the IO request was denied.
-    memory->onInputAborted(address);
-}
-
-void ASMRunHelper::onOutputReceived(quint16 address, quint8 value)
-{
-    // We do not currently support memory mapped output
-    // other than the charOut.
-    if(address != charOut) return;
-    if(outputFile != nullptr) {
-        // Use a temporary (anonymous) text stream to make writing easy.
-        QTextStream (&*outputFile) << QChar(value);
-        // Try to block and make sure the IO actually completes.
-        outputFile->waitForBytesWritten(300);
-        if(echo) {
-            std::cout << static_cast<char>(value);
-        }
-    }
+    memory.loadValues(manager.getOperatingSystem()->getBurnAddress(), values);
 }
 
 void ASMRunHelper::onSimulationFinished()
 {
-    // There migh be outstanding IO events. Give them a chance to finish
-    // before initiating shutdown.
-    QCoreApplication::processEvents();
+    // Output is written synchronously by the simulation thread, so there are no
+    // outstanding IO events, and flushing the output file is sufficient.
+    io->flush();
     emit finished();
 }
 
@@ -144,22 +116,16 @@ void ASMRunHelper::runProgram()
 
     // Open up program output file if possible.
     // If output can't be opened up, abort.
-    QFile *output = new QFile(programOutput.absoluteFilePath());
-    if(!output->open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
-        qDebug().noquote() << errLogOpenErr.arg(output->fileName());
-        throw std::logic_error("Can't open output file.");
-    } else {
-        // If it could be opened, map charOut to the file.
-        outputFile = output;
-    }
+    io->open_output(programOutput);
 
     // Make sure to set up any last minute flags needed by CPU to perform simulation.
     cpu->onSimulationStarted();
     if(!cpu->onRun()) {
+        errorMessage = cpu->getErrorMessage();
         qDebug().noquote()
                 << "The CPU failed for the following reason: "
                 << cpu->getErrorMessage();
-        QTextStream (&*outputFile)
+        QTextStream (io->get_output())
                 << "[["
                 << cpu->getErrorMessage()
                 << "]]";
@@ -173,42 +139,79 @@ void ASMRunHelper::run()
     // Construct all needed simulation objects in run, so that the owning
     // thread is the one doing the computation, not the main thread.
     if(memory.isNull()) {
-        // Assume memory will always be 64k.
-        memory = QSharedPointer<MainMemory>::create(nullptr);
-        QSharedPointer<RAMChip> ramChip(new RAMChip(1<<16, 0, memory.get()));
-        memory->insertChip(ramChip, 0);
+        // Flat memory defaults to 64k of RAM.
+        memory = QSharedPointer<FlatMemory>::create(nullptr);
 
         cpu = QSharedPointer<BoundExecIsaCpu>::create(maxSimSteps, &manager, memory, nullptr);
 
-        // Connect IO events. IO *MUST* complete before execution moves forward.
-        // Use a blocking connection to serialize IO. Use asynchronous connection
-        // so that memory and helper don't need to reside in the same thread.
-        connect(memory.get(), &MainMemory::inputRequested, this, &ASMRunHelper::onInputRequested, Qt::BlockingQueuedConnection);
-        connect(memory.get(), &MainMemory::outputWritten, this, &ASMRunHelper::onOutputReceived, Qt::BlockingQueuedConnection);
+        // IO *MUST* complete before execution moves forward. Observers are called
+        // synchronously by the thread running the simulation, so IO is serialized
+        // without a cross-thread round trip per character.
+        io.reset(new TermIOObserver(*memory));
+        memory->addObserver(io.data());
     }
+    io->set_echo_charout(echo);
 
     // Load operating system & user program into memory.
-    loadOperatingSystem();
+    if(machine.isNull()) {
+        loadOperatingSystem();
+    }
+    // Or fork the machine which already has the operating system loaded.
+    else {
+        memory->restore(machine->memory);
+        charIn = machine->charIn;
+        charOut = machine->charOut;
+    }
+    io->set_char_out(charOut);
     auto objCode = convertObjectCodeToIntArray(objectCodeString);
     memory->loadValues(0, objCode);
 
     // Clear & initialize all values in CPU before starting simulation.
     cpu->reset();
-    cpu->initCPU();
-
-    // Instead of directly allowing run() to kill itself, uses events to "schedule"
-    // shutting down the application. This should ensure all IO completes. We were
-    // having an error where closing IO streams directly after simulation completion would
-    // cause a race condition with IO pending for the file. The overhead of the simulation events
-    // seems to "serialize" writes / closing.
-    connect(cpu.get(), &IsaCpu::simulationFinished, this, &ASMRunHelper::onSimulationFinished);
-    runProgram();
+    if(machine.isNull()) {
+        cpu->initCPU();
+    }
+    else {
+        cpu->getRegisterBank() = machine->registers;
+    }
+    cpu->setFastExecution(fast);
 
-    // Make sure any outstanding events are handled.
-    QCoreApplication::processEvents();
+    runProgram();
+    // All IO completed on this thread while the program ran, so shutdown may begin.
+    onSimulationFinished();
 }
 
 void ASMRunHelper::set_echo_charout(bool echo)
 {
     this->echo = echo;
 }
+
+void ASMRunHelper::set_fast_execution(bool fast)
+{
+    this->fast = fast;
+}
+
+QString ASMRunHelper::get_error_message() const
+{
+    return errorMessage;
+}
+
+void ASMRunHelper::set_machine_snapshot(QSharedPointer<const ASMMachineSnapshot> snapshot)
+{
+    this->machine = snapshot;
+}
+
+QSharedPointer<const ASMMachineSnapshot> ASMRunHelper::captureMachine(AsmProgramManager &manager)
+{
+    auto snapshot = QSharedPointer<ASMMachineSnapshot>::create();
+    auto memory = QSharedPointer<FlatMemory>::create(nullptr);
+    installOperatingSystem(manager, *memory, snapshot->charIn, snapshot->charOut);
+
+    // Let the CPU compute its initial registers (e.g. the SP from the memory vectors).
+    BoundExecIsaCpu cpu(BoundExecIsaCpu::getDefaultMaxSteps(), &manager, memory, nullptr);
+    cpu.reset();
+    cpu.initCPU();
+    snapshot->registers = cpu.getRegisterBank();
+    snapshot->memory = memory->snapshot();
+    return snapshot;
+}
@@ -23,9 +23,27 @@
 #include <QtCore>
 #include <QRunnable>
 
+#include "flatmemory.h"
+#include "registerfile.h"
+
 class AsmProgramManager;
 class BoundExecIsaCpu;
-class MainMemory;
+class TermIOObserver;
+
+/*
+ * The state of the machine immediately after the operating system has been burned
+ * into memory, and the CPU has been initialized.
+ *
+ * Building the memory map and loading the operating system is the same for every
+ * program. So, capture the resulting machine once, and have each ASMRunHelper fork
+ * the shared snapshot rather than repeating the setup.
+ */
+struct ASMMachineSnapshot {
+    QSharedPointer<const FlatMemory::Snapshot> memory;
+    RegisterFile registers;
+    // Addresses of the character input / character output ports.
+    quint16 charIn, charOut;
+};
 
 /*
  * This class is responsible for executing a single assembly language program.
@@ -46,22 +64,14 @@ public:
                        QObject *parent = nullptr);
     ~ASMRunHelper() override;
 
-    // On memory mapped input requested. Assumes there is only one memory mapped input.
-    // This might be violated in Pep10, but it will require additional command line
-    // parameters to function anyway, so there isn't any major worry here.
-    void onInputRequested(quint16 address);
-
-    // On output received. Assumes there could be multiple memory mapped outputs.
-    void onOutputReceived(quint16 address, quint8 value);
-
 signals:
     // Signals fired when the computation completes (either successfully or due to an error),
     // or the simulation terminates due to exceeding the maximum number of allowed steps.
     void finished();
 
 public:
-    // Pre: All computations an outstanding processing events have been finished.
-    // Post:The main thread has been signaled to shutdown.
+    // Pre: All computations have been finished.
+    // Post:Program output has been flushed, and the main thread has been signaled to shutdown.
     void onSimulationFinished();
 
     // Pre: The operating system has been built and installed.
@@ -75,6 +85,16 @@ public:
 
     // Echo the values written to CharOut to the console.
     void set_echo_charout(bool echo);
+    // Use the CPU's fast execution engine, which skips statistics & stack tracing.
+    void set_fast_execution(bool fast);
+    // If the CPU failed, return the reason it failed. Otherwise returns an empty string.
+    QString get_error_message() const;
+    // Start from a previously captured machine instead of loading the operating system.
+    void set_machine_snapshot(QSharedPointer<const ASMMachineSnapshot> snapshot);
+
+    // Pre: The operating system has been built and installed.
+    // Post:Returns the state of a machine with only the operating system loaded.
+    static QSharedPointer<const ASMMachineSnapshot> captureMachine(AsmProgramManager& manager);
 private:
     const QString objectCodeString;
     QFileInfo programOutput, programInput;
@@ -85,15 +105,15 @@ private:
     // such as the CPU or memory, in run(), since run exectues in the context of the
     // worker thread. This is important for correct parenting of child QObjects.
 
-    // Memory device used by simulation.
-    QSharedPointer<MainMemory> memory;
+    // Memory device used by simulation. No UI is attached, so use the
+    // flat memory device rather than one composed of chips.
+    QSharedPointer<FlatMemory> memory;
     // The CPU simulator that will perform the computation.
     // It is limited to executing a finite numbers of steps,
     // so that applications using Pep9Term will not hang if given a bad program.
     QSharedPointer<BoundExecIsaCpu> cpu;
-
-    // Potentially multiple output sources, but don't take time to simulate now.
-    QFile* outputFile;
+    // Handles memory mapped IO, and owns the file to which charOut is written.
+    QScopedPointer<TermIOObserver> io;
     // Addresses of the character input / character output ports.
     quint16 charIn, charOut;
     // Maximum number of steps the simulator should execute before force quitting.
@@ -101,6 +121,12 @@ private:
 
     // Control if the values written to CharOut get echoed to the console.
     bool echo = false;
+    // Control if the CPU uses its fast execution engine.
+    bool fast = false;
+    // Reason the CPU failed, if any.
+    QString errorMessage;
+    // If not null, the machine is forked from this snapshot.
+    QSharedPointer<const ASMMachineSnapshot> machine;
 
     // Helper method responsible for buffering input, opening output streams,
     // converting string object code to a byte list, and executing the object
@@ -109,5 +135,9 @@ private:
 
     // Load the object code of the operating system into memory from manager.
     void loadOperatingSystem();
+    // Construct memory according to the operating system in manager, and burn the
+    // operating system into it. Sets charIn / charOut to the addresses of the IO ports.
+    static void installOperatingSystem(AsmProgramManager& manager, FlatMemory& memory,
+                                       quint16& charIn, quint16& charOut);
 };
 #endif // ASMRUNHELPER_H
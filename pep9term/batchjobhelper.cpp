@@ -0,0 +1,60 @@
+// File: batchjobhelper.cpp
+/*
+    Pep9Term is a  command line tool utility for assembling Pep/9 programs to
+    object code and executing object code programs.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include "batchjobhelper.h"
+
+QString BatchJob::statusToString(Status status)
+{
+    switch(status) {
+    case Status::NotRun: return "not run";
+    case Status::Ran: return "ran";
+    case Status::Passed: return "passed";
+    case Status::Failed: return "failed";
+    case Status::Error: return "error";
+    }
+    return "";
+}
+
+QString BatchJobCounts::toString(int total) const
+{
+    return QString("%1 passed, %2 failed, %3 errors out of %4 programs.")
+            .arg(passed).arg(failed).arg(errors).arg(total);
+}
+
+BatchJobHelper::BatchJobHelper(QObject *parent): QObject(parent), QRunnable()
+{
+
+}
+
+BatchJobHelper::~BatchJobHelper()
+{
+
+}
+
+void BatchJobHelper::set_thread_count(int count)
+{
+    this->threadCount = count;
+}
+
+void BatchJobHelper::configurePool(QThreadPool &workers) const
+{
+    if(threadCount > 0) {
+        workers.setMaxThreadCount(threadCount);
+    }
+}
@@ -0,0 +1,91 @@
+// File: batchjobhelper.h
+/*
+    Pep9Term is a  command line tool utility for assembling Pep/9 programs to
+    object code and executing object code programs.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef BATCHJOBHELPER_H
+#define BATCHJOBHELPER_H
+#include <QtCore>
+#include <QRunnable>
+
+/*
+ * The outcome of a single job executed by a BatchJobHelper.
+ * Each helper extends this with the files that describe its own jobs.
+ */
+struct BatchJob {
+    enum class Status {
+        // Ran means the job completed, but there was nothing to check it against.
+        NotRun, Ran, Passed, Failed, Error
+    } status = Status::NotRun;
+    // If the job did not pass, the reason why.
+    QString message = {};
+
+    // Name of a status as written to results files.
+    static QString statusToString(Status status);
+};
+
+// Number of jobs in a list which passed, failed, or could not be run.
+struct BatchJobCounts {
+    int passed = 0, failed = 0, errors = 0;
+
+    template<typename Job>
+    explicit BatchJobCounts(const QList<Job>& jobs);
+    // Summary for the console, e.g. "3 passed, 1 failed, 0 errors out of 4 programs."
+    QString toString(int total) const;
+};
+
+/*
+ * Base class of the helpers which execute many jobs in parallel on a pool of
+ * worker threads (i.e. batch, cpurun with multiple programs, and lockstep).
+ *
+ * When all jobs have completed and the results have been written,
+ * finished() will be emitted so that the application may shut down safely.
+ */
+class BatchJobHelper: public QObject, public QRunnable {
+    Q_OBJECT
+public:
+    explicit BatchJobHelper(QObject *parent = nullptr);
+    ~BatchJobHelper() override;
+
+    // Number of worker threads. If 0, use one thread per core.
+    void set_thread_count(int count);
+
+signals:
+    // Signal fired when all jobs have completed and the results have been written.
+    void finished();
+
+protected:
+    // Limit workers to the requested number of threads, if any.
+    void configurePool(QThreadPool& workers) const;
+
+private:
+    int threadCount = 0;
+};
+
+template<typename Job>
+BatchJobCounts::BatchJobCounts(const QList<Job> &jobs)
+{
+    for(const auto& job : jobs) {
+        switch(job.status) {
+        case BatchJob::Status::Passed: passed++; break;
+        case BatchJob::Status::Failed: failed++; break;
+        case BatchJob::Status::Error: errors++; break;
+        default: break;
+        }
+    }
+}
+#endif // BATCHJOBHELPER_H
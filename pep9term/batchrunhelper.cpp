@@ -0,0 +1,196 @@
+// File: batchrunhelper.cpp
+/*
+    Pep9Term is a  command line tool utility for assembling Pep/9 programs to
+    object code and executing object code programs.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "batchrunhelper.h"
+
+#include <iostream>
+
+#include "asmprogrammanager.h"
+#include "asmrunhelper.h"
+#include "termhelper.h"
+
+namespace {
+/*
+ * Runs a single job of a batch on a worker thread.
+ * The ASMRunHelper is created by the worker thread itself, so all of its IO
+ * is handled on the worker thread without involving the main event loop.
+ */
+class BatchJobRunner: public QRunnable
+{
+public:
+    BatchJobRunner(BatchRunHelper::Job& job, QSharedPointer<const ASMMachineSnapshot> machine,
+                   quint64 maxSimSteps, bool fast, AsmProgramManager& manager):
+        QRunnable(), job(job), machine(machine), maxSimSteps(maxSimSteps),
+        fast(fast), manager(manager)
+    {
+    }
+
+    void run() override
+    {
+        QFile objFile(job.objectFile.absoluteFilePath());
+        if(!objFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            job.status = BatchRunHelper::Job::Status::Error;
+            job.message = errLogOpenErr.arg(objFile.fileName());
+            return;
+        }
+        QTextStream objStream(&objFile);
+        QString objText = objStream.readAll();
+        objFile.close();
+
+        // Limit the lifetime of the helper, so that its output is flushed before it is compared.
+        {
+            ASMRunHelper helper(objText, maxSimSteps, job.outputFile, job.inputFile, manager);
+            helper.set_fast_execution(fast);
+            helper.set_machine_snapshot(machine);
+            try {
+                helper.run();
+            } catch (std::exception& e) {
+                job.status = BatchRunHelper::Job::Status::Error;
+                job.message = e.what();
+                return;
+            }
+            job.message = helper.get_error_message();
+        }
+
+        // If there is no expected output, there is nothing to compare against.
+        if(!job.expectedFile.exists()) {
+            job.status = BatchRunHelper::Job::Status::Ran;
+            return;
+        }
+        QFile expected(job.expectedFile.absoluteFilePath()), actual(job.outputFile.absoluteFilePath());
+        if(!expected.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            job.status = BatchRunHelper::Job::Status::Error;
+            job.message = errLogOpenErr.arg(expected.fileName());
+        }
+        else if(!actual.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            job.status = BatchRunHelper::Job::Status::Error;
+            job.message = errLogOpenErr.arg(actual.fileName());
+        }
+        else if(expected.readAll() == actual.readAll()) {
+            job.status = BatchRunHelper::Job::Status::Passed;
+        }
+        else {
+            job.status = BatchRunHelper::Job::Status::Failed;
+        }
+    }
+
+private:
+    // Each runner writes only to its own job, so no synchronization is required.
+    BatchRunHelper::Job& job;
+    QSharedPointer<const ASMMachineSnapshot> machine;
+    quint64 maxSimSteps;
+    bool fast;
+    AsmProgramManager& manager;
+};
+}
+
+BatchRunHelper::BatchRunHelper(QList<Job> jobs, QFileInfo resultsFile, quint64 maxSimSteps,
+                               AsmProgramManager &manager, QObject *parent):
+    BatchJobHelper(parent), jobs(jobs), resultsFile(resultsFile),
+    manager(manager), maxSimSteps(maxSimSteps)
+{
+
+}
+
+BatchRunHelper::~BatchRunHelper()
+{
+
+}
+
+bool BatchRunHelper::parseManifest(QString manifestText, QDir manifestDir, QFileInfo resultsFile,
+                                   QList<Job> &jobs, QString &errorMessage)
+{
+    QDir outputDir = resultsFile.absoluteDir();
+    QStringList lines = manifestText.split("\n");
+    for(int lineNumber = 0; lineNumber < lines.length(); lineNumber++) {
+        QString line = lines[lineNumber].trimmed();
+        // Skip blank lines and comments.
+        if(line.isEmpty() || line.startsWith("#")) continue;
+        QStringList fields = line.split(QRegularExpression("\\s+"));
+        if(fields.length() != 3) {
+            errorMessage = QString("Line %1 of the manifest must contain an object file, "
+                                   "an input file, and an expected output file.").arg(lineNumber + 1);
+            return false;
+        }
+        Job job;
+        job.objectFile = QFileInfo(manifestDir, fields[0]);
+        // A "-" denotes that there is no file. Use a file that can't exist.
+        job.inputFile = fields[1] == "-" ? QFileInfo() : QFileInfo(manifestDir, fields[1]);
+        job.expectedFile = fields[2] == "-" ? QFileInfo() : QFileInfo(manifestDir, fields[2]);
+        // Number output files by job, so that programs with the same name don't collide.
+        job.outputFile = QFileInfo(outputDir, QString("%1-%2.txt")
+                                   .arg(job.objectFile.completeBaseName())
+                                   .arg(jobs.length()));
+        jobs.append(job);
+    }
+    return true;
+}
+
+void BatchRunHelper::run()
+{
+    // Load the operating system once, and fork it for each job.
+    auto machine = ASMRunHelper::captureMachine(manager);
+
+    QThreadPool workers;
+    configurePool(workers);
+    for(auto& job : jobs) {
+        workers.start(new BatchJobRunner(job, machine, maxSimSteps, fast, manager));
+    }
+    workers.waitForDone();
+
+    writeResults();
+    emit finished();
+}
+
+void BatchRunHelper::set_fast_execution(bool fast)
+{
+    this->fast = fast;
+}
+
+void BatchRunHelper::writeResults()
+{
+    BatchJobCounts counts(jobs);
+    QJsonArray results;
+    for(auto job : jobs) {
+        QJsonObject result;
+        result["object"] = job.objectFile.filePath();
+        result["input"] = job.inputFile.filePath();
+        result["expected"] = job.expectedFile.filePath();
+        result["output"] = job.outputFile.filePath();
+        result["status"] = Job::statusToString(job.status);
+        result["message"] = job.message;
+        results.append(result);
+    }
+    QJsonObject summary;
+    summary["passed"] = counts.passed;
+    summary["failed"] = counts.failed;
+    summary["errors"] = counts.errors;
+    summary["results"] = results;
+
+    QFile output(resultsFile.absoluteFilePath());
+    if(!output.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        qDebug().noquote() << errLogOpenErr.arg(output.fileName());
+    }
+    else {
+        output.write(QJsonDocument(summary).toJson());
+        output.close();
+    }
+    std::cout << counts.toString(jobs.length()).toStdString() << std::endl;
+}
@@ -0,0 +1,85 @@
+// File: batchrunhelper.h
+/*
+    Pep9Term is a  command line tool utility for assembling Pep/9 programs to
+    object code and executing object code programs.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BATCHRUNHELPER_H
+#define BATCHRUNHELPER_H
+#include <QtCore>
+
+#include "batchjobhelper.h"
+
+class AsmProgramManager;
+
+/*
+ * This class is responsible for executing many assembly language programs.
+ * A manifest lists one job per line, each consisting of an object code file,
+ * a file to be buffered behind charIn, and a file containing the expected charOut.
+ * A "-" may be used in place of the input or expected output file if there is none.
+ *
+ * Jobs are executed in parallel by a pool of worker threads. Each job receives its
+ * own CPU and memory, which are forked from a single snapshot of the machine
+ * with the operating system loaded. The outcome of every job is written as JSON to
+ * the results file.
+ *
+ * When all jobs have completed, finished() will be emitted so that the application
+ * may shut down safely.
+ */
+class BatchRunHelper: public BatchJobHelper {
+    Q_OBJECT
+public:
+    // A single program listed in the manifest.
+    // The message holds the reason the job could not be run, or the CPU failed.
+    struct Job: BatchJob {
+        QFileInfo objectFile, inputFile, expectedFile;
+        // File to which the program's charOut will be written.
+        QFileInfo outputFile;
+    };
+
+    explicit BatchRunHelper(QList<Job> jobs, QFileInfo resultsFile, quint64 maxSimSteps,
+                            AsmProgramManager& manager, QObject *parent = nullptr);
+    ~BatchRunHelper() override;
+
+    // Parse the text of a manifest. Relative paths are resolved against manifestDir,
+    // and program output is written beside the results file.
+    // Returns false and sets errorMessage if any line is malformed.
+    static bool parseManifest(QString manifestText, QDir manifestDir, QFileInfo resultsFile,
+                              QList<Job>& jobs, QString& errorMessage);
+
+    // Pre: The operating system has been built and installed.
+    // Pre: The Pep9 mnemonic maps have been initizialized correctly, and will not be modified.
+    // Post:Every job has been run to completion, or terminated for taking too long.
+    // Post:The outcome of each job is written to resultsFile.
+    void run() override;
+
+    // Use the CPU's fast execution engine, which skips statistics & stack tracing.
+    void set_fast_execution(bool fast);
+
+private:
+    QList<Job> jobs;
+    QFileInfo resultsFile;
+    AsmProgramManager& manager;
+    // Maximum number of steps the simulator should execute for each job.
+    quint64 maxSimSteps;
+    // Control if the CPU uses its fast execution engine.
+    bool fast = false;
+
+    // Serialize the outcome of all jobs to resultsFile.
+    void writeResults();
+};
+#endif // BATCHRUNHELPER_H
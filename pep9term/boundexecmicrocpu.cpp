@@ -32,6 +32,8 @@ BoundExecMicroCpu::BoundExecMicroCpu(quint64 cycleCount, const AsmProgramManager
 {
     // This version of the CPU does not respond to breakpoints, and as such
     // does not register any handlers with the InterruptHandler.
+    // Nothing is waiting on an event loop while a headless simulation runs.
+    setYieldPolicy(QSharedPointer<NoYieldPolicy>::create());
 }
 
 BoundExecMicroCpu::~BoundExecMicroCpu()
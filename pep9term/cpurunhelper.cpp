@@ -223,6 +223,8 @@ void CPURunHelper::run()
         memory->insertChip(ramChip, 0);
 
         cpu = QSharedPointer<PartialMicrocodedCPU>::create(type, memory, nullptr);
+        // Nothing is waiting on an event loop while a headless simulation runs.
+        cpu->setYieldPolicy(QSharedPointer<NoYieldPolicy>::create());
     }
 
     // Clear & initialize all values in CPU before starting simulation.
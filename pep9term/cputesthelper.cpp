@@ -0,0 +1,323 @@
+// File: cputesthelper.cpp
+/*
+    Pep9Term is a  command line tool utility for assembling Pep/9 programs to
+    object code and executing object code programs.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "cputesthelper.h"
+
+#include <iostream>
+
+#include "amemorydevice.h"
+#include "asmprogrammanager.h"
+#include "boundexecmicrocpu.h"
+#include "cpubuildhelper.h"
+#include "cpudata.h"
+#include "flatmemory.h"
+#include "mainmemory.h"
+#include "memorychips.h"
+#include "microcode.h"
+#include "microcodeprogram.h"
+#include "partialmicrocodedcpu.h"
+#include "pep.h"
+#include "termhelper.h"
+
+namespace {
+/*
+ * Runs the unit tests of a single job on a worker thread.
+ * The CPU and memory are created by the worker thread itself, so that
+ * no simulation state is shared between jobs.
+ */
+class CPUTestRunner: public QRunnable
+{
+public:
+    CPUTestRunner(CPUTestHelper::Job& job, Enu::CPUType type,
+                  QSharedPointer<MicrocodeProgram> program,
+                  QSharedPointer<const MicrocodeProgram> testProgram,
+                  bool fullControl, quint64 maxCycles):
+        QRunnable(), job(job), type(type), program(program), testProgram(testProgram),
+        fullControl(fullControl), maxCycles(maxCycles)
+    {
+    }
+
+    void run() override
+    {
+        QElapsedTimer timer;
+        timer.start();
+        if(fullControl) {
+            // Flat memory defaults to 64k of RAM.
+            auto memory = QSharedPointer<FlatMemory>::create(nullptr);
+            // BoundExecMicroCpu does not yield to an event loop.
+            BoundExecMicroCpu cpu(maxCycles, AsmProgramManager::getInstance(), memory, nullptr);
+            test(cpu, *memory);
+        }
+        else {
+            // Assume memory will always be 64k.
+            auto memory = QSharedPointer<MainMemory>::create(nullptr);
+            QSharedPointer<RAMChip> ramChip(new RAMChip(1<<16, 0, memory.get()));
+            memory->insertChip(ramChip, 0);
+            PartialMicrocodedCPU cpu(type, memory, nullptr);
+            // Nothing is waiting on an event loop while a headless simulation runs.
+            cpu.setYieldPolicy(QSharedPointer<NoYieldPolicy>::create());
+            test(cpu, *memory);
+        }
+        job.milliseconds = timer.elapsed();
+    }
+
+private:
+    // Each runner writes only to its own job, so no synchronization is required.
+    CPUTestHelper::Job& job;
+    Enu::CPUType type;
+    QSharedPointer<MicrocodeProgram> program;
+    QSharedPointer<const MicrocodeProgram> testProgram;
+    bool fullControl;
+    quint64 maxCycles;
+
+    // Apply the unit pres, run the program, and check the unit posts on either CPU model.
+    template<typename CPU>
+    void test(CPU& cpu, AMemoryDevice& memory)
+    {
+        // Clear & initialize all values in CPU before starting simulation.
+        cpu.onResetCPU();
+        cpu.initCPU();
+        cpu.setMicrocodeProgram(program);
+
+        // Unit tests are only read while testing, so the lines of a shared
+        // preconditions program may be used by all jobs at once.
+        CPUDataSection* data = cpu.getDataSection().get();
+        for(auto line : testProgram->getObjectCode()) {
+            if(line->hasUnitPre()) {
+                static_cast<UnitPreCode*>(line)->setUnitPre(data, &memory);
+            }
+        }
+
+        // Make sure to set up any last minute flags needed by CPU to perform simulation.
+        cpu.onSimulationStarted();
+        if(!cpu.onRun()) {
+            job.status = CPUTestHelper::Job::Status::Error;
+            job.message = cpu.getErrorMessage();
+            return;
+        }
+        QStringList failures;
+        // Check every postcondition, so that all failures are reported at once.
+        for(auto line : testProgram->getObjectCode()) {
+            if(!line->hasUnitPost()) continue;
+            QString errorString;
+            if(!static_cast<UnitPostCode*>(line)->testPostcondition(data, &memory, errorString)) {
+                failures.append(errorString);
+            }
+        }
+        job.status = failures.isEmpty() ? CPUTestHelper::Job::Status::Passed
+                                        : CPUTestHelper::Job::Status::Failed;
+        job.message = failures.join("\n");
+    }
+};
+
+// Describe all errors in result, prefixed by the offending source line.
+QString assemblyErrors(const MicrocodeAssemblyResult& result, QString source)
+{
+    QStringList errors;
+    auto textList = source.split("\n");
+    for(auto errorPair : result.elist) {
+        errors.append(textList[errorPair.first] + errorPair.second);
+    }
+    return errors.join("\n");
+}
+
+// Program assembly can succeed despite the presence of errors in the
+// case of trace tag warnings. Must gaurd against this.
+bool assembledCleanly(const MicrocodeAssemblyResult& result)
+{
+    return result.success && !result.program.isNull() && result.elist.isEmpty();
+}
+}
+
+CPUTestHelper::CPUTestHelper(QList<Job> jobs, Enu::CPUType type,
+                             const QString preconditionsProgram, QFileInfo resultsFile,
+                             QObject *parent):
+    BatchJobHelper(parent), jobs(jobs), type(type),
+    preconditionsProgram(preconditionsProgram), resultsFile(resultsFile)
+{
+
+}
+
+CPUTestHelper::~CPUTestHelper()
+{
+
+}
+
+QList<CPUTestHelper::Job> CPUTestHelper::collectJobs(QStringList paths)
+{
+    QList<Job> jobs;
+    for(auto path : paths) {
+        QFileInfo info(path);
+        QList<QFileInfo> files;
+        if(info.isDir()) {
+            files = QDir(path).entryInfoList({"*.pepcpu"}, QDir::Files, QDir::Name);
+        }
+        else {
+            files.append(info);
+        }
+        for(auto file : files) {
+            Job job;
+            job.microcodeFile = file;
+            jobs.append(job);
+        }
+    }
+    return jobs;
+}
+
+void CPUTestHelper::run()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // If the preconditions program can't be assembled, no job may be tested.
+    QSharedPointer<const MicrocodeProgram> preconditions;
+    if(!preconditionsProgram.isEmpty()) {
+        auto result = buildMicroprogramHelper(type, fullControl, preconditionsProgram);
+        if(!assembledCleanly(result)) {
+            QString errorMessage = "Error(s) generated in precondition input.\n"
+                    + assemblyErrors(result, preconditionsProgram);
+            for(auto& job : jobs) {
+                job.status = Job::Status::Error;
+                job.message = errorMessage;
+            }
+            writeResults(timer.elapsed());
+            emit finished();
+            return;
+        }
+        preconditions = result.program;
+    }
+
+    QThreadPool workers;
+    configurePool(workers);
+    for(auto& job : jobs) {
+        QFile microcodeFile(job.microcodeFile.absoluteFilePath());
+        if(!microcodeFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            job.status = Job::Status::Error;
+            job.message = errLogOpenErr.arg(microcodeFile.fileName());
+            continue;
+        }
+        QTextStream microprogramStream(&microcodeFile);
+        // Must remove line numbers, or microassembler will raise spurious errors.
+        QString source = Pep::removeCycleNumbers(microprogramStream.readAll());
+        microcodeFile.close();
+
+        // Assemble on this thread while earlier jobs are already running,
+        // since the microassembler may not be used by multiple threads at once.
+        auto result = buildMicroprogramHelper(type, fullControl, source);
+        if(!assembledCleanly(result)) {
+            job.status = Job::Status::Error;
+            job.message = assemblyErrors(result, source);
+            continue;
+        }
+        QSharedPointer<const MicrocodeProgram> testProgram = preconditions.isNull() ? result.program : preconditions;
+        workers.start(new CPUTestRunner(job, type, result.program, testProgram, fullControl, maxCycles));
+    }
+    workers.waitForDone();
+
+    writeResults(timer.elapsed());
+    emit finished();
+}
+
+void CPUTestHelper::set_full_control(quint64 maxCycles)
+{
+    this->fullControl = true;
+    this->maxCycles = maxCycles;
+}
+
+void CPUTestHelper::writeResults(qint64 milliseconds)
+{
+    BatchJobCounts counts(jobs);
+
+    QFile output(resultsFile.absoluteFilePath());
+    if(!output.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        qDebug().noquote() << errLogOpenErr.arg(output.fileName());
+    }
+    else {
+        if(resultsFile.suffix().compare("xml", Qt::CaseInsensitive) == 0) {
+            writeJUnit(output, counts, milliseconds);
+        }
+        else {
+            writeJSON(output, counts);
+        }
+        output.close();
+    }
+    std::cout << counts.toString(jobs.length()).toStdString() << std::endl;
+}
+
+void CPUTestHelper::writeJSON(QIODevice &output, const BatchJobCounts &counts)
+{
+    QJsonArray results;
+    for(auto job : jobs) {
+        QJsonObject result;
+        result["microcode"] = job.microcodeFile.filePath();
+        result["status"] = Job::statusToString(job.status);
+        result["message"] = job.message;
+        result["milliseconds"] = job.milliseconds;
+        results.append(result);
+    }
+    QJsonObject summary;
+    summary["passed"] = counts.passed;
+    summary["failed"] = counts.failed;
+    summary["errors"] = counts.errors;
+    summary["results"] = results;
+    output.write(QJsonDocument(summary).toJson());
+}
+
+void CPUTestHelper::writeJUnit(QIODevice &output, const BatchJobCounts &counts, qint64 milliseconds)
+{
+    // JUnit reports durations in seconds.
+    auto seconds = [](qint64 ms){return QString::number(ms / 1000.0, 'f', 3);};
+    QXmlStreamWriter xml(&output);
+    xml.setAutoFormatting(true);
+    xml.writeStartDocument();
+    xml.writeStartElement("testsuite");
+    xml.writeAttribute("name", "cpurun");
+    xml.writeAttribute("tests", QString::number(jobs.length()));
+    xml.writeAttribute("failures", QString::number(counts.failed));
+    xml.writeAttribute("errors", QString::number(counts.errors));
+    xml.writeAttribute("time", seconds(milliseconds));
+    for(auto job : jobs) {
+        xml.writeStartElement("testcase");
+        xml.writeAttribute("name", job.microcodeFile.completeBaseName());
+        xml.writeAttribute("classname", job.microcodeFile.filePath());
+        xml.writeAttribute("time", seconds(job.milliseconds));
+        switch(job.status) {
+        case Job::Status::Failed:
+            xml.writeStartElement("failure");
+            xml.writeAttribute("message", "UnitPost failed.");
+            xml.writeCharacters(job.message);
+            xml.writeEndElement();
+            break;
+        case Job::Status::Error:
+            xml.writeStartElement("error");
+            xml.writeAttribute("message", job.message.section("\n", 0, 0));
+            xml.writeCharacters(job.message);
+            xml.writeEndElement();
+            break;
+        case Job::Status::NotRun:
+            xml.writeEmptyElement("skipped");
+            break;
+        default: break;
+        }
+        xml.writeEndElement();
+    }
+    xml.writeEndElement();
+    xml.writeEndDocument();
+}
@@ -0,0 +1,94 @@
+// File: cputesthelper.h
+/*
+    Pep9Term is a  command line tool utility for assembling Pep/9 programs to
+    object code and executing object code programs.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef CPUTESTHELPER_H
+#define CPUTESTHELPER_H
+#include <QtCore>
+
+#include "batchjobhelper.h"
+
+#include "enu.h"
+
+/*
+ * This class is responsible for executing the unit tests of many microcode programs
+ * using the Pep/9 CPU model, such as when grading a class's submissions.
+ *
+ * Each job is a single .pepcpu file. Its UnitPre statements are applied, the program is run,
+ * and its UnitPost statements are checked. As with CPURunHelper, if a preconditionsProgram
+ * is given, ONLY its unit tests are used, and those in each microcode program are ignored.
+ * Programs are run by the Pep9CPU model, or if full control is enabled, by the Pep9Micro
+ * model, which is stopped after a maximum number of cycles.
+ *
+ * The microassembler shares its regular expressions between all instances, so programs are
+ * assembled one at a time before any are run. Jobs are then executed in parallel by a pool of
+ * worker threads, and each job receives its own CPU, CPUDataSection, and memory.
+ * The outcome of every job is written to the results file, as JUnit XML if the file
+ * name ends in .xml, and as JSON otherwise.
+ *
+ * When all jobs have completed, finished() will be emitted so that the application
+ * may shut down safely.
+ */
+class CPUTestHelper: public BatchJobHelper {
+    Q_OBJECT
+public:
+    // A single microcode program to be tested.
+    // If the job failed, the message holds the failing postconditions.
+    // If the job could not be assembled, or the CPU failed, it holds the reason why.
+    struct Job: BatchJob {
+        QFileInfo microcodeFile;
+        // Time spent running the program and checking its unit tests.
+        qint64 milliseconds = 0;
+    };
+
+    explicit CPUTestHelper(QList<Job> jobs, Enu::CPUType type,
+                           const QString preconditionsProgram, QFileInfo resultsFile,
+                           QObject *parent = nullptr);
+    ~CPUTestHelper() override;
+
+    // Create one job for each path. Directories contribute every .pepcpu file
+    // they contain, in alphabetical order.
+    static QList<Job> collectJobs(QStringList paths);
+
+    // Pre: CPU type is either one or two byte.
+    // Pre: The Pep9 mnemonic maps have been initizialized correctly, and will not be modified.
+    // Pre: If present, preconditionsProgram does not contain line numbers.
+    // Post:Every job has been assembled, run, and evaluated by its unit tests.
+    // Post:The outcome of each job is written to resultsFile.
+    void run() override;
+
+    // Assemble and run programs with the full control section, aborting
+    // any program that executes more than maxCycles cycles.
+    // Pre: CPU type is two byte.
+    void set_full_control(quint64 maxCycles);
+
+private:
+    QList<Job> jobs;
+    Enu::CPUType type;
+    const QString preconditionsProgram;
+    QFileInfo resultsFile;
+    bool fullControl = false;
+    quint64 maxCycles = 0;
+
+    // Serialize the outcome of all jobs to resultsFile.
+    void writeResults(qint64 milliseconds);
+    void writeJSON(QIODevice& output, const BatchJobCounts& counts);
+    void writeJUnit(QIODevice& output, const BatchJobCounts& counts, qint64 milliseconds);
+};
+#endif // CPUTESTHELPER_H
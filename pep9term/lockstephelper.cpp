@@ -0,0 +1,361 @@
+// File: lockstephelper.cpp
+/*
+    Pep9Term is a  command line tool utility for assembling Pep/9 programs to
+    object code and executing object code programs.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "lockstephelper.h"
+
+#include <iostream>
+
+#include "amemorydevice.h"
+#include "asmprogrammanager.h"
+#include "asmrunhelper.h"
+#include "cpubuildhelper.h"
+#include "cpudata.h"
+#include "dirtybitmap.h"
+#include "flatmemory.h"
+#include "fullmicrocodedcpu.h"
+#include "isacpu.h"
+#include "microcodeprogram.h"
+#include "pep.h"
+#include "termhelper.h"
+#include "yieldpolicy.h"
+
+namespace {
+/*
+ * Records what one engine did to its memory during a single ISA instruction.
+ */
+class LockstepObserver: public AMemoryObserver
+{
+public:
+    LockstepObserver(FlatMemory& memory, quint16 charOut): memory(memory), charOut(charOut),
+        changed(), output()
+    {
+    }
+
+    void onMemoryChanged(quint16 address, quint8) override
+    {
+        changed.mark(address);
+    }
+
+    void onOutputWritten(quint16 address, quint8 value) override
+    {
+        if(address == charOut) output.append(static_cast<char>(value));
+    }
+
+    void onInputRequested(quint16 address) override
+    {
+        // All input is buffered before the program starts, so deny any further requests.
+        memory.onInputAborted(address);
+    }
+
+    FlatMemory& memory;
+    quint16 charOut;
+    // Addresses written or set since the last instruction boundary.
+    DirtyBitmap changed;
+    // Everything written to charOut since the program started.
+    QByteArray output;
+};
+
+QString hex(quint16 value, int width = 4)
+{
+    return "0x" + QString("%1").arg(value, width, 16, QLatin1Char('0')).toUpper();
+}
+
+/*
+ * Checks a single program on a worker thread. Both CPUs and memories are created
+ * by the worker thread itself, and are forked from the shared machine snapshot.
+ */
+class LockstepJobRunner: public QRunnable
+{
+public:
+    LockstepJobRunner(LockstepHelper::Job& job, QSharedPointer<const ASMMachineSnapshot> machine,
+                      QSharedPointer<MicrocodeProgram> microprogram, quint64 maxSimSteps, bool fuse,
+                      AsmProgramManager& manager):
+        QRunnable(), job(job), machine(machine), microprogram(microprogram),
+        maxSimSteps(maxSimSteps), fuse(fuse), manager(manager)
+    {
+    }
+
+    void run() override
+    {
+        QFile objFile(job.objectFile.absoluteFilePath());
+        if(!objFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            job.status = LockstepHelper::Job::Status::Error;
+            job.message = errLogOpenErr.arg(objFile.fileName());
+            return;
+        }
+        QTextStream objStream(&objFile);
+        auto objCode = convertObjectCodeToIntArray(objStream.readAll());
+        objFile.close();
+
+        // Fork both machines from the snapshot. Only the user program must be loaded.
+        auto isaMemory = QSharedPointer<FlatMemory>::create(nullptr);
+        auto microMemory = QSharedPointer<FlatMemory>::create(nullptr);
+        for(auto memory : {isaMemory, microMemory}) {
+            memory->restore(machine->memory);
+            memory->loadValues(0, objCode);
+            // Programs are given no input, so buffer a newline like pep9term run does.
+            memory->onInputReceived(machine->charIn, QString("\n"));
+        }
+        LockstepObserver isaObserver(*isaMemory, machine->charOut);
+        LockstepObserver microObserver(*microMemory, machine->charOut);
+
+        IsaCpu isa(&manager, isaMemory);
+        FullMicrocodedCPU micro(&manager, microMemory);
+        isa.setYieldPolicy(QSharedPointer<NoYieldPolicy>::create());
+        micro.setYieldPolicy(QSharedPointer<NoYieldPolicy>::create());
+
+        isa.onResetCPU();
+        isa.getRegisterBank() = machine->registers;
+        micro.setMicrocodeProgram(microprogram);
+        micro.setBlockFusion(fuse);
+        micro.onResetCPU();
+        micro.initCPU();
+        // The microcoded CPU has more registers than the ISA level one, so only
+        // copy those that are visible to the instruction set.
+        RegisterFile& microRegisters = micro.getDataSection()->getRegisterBank();
+        for(auto reg : {Enu::CPURegisters::A, Enu::CPURegisters::X,
+                        Enu::CPURegisters::SP, Enu::CPURegisters::PC}) {
+            microRegisters.writeRegisterWord(reg, machine->registers.readRegisterWordCurrent(reg));
+        }
+        microRegisters.writeStatusBits(machine->registers.readStatusBitsCurrent());
+        microRegisters.flattenFile();
+
+        isa.onSimulationStarted();
+        micro.onSimulationStarted();
+        // Register after the CPUs are initialized, so that only program execution is observed.
+        isaMemory->addObserver(&isaObserver);
+        microMemory->addObserver(&microObserver);
+
+        job.status = LockstepHelper::Job::Status::Passed;
+        while(job.instructions < maxSimSteps) {
+            quint16 pc = isa.getCPURegWordCurrent(Enu::CPURegisters::PC);
+            isa.stepInto();
+            micro.stepInto();
+            QString difference = compare(isa, micro, isaObserver, microObserver);
+            if(!difference.isEmpty()) {
+                job.status = LockstepHelper::Job::Status::Failed;
+                job.message = QString("Instruction %1 at %2: %3").arg(job.instructions + 1)
+                        .arg(hex(pc)).arg(difference);
+                break;
+            }
+            job.instructions++;
+            if(isa.hadErrorOnStep()) {
+                job.message = "Both engines failed: " + isa.getErrorMessage();
+                break;
+            }
+            else if(isa.getExecutionFinished()) {
+                break;
+            }
+            isaObserver.changed.clear();
+            microObserver.changed.clear();
+        }
+        if(job.status == LockstepHelper::Job::Status::Passed && job.instructions == maxSimSteps) {
+            job.message = QString("Stopped after %1 instructions.").arg(maxSimSteps);
+        }
+
+        isaMemory->removeObserver(&isaObserver);
+        microMemory->removeObserver(&microObserver);
+    }
+
+private:
+    // Each runner writes only to its own job, so no synchronization is required.
+    LockstepHelper::Job& job;
+    QSharedPointer<const ASMMachineSnapshot> machine;
+    QSharedPointer<MicrocodeProgram> microprogram;
+    quint64 maxSimSteps;
+    bool fuse;
+    AsmProgramManager& manager;
+
+    // Returns a description of the first difference between the two engines,
+    // or an empty string if they agree.
+    static QString compare(const ACPUModel& isa, const ACPUModel& micro,
+                           const LockstepObserver& isaObserver, const LockstepObserver& microObserver)
+    {
+        if(isa.hadErrorOnStep() != micro.hadErrorOnStep()) {
+            return QString("only the %1 engine failed: %2")
+                    .arg(isa.hadErrorOnStep() ? "ISA" : "microcode")
+                    .arg(isa.hadErrorOnStep() ? isa.getErrorMessage() : micro.getErrorMessage());
+        }
+        if(isa.getExecutionFinished() != micro.getExecutionFinished()) {
+            return QString("only the %1 engine finished execution.")
+                    .arg(isa.getExecutionFinished() ? "ISA" : "microcode");
+        }
+        // If both engines failed, their registers are not required to agree.
+        if(isa.hadErrorOnStep()) return "";
+
+        quint8 isaIS = isa.getCPURegByteCurrent(Enu::CPURegisters::IS);
+        quint8 microIS = micro.getCPURegByteCurrent(Enu::CPURegisters::IS);
+        if(isaIS != microIS) {
+            return QString("IS differs, ISA=%1 microcode=%2.").arg(hex(isaIS, 2)).arg(hex(microIS, 2));
+        }
+        static const QList<QPair<Enu::CPURegisters, QString>> wordRegisters = {
+            {Enu::CPURegisters::A, "A"}, {Enu::CPURegisters::X, "X"},
+            {Enu::CPURegisters::SP, "SP"}, {Enu::CPURegisters::PC, "PC"},
+            {Enu::CPURegisters::OS, "OS"},
+        };
+        // The microcode only loads the OS for non-unary instructions. At the hardware
+        // level, all traps are unary, so the microcode does not load it for traps either.
+        Enu::EMnemonic mnemon = Pep::decodeMnemonic.value(isaIS);
+        bool hasOperand = !Pep::isUnaryMap.value(mnemon) && !Pep::isTrapMap.value(mnemon);
+        for(auto reg : wordRegisters) {
+            if(reg.first == Enu::CPURegisters::OS && !hasOperand) continue;
+            quint16 isaValue = isa.getCPURegWordCurrent(reg.first);
+            quint16 microValue = micro.getCPURegWordCurrent(reg.first);
+            if(isaValue != microValue) {
+                return QString("%1 differs, ISA=%2 microcode=%3.")
+                        .arg(reg.second).arg(hex(isaValue)).arg(hex(microValue));
+            }
+        }
+        static const QList<QPair<Enu::EStatusBit, QString>> statusBits = {
+            {Enu::STATUS_N, "N"}, {Enu::STATUS_Z, "Z"}, {Enu::STATUS_V, "V"}, {Enu::STATUS_C, "C"},
+        };
+        for(auto bit : statusBits) {
+            if(isa.getStatusBitCurrent(bit.first) != micro.getStatusBitCurrent(bit.first)) {
+                return QString("%1 bit differs, ISA=%2 microcode=%3.").arg(bit.second)
+                        .arg(isa.getStatusBitCurrent(bit.first))
+                        .arg(micro.getStatusBitCurrent(bit.first));
+            }
+        }
+
+        // Only lines of memory touched by either engine are visited. Addresses modified
+        // by both engines are checked twice, which is cheaper than merging the bitmaps.
+        QString memoryDifference;
+        auto compareAddress = [&](quint16 address) {
+            if(!memoryDifference.isEmpty()) return;
+            bool isaWrote = isaObserver.changed.isDirty(address);
+            bool microWrote = microObserver.changed.isDirty(address);
+            quint8 isaValue = 0, microValue = 0;
+            isaObserver.memory.getByte(address, isaValue);
+            microObserver.memory.getByte(address, microValue);
+            if(isaWrote != microWrote) {
+                memoryDifference = QString("only the %1 engine modified Mem[%2].")
+                        .arg(isaWrote ? "ISA" : "microcode").arg(hex(address));
+            }
+            else if(isaValue != microValue) {
+                memoryDifference = QString("Mem[%1] differs, ISA=%2 microcode=%3.")
+                        .arg(hex(address)).arg(hex(isaValue, 2)).arg(hex(microValue, 2));
+            }
+        };
+        isaObserver.changed.forEachAddress(compareAddress);
+        microObserver.changed.forEachAddress(compareAddress);
+        if(!memoryDifference.isEmpty()) return memoryDifference;
+
+        if(isaObserver.output != microObserver.output) {
+            return "charOut differs.";
+        }
+        return "";
+    }
+};
+}
+
+LockstepHelper::LockstepHelper(QList<Job> jobs, QString microcodeProgram, QFileInfo resultsFile,
+                               quint64 maxSimSteps, AsmProgramManager &manager, QObject *parent):
+    BatchJobHelper(parent), jobs(jobs), microcodeProgram(microcodeProgram),
+    resultsFile(resultsFile), manager(manager), maxSimSteps(maxSimSteps)
+{
+
+}
+
+LockstepHelper::~LockstepHelper()
+{
+
+}
+
+QList<LockstepHelper::Job> LockstepHelper::collectCorpus(QDir directory)
+{
+    QList<Job> jobs;
+    for(auto file : directory.entryInfoList({"*.pepo"}, QDir::Files, QDir::Name)) {
+        Job job;
+        job.objectFile = file;
+        jobs.append(job);
+    }
+    return jobs;
+}
+
+void LockstepHelper::run()
+{
+    // Assemble the microprogram once, and share it between all of the microcoded CPUs.
+    auto result = buildMicroprogramHelper(Enu::CPUType::TwoByteDataBus, true, microcodeProgram);
+    if(!result.success || result.program.isNull() || !result.elist.isEmpty()) {
+        QString errorMessage = "Error(s) generated in microcode input.";
+        auto textList = microcodeProgram.split("\n");
+        for(auto errorPair : result.elist) {
+            errorMessage += "\n" + textList[errorPair.first] + errorPair.second;
+        }
+        qDebug().noquote() << errorMessage;
+        writeResults(errorMessage);
+        emit finished();
+        return;
+    }
+
+    // Load the operating system once, and fork it for both engines of every job.
+    auto machine = ASMRunHelper::captureMachine(manager);
+
+    QThreadPool workers;
+    configurePool(workers);
+    for(auto& job : jobs) {
+        workers.start(new LockstepJobRunner(job, machine, result.program, maxSimSteps, fuse, manager));
+    }
+    workers.waitForDone();
+
+    writeResults("");
+    emit finished();
+}
+
+void LockstepHelper::set_block_fusion(bool fuse)
+{
+    this->fuse = fuse;
+}
+
+void LockstepHelper::writeResults(QString errorMessage)
+{
+    BatchJobCounts counts(jobs);
+    QJsonArray results;
+    for(auto job : jobs) {
+        QJsonObject result;
+        result["object"] = job.objectFile.filePath();
+        result["status"] = Job::statusToString(job.status);
+        result["instructions"] = static_cast<qint64>(job.instructions);
+        result["message"] = job.message;
+        results.append(result);
+    }
+    QJsonObject summary;
+    summary["passed"] = counts.passed;
+    summary["failed"] = counts.failed;
+    summary["errors"] = counts.errors;
+    if(!errorMessage.isEmpty()) {
+        summary["message"] = errorMessage;
+    }
+    summary["results"] = results;
+
+    QFile output(resultsFile.absoluteFilePath());
+    if(!output.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        qDebug().noquote() << errLogOpenErr.arg(output.fileName());
+    }
+    else {
+        output.write(QJsonDocument(summary).toJson());
+        output.close();
+    }
+    std::cout << counts.toString(jobs.length()).toStdString() << std::endl;
+    for(auto job : jobs) {
+        if(job.status != Job::Status::Failed) continue;
+        std::cout << QString("%1: %2").arg(job.objectFile.fileName(), job.message).toStdString() << std::endl;
+    }
+}
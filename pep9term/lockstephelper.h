@@ -0,0 +1,87 @@
+// File: lockstephelper.h
+/*
+    Pep9Term is a  command line tool utility for assembling Pep/9 programs to
+    object code and executing object code programs.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef LOCKSTEPHELPER_H
+#define LOCKSTEPHELPER_H
+#include <QtCore>
+
+#include "batchjobhelper.h"
+
+class AsmProgramManager;
+
+/*
+ * This class is responsible for checking that a microprogram implements the Pep/9
+ * instruction set the same way the ISA level simulator does.
+ *
+ * Each object code program is executed by an IsaCpu and a FullMicrocodedCPU in lockstep.
+ * After every ISA instruction, the ISA visible registers, the status bits, the addresses
+ * each engine modified during the instruction, and the values at those addresses are
+ * compared. The first disagreement is reported, and that program's simulation is stopped.
+ * A program passes if the engines agree on every instruction, and fails if they diverge.
+ *
+ * Programs are checked in parallel by a pool of worker threads. Both engines of every
+ * program are forked from a single snapshot of the machine with the operating system loaded.
+ * The outcome of every program is written as JSON to the results file.
+ *
+ * When all programs have been checked, finished() will be emitted so that the application
+ * may shut down safely.
+ */
+class LockstepHelper: public BatchJobHelper {
+    Q_OBJECT
+public:
+    // A single program to be checked.
+    // The message describes the divergence, or the reason the program could not be checked.
+    struct Job: BatchJob {
+        QFileInfo objectFile;
+        // Number of ISA instructions on which both engines agreed.
+        quint64 instructions = 0;
+    };
+
+    // microcodeProgram must not contain cycle numbers.
+    explicit LockstepHelper(QList<Job> jobs, QString microcodeProgram, QFileInfo resultsFile,
+                            quint64 maxSimSteps, AsmProgramManager& manager, QObject *parent = nullptr);
+    ~LockstepHelper() override;
+
+    // Create a job for every object code (.pepo) file in directory, in alphabetical order.
+    static QList<Job> collectCorpus(QDir directory);
+
+    // Pre: The operating system has been built and installed.
+    // Pre: The Pep9 mnemonic maps have been initizialized correctly, and will not be modified.
+    // Pre: The microcode maps have been initialized for a two byte data bus with the full control section.
+    // Post:Every job has been checked, or terminated for taking too long.
+    // Post:The outcome of each job is written to resultsFile.
+    void run() override;
+
+    // Let the microcoded CPU fuse straight-line microcode, so that the fused engine is checked.
+    void set_block_fusion(bool fuse);
+
+private:
+    QList<Job> jobs;
+    QString microcodeProgram;
+    QFileInfo resultsFile;
+    AsmProgramManager& manager;
+    // Maximum number of ISA instructions to check for each job.
+    quint64 maxSimSteps;
+    bool fuse = false;
+
+    // Serialize the outcome of all jobs to resultsFile.
+    void writeResults(QString errorMessage);
+};
+#endif // LOCKSTEPHELPER_H
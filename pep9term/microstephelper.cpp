@@ -23,15 +23,16 @@
 #include "amemorychip.h"
 #include "amemorydevice.h"
 #include "asmprogrammanager.h"
+#include "asmrunhelper.h"
 #include "boundexecmicrocpu.h"
 #include "cpubuildhelper.h"
 #include "cpudata.h"
-#include "mainmemory.h"
-#include "memorychips.h"
+#include "flatmemory.h"
 #include "microcode.h"
 #include "symbolentry.h"
 #include "symboltable.h"
 #include "termhelper.h"
+#include "termioobserver.h"
 
 MicroStepHelper::MicroStepHelper(const quint64 maxCycleCount,
                                  const QString microcodeProgram,
@@ -43,7 +44,7 @@ MicroStepHelper::MicroStepHelper(const quint64 maxCycleCount,
     preconditionsProgram(preconditionsProgram),
     // Explicitly initialize both simulation objects to nullptr,
     // so that it is clear to that neither object has been allocated
-    memory(nullptr), cpu(nullptr)//, outputFile(nullptr)
+    memory(nullptr), cpu(nullptr), io(nullptr)
 
 {
     // Default error log name to the base name of the file with an _errLog.txt extension.
@@ -53,21 +54,14 @@ MicroStepHelper::MicroStepHelper(const quint64 maxCycleCount,
 
 MicroStepHelper::~MicroStepHelper()
 {
-    // If we allocated an output file, we need to perform special work to free it.
-    /*if(outputFile != nullptr) {
-        outputFile->flush();
-        // It might seem like we should close the file here, but it causes read / write violations to do so.
-        // Instead, delete it later under the assumption that the operating system will handle that for us.
-        // Schedule the output file for deletion via the event loop.
-        outputFile->deleteLater();
-    }*/
+
 }
 
 void MicroStepHelper::onSimulationFinished()
 {
-    // There migh be outstanding IO events. Give them a chance to finish
-    // before initiating shutdown.
-    QCoreApplication::processEvents();
+    // Output is written synchronously by the simulation thread, so there are no
+    // outstanding IO events, and flushing the output file is sufficient.
+    io->flush();
     emit finished();
 }
 
@@ -75,14 +69,9 @@ void MicroStepHelper::runProgram()
 {
     // Open up program output file if possible.
     // If output can't be opened up, abort.
-    /*QFile *output = QFile(error_log.absoluteFilePath());
-    if(!output->open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
-        qDebug().noquote() << errLogOpenErr.arg(output->fileName());
-        throw std::logic_error("Can't open output file.");
-    } else {
-        // If it could be opened, map charOut to the file.
-        outputFile = output;
-    }*/
+    if(!objectCodeString.isEmpty() && !programOutput.filePath().isEmpty()) {
+        io->open_output(programOutput);
+    }
 
     // Make sure to set up any last minute flags needed by CPU to perform simulation.
     cpu->onSimulationStarted();
@@ -132,14 +121,15 @@ void MicroStepHelper::runProgram()
 
 }
 
-void MicroStepHelper::assembleMicrocode()
+bool MicroStepHelper::assembleMicrocode()
 {
 
     // Construct files that will be needed for assembly
     QFile errorLog(QFileInfo(microcodeProgramFile).absoluteDir().absoluteFilePath(
                        QFileInfo(microcodeProgramFile).baseName() + "_errLog.txt"));
 
-    auto programResult = buildMicroprogramHelper(Enu::CPUType::TwoByteDataBus, false,
+    // The Pep9Micro CPU always has the full control section.
+    auto programResult = buildMicroprogramHelper(Enu::CPUType::TwoByteDataBus, true,
                                           microcodeProgram);
     MicrocodeAssemblyResult preconditionResult;
     // If there were errors assembling input program, attempt to write all of
@@ -173,12 +163,11 @@ void MicroStepHelper::assembleMicrocode()
     }
     else {
         qDebug() << "Error(s) generated in microcode input. See error log.";
-        emit finished();
-        return;
+        return false;
     }
 
     if(!preconditionsProgram.isEmpty()) {
-        preconditionResult = buildMicroprogramHelper(Enu::CPUType::TwoByteDataBus, false,
+        preconditionResult = buildMicroprogramHelper(Enu::CPUType::TwoByteDataBus, true,
                                               preconditionsProgram);
         // If there were errors processing precondition microcode program,
         // attempt to write all of them to the error file.
@@ -214,8 +203,7 @@ void MicroStepHelper::assembleMicrocode()
         }
         else {
             qDebug() << "Error(s) generated in precondition input. See error log.";
-            emit finished();
-            return;
+            return false;
         }
     }
     // If no preconditions program was present, apply preconditions
@@ -223,6 +211,7 @@ void MicroStepHelper::assembleMicrocode()
     else {
         preconditionProgram = programResult.program;
     }
+    return true;
 }
 
 void MicroStepHelper::run()
@@ -231,35 +220,32 @@ void MicroStepHelper::run()
     // Construct all needed simulation objects in run, so that the owning
     // thread is the one doing the computation, not the main thread.
     if(memory.isNull()) {
-        // Assume memory will always be 64k.
-        memory = QSharedPointer<MainMemory>::create(nullptr);
-        QSharedPointer<RAMChip> ramChip(new RAMChip(1<<16, 0, memory.get()));
-        memory->insertChip(ramChip, 0);
-
+        // Flat memory defaults to 64k of RAM.
+        memory = QSharedPointer<FlatMemory>::create(nullptr);
 
         cpu = QSharedPointer<BoundExecMicroCpu>::create(maxStepCount,
                                                         AsmProgramManager::getInstance(),
                                                         memory, nullptr);
+
+        // IO *MUST* complete before execution moves forward. Observers are called
+        // synchronously by the thread running the simulation.
+        io.reset(new TermIOObserver(*memory));
+        memory->addObserver(io.data());
     }
+    io->set_echo_charout(echo);
 
     // Clear & initialize all values in CPU before starting simulation.
     cpu->onResetCPU();
     cpu->initCPU();
 
-    // Instead of directly allowing run() to kill itself, uses events to "schedule"
-    // shutting down the application. This should ensure all IO completes. We were
-    // having an error where closing IO streams directly after simulation completion would
-    // cause a race condition with IO pending for the file. The overhead of the simulation events
-    // seems to "serialize" writes / closing.
-    connect(cpu.get(), &FullMicrocodedCPU::simulationFinished,
-            this, &MicroStepHelper::onSimulationFinished);
-
-    assembleMicrocode();
+    if(!assembleMicrocode()) {
+        emit finished();
+        return;
+    }
     loadAncilliaryData();
     runProgram();
-
-    // Make sure any outstanding events are handled.
-    QCoreApplication::processEvents();
+    // All IO completed on this thread while the program ran, so shutdown may begin.
+    onSimulationFinished();
 }
 
 void MicroStepHelper::set_error_file(QString error_file)
@@ -267,8 +253,56 @@ void MicroStepHelper::set_error_file(QString error_file)
     this->error_log = error_file;
 }
 
+void MicroStepHelper::set_object_code(QString objectCodeString)
+{
+    this->objectCodeString = objectCodeString;
+}
+
+void MicroStepHelper::set_program_input(QFileInfo programInput)
+{
+    this->programInput = programInput;
+}
+
+void MicroStepHelper::set_program_output(QFileInfo programOutput)
+{
+    this->programOutput = programOutput;
+}
+
+void MicroStepHelper::set_echo_charout(bool echo)
+{
+    this->echo = echo;
+}
+
+void MicroStepHelper::loadObjectCode()
+{
+    // Start from a machine that only has the operating system loaded.
+    auto machine = ASMRunHelper::captureMachine(*AsmProgramManager::getInstance());
+    memory->restore(machine->memory);
+    io->set_char_out(machine->charOut);
+    memory->loadValues(0, convertObjectCodeToIntArray(objectCodeString));
+
+    // If there is not input, append a newline so that there is a least one character buffered.
+    QFile input(programInput.absoluteFilePath());
+    if(programInput.filePath().isEmpty() || !programInput.exists()) {
+        memory->onInputReceived(machine->charIn, QString("\n"));
+    }
+    else if(!input.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qDebug().noquote() << errLogOpenErr.arg(input.fileName());
+        throw std::logic_error("Can't open input file.");
+    } else {
+        QTextStream inputStream(&input);
+        memory->onInputReceived(machine->charIn, inputStream.readAll() % "\n");
+        input.close();
+    }
+}
+
 void MicroStepHelper::loadAncilliaryData()
 {
+    // The microprogram's own initialization code reads the stack pointer
+    // from the operating system's memory vectors, so only memory must be set up.
+    if(!objectCodeString.isEmpty()) {
+        loadObjectCode();
+    }
     // Having selected preconditons, apply them.
     CPUDataSection* data = cpu->getDataSection().get();
     AMemoryDevice* memory = this->memory.get();
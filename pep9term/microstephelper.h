@@ -24,13 +24,15 @@
 #include <QFileInfo>
 #include <QObject>
 #include <QRunnable>
+#include <QScopedPointer>
 #include <QSharedPointer>
 
 #include "enu.h"
 
 class BoundExecMicroCpu;
-class MainMemory;
+class FlatMemory;
 class MicrocodeProgram;
+class TermIOObserver;
 
 /*
  * This class is responsible for executing a single microcode program using
@@ -49,6 +51,11 @@ class MicrocodeProgram;
  *
  * If unit tests are succesful, "success" will be written to programOutput
  *
+ * Optionally an object code program may be set, in which case the operating system
+ * is burned into memory, the object code is loaded at address 0, and the microprogram
+ * executes the complete machine. programInput is buffered behind charIn, and anything
+ * written to charOut is written to programOutput.
+ *
  * When the simulation finishes running, or is terminated internally for taking too
  * long, finished() will be emitted so that the application may shut down safely.
  */
@@ -70,8 +77,8 @@ signals:
 
 public:
     void onSimulationFinished();
-    // Pre: All computations an outstanding processing events have been finished.
-    // Post:The main thread has been signaled to shutdown.
+    // Pre: All computations have been finished.
+    // Post:Program output has been flushed, and the main thread has been signaled to shutdown.
 
     void run() override;
     // Pre: The Pep9 mnemonic maps have been initizialized correctly.
@@ -87,6 +94,16 @@ public:
     // error file path.
     void set_error_file(QString error_file);
 
+    // Run objectCodeString (00 01 .. FF zz) on top of the operating system.
+    // Pre: The operating system has been built and installed.
+    void set_object_code(QString objectCodeString);
+    // File buffered behind charIn. Ignored if it does not exist.
+    void set_program_input(QFileInfo programInput);
+    // File to which charOut is written.
+    void set_program_output(QFileInfo programOutput);
+    // Echo the values written to CharOut to the console.
+    void set_echo_charout(bool echo);
+
 protected:
     // Used to load any additional data by the program, such as assembly code
     // and OS, or unit pre conditions.
@@ -98,6 +115,11 @@ private:
    QFileInfo microcodeProgramFile;
    const QString preconditionsProgram;
    QFileInfo error_log;
+   // If empty, only the microprogram is run.
+   QString objectCodeString;
+   QFileInfo programInput, programOutput;
+   // Control if the values written to CharOut get echoed to the console.
+   bool echo = false;
 
    // Runnable will be executed in a separate thread, all objects being pointed to
    // must be constructed in this thread. The object is constructed in the main thread
@@ -105,13 +127,14 @@ private:
    // such as the CPU or memory, in run(), since run exectues in the context of the
    // worker thread. This is important for correct parenting of child QObjects.
 
-   // Memory device used by simulation.
-   QSharedPointer<MainMemory> memory;
+   // Memory device used by simulation. No UI is attached, so use the
+   // flat memory device rather than one composed of chips.
+   QSharedPointer<FlatMemory> memory;
    // The CPU simulator that will perform the computation
    QSharedPointer<BoundExecMicroCpu> cpu;
 
-   // Potentially multiple output sources, but don't take time to simulate now.
-   //QFile* outputFile;
+   // Handles memory mapped IO, and owns the file to which charOut is written.
+   QScopedPointer<TermIOObserver> io;
 
    // Pointer to the MicrocodeProgram that should be searched for unit pres
    // and unit posts.
@@ -121,12 +144,16 @@ private:
    // loaded microprogram, and has already had unit preconditions applied.
    void runProgram();
 
-   // Assemble the microcode program, and signal for termination if it fails.
+   // Assemble the microcode program, and return false if it fails.
    // Additionally, if precondition program is non-empty, assemble, and set
    // preconditionProgram to the result of assembly.
    // If precondition program is not present preconditionProgram is set to
    // main microcode program input.
-   void assembleMicrocode();
+   bool assembleMicrocode();
+
+   // Burn the operating system into memory, load the object code program,
+   // and buffer programInput behind charIn.
+   void loadObjectCode();
 
 };
 
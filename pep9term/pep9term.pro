@@ -45,11 +45,16 @@ DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs depr
 SOURCES += \
     asmbuildhelper.cpp \
     asmrunhelper.cpp \
+    batchjobhelper.cpp \
+    batchrunhelper.cpp \
     boundexecmicrocpu.cpp \
     cpubuildhelper.cpp \
     cpurunhelper.cpp \
+    cputesthelper.cpp \
+    lockstephelper.cpp \
     microstephelper.cpp \
     termhelper.cpp \
+    termioobserver.cpp \
     boundexecisacpu.cpp \
     termmain.cpp
 
@@ -61,13 +66,18 @@ else: unix:!android: target.path = /opt/$${TARGET}/bin
 HEADERS += \
     asmbuildhelper.h \
     asmrunhelper.h \
+    batchjobhelper.h \
+    batchrunhelper.h \
     boundexecmicrocpu.h \
     cpubuildhelper.h \
     cpurunhelper.h \
+    cputesthelper.h \
     CLI11.hpp \
+    lockstephelper.h \
     microstephelper.h \
     termformatter.h \
     termhelper.h \
+    termioobserver.h \
     boundexecisacpu.h
 
 RESOURCES += \
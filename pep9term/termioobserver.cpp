@@ -0,0 +1,101 @@
+// File: termioobserver.cpp
+/*
+    Pep9Term is a  command line tool utility for assembling Pep/9 programs to
+    object code and executing object code programs.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include "termioobserver.h"
+
+#include <iostream>
+#include <stdexcept>
+
+#include <QDebug>
+#include <QTextStream>
+
+#include "flatmemory.h"
+#include "termhelper.h"
+
+TermIOObserver::TermIOObserver(FlatMemory &memory): memory(memory), outputFile(nullptr)
+{
+
+}
+
+TermIOObserver::~TermIOObserver()
+{
+    // Runnables execute on pool threads that have no event loop, so the output
+    // file must be closed here rather than scheduled for deletion via deleteLater().
+    if(!outputFile.isNull()) {
+        outputFile->close();
+    }
+}
+
+void TermIOObserver::onInputRequested(quint16 address)
+{
+    // All the input a program will ever receive is loaded into the memory
+    // buffer as the program is started. So we can't satisfy the IO request,
+    // and thus we need to signal the simulation that the IO request was denied.
+    memory.onInputAborted(address);
+}
+
+void TermIOObserver::onOutputWritten(quint16 address, quint8 value)
+{
+    // We do not currently support memory mapped output
+    // other than the charOut.
+    if(!hasCharOut || address != charOut) return;
+    if(!outputFile.isNull()) {
+        // Use a temporary (anonymous) text stream to make writing easy.
+        QTextStream (outputFile.data()) << QChar(value);
+        // Try to block and make sure the IO actually completes.
+        outputFile->waitForBytesWritten(300);
+    }
+    if(echo) {
+        std::cout << static_cast<char>(value);
+    }
+}
+
+void TermIOObserver::set_char_out(quint16 address)
+{
+    this->charOut = address;
+    this->hasCharOut = true;
+}
+
+void TermIOObserver::set_echo_charout(bool echo)
+{
+    this->echo = echo;
+}
+
+void TermIOObserver::open_output(QFileInfo file)
+{
+    // If the file could be opened, charOut is mapped to it.
+    outputFile.reset(new QFile(file.absoluteFilePath()));
+    if(!outputFile->open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        qDebug().noquote() << errLogOpenErr.arg(outputFile->fileName());
+        outputFile.reset();
+        throw std::logic_error("Can't open output file.");
+    }
+}
+
+QFile *TermIOObserver::get_output() const
+{
+    return outputFile.data();
+}
+
+void TermIOObserver::flush()
+{
+    if(!outputFile.isNull()) {
+        outputFile->flush();
+    }
+}
@@ -0,0 +1,72 @@
+// File: termioobserver.h
+/*
+    Pep9Term is a  command line tool utility for assembling Pep/9 programs to
+    object code and executing object code programs.
+
+    Copyright (C) 2019  J. Stanley Warford & Matthew McRaven, Pepperdine University
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef TERMIOOBSERVER_H
+#define TERMIOOBSERVER_H
+
+#include <QFile>
+#include <QFileInfo>
+#include <QScopedPointer>
+
+#include "amemorydevice.h"
+
+class FlatMemory;
+
+/*
+ * Services the memory mapped IO of a program run from the terminal.
+ *
+ * All the input a program will ever receive is buffered behind charIn before the
+ * program starts, so any further input request is denied. Values written to charOut
+ * are written to an output file, and may be echoed to the console.
+ *
+ * Observers are called synchronously by the thread running the simulation, so all
+ * IO completes before execution moves forward, without involving an event loop.
+ */
+class TermIOObserver: public AMemoryObserver
+{
+public:
+    explicit TermIOObserver(FlatMemory& memory);
+    ~TermIOObserver() override;
+
+    // AMemoryObserver interface
+    // On memory mapped input requested. Assumes there is only one memory mapped input.
+    void onInputRequested(quint16 address) override;
+    // On output written. Only writes to charOut are handled.
+    void onOutputWritten(quint16 address, quint8 value) override;
+
+    // Handle output written to address. Until called, all output is ignored.
+    void set_char_out(quint16 address);
+    // Echo the values written to charOut to the console.
+    void set_echo_charout(bool echo);
+    // Truncate file and write charOut to it. The file is closed when the observer is destroyed.
+    // Throws std::logic_error if the file can't be opened.
+    void open_output(QFileInfo file);
+    // The file opened by open_output(...), or nullptr if there is none.
+    QFile* get_output() const;
+    void flush();
+
+private:
+    FlatMemory& memory;
+    QScopedPointer<QFile> outputFile;
+    quint16 charOut = 0;
+    bool hasCharOut = false;
+    bool echo = false;
+};
+
+#endif // TERMIOOBSERVER_H
@@ -29,12 +29,15 @@
 
 #include "asmbuildhelper.h"
 #include "asmrunhelper.h"
+#include "batchrunhelper.h"
 #include "asmprogrammanager.h"
 #include "boundexecisacpu.h"
 #include "boundexecmicrocpu.h"
 #include "CLI11.hpp"
 #include "cpubuildhelper.h"
 #include "cpurunhelper.h"
+#include "cputesthelper.h"
+#include "lockstephelper.h"
 #include "termhelper.h"
 #include "mainmemory.h"
 #include "memorychips.h"
@@ -45,8 +48,10 @@
 const std::string application_description = "Translate and run Pep/9 assembly language and microcode programs.";
 const std::string asm_description = "Assemble a Pep/9 assembler source code program to object code.";
 const std::string run_description = "Run a Pep/9 object code program.";
+const std::string batch_description = "Run many Pep/9 object code programs in parallel.";
 const std::string cpuasm_description = "Check a Pep/9 microcode program for syntax errors.";
 const std::string cpurun_description = "Run a Pep/9 microcode program.";
+const std::string lockstep_description = "Check that a Pep/9 microcode program implements the instruction set.";
 
 const std::string asm_description_detailed = "The source_file must be a .pep file. \
 The object_file must be a .pepo file. \
@@ -58,6 +63,22 @@ If the program takes input, -i is required. \
 If the program produces output, -o is required. \
 As a guard against endless loops the program will abort after max_steps assembly instructions execute. \
 The default value of max_steps is %1.";
+const std::string batch_description_detailed = "The manifest_file lists one program per line as \
+<object_file> <charin_file> <expected_file>. \
+Use - in place of charin_file or expected_file if there is none. \
+Lines starting with # are ignored, and relative paths are relative to manifest_file. \
+The charOut of each program is written beside results_file, and is compared against expected_file. \
+The outcome of every program is written to results_file as JSON. \
+As a guard against endless loops each program will abort after max_steps assembly instructions execute. \
+The default value of max_steps is %1.";
+const std::string lockstep_description_detailed = "Every .pepo file in corpus_dir is run by the ISA level simulator \
+and by the Pep9Micro simulator in lockstep. After each assembly instruction the registers, status bits, \
+and the bytes of memory written by the instruction are compared, and the first difference is reported. \
+The default microcode_file is the microprogram included with Pep9Micro, \
+and the default corpus_dir contains the object code figures included with Pep9. \
+The outcome of every program is written to results_file as JSON. \
+As a guard against endless loops each program will stop after max_steps assembly instructions execute. \
+The default value of max_steps is %1.";
 const std::string cpuasm_description_detailed = "The microcode_file must be a .pepcpu file. \
 If there are micro-assembly errors, an error log file named <microcode_file>_errLog.txt is created with the error messages. \
 <microcode_file> is the name of microcode_file without the .pepcpu extension. \
@@ -71,7 +92,18 @@ If there are no errors the error log file is not created. \
 Supports 1- and 2-byte data buses with the 1-byte data bus as the default. \
 If -p is specified, then all UnitPre and UnitPost statements in microcode_file are ignored. \
 The UnitPre and UnitPost statments from precondition_file will be used instead. \
-The precondition_file must be a .pepcpu file.";
+The precondition_file must be a .pepcpu file. \
+If -s lists more than one microcode_file, names a directory, or -o is specified, \
+the unit tests of every microcode_file (and every .pepcpu file in a directory) are run in parallel. \
+Instead of writing error logs, the outcome of every test is then written to results_file, \
+as JUnit XML if results_file ends in .xml, and as JSON otherwise. \
+With --full-control the microcode is assembled with the full control section of Pep9Micro, which requires --d2. \
+As a guard against endless loops the program will then abort after max_cycles cycles execute. \
+The default value of max_cycles is %1. \
+If -x is specified, the operating system is loaded, object_file is loaded at address 0, \
+and the microcode runs the complete machine. \
+If the program takes input, -i is required. \
+If the program produces output, -c is required.";
 
 const std::string asm_input_file_text = "Input Pep/9 source program for assembler.";
 const std::string asm_output_file_text = "Output object code generated from source.";
@@ -80,22 +112,37 @@ const std::string obj_input_file_text = "Input Pep/9 object code program for sim
 const std::string charin_file_text = "File buffered behind the charIn input port.";
 const std::string charout_file_text = "File to which the charOut output port is streamed.";
 const std::string charout_echo_text = "Echo data written to charOut to std::out.";
+const std::string fast_exec_text = "Execute without collecting statistics or tracing the stack.";
+const std::string manifest_file_text = "Manifest listing the programs to run.";
+const std::string results_file_text = "File to which the outcome of each program is written.";
+const std::string corpus_dir_text = "Directory containing the object code programs to check.";
+const std::string lockstep_microcode_text = "Input Pep/9 microcode program implementing the instruction set.";
+const std::string lockstep_fuse_text = "Fuse straight-line microcode, so that the fused engine is checked.";
+const std::string thread_count_text = "Number of programs to run at once (default is one per core).";
 const std::string isaMaxStepText = "Override the default value of max_steps.";
-const std::string microMaxStepText = "Override the default value of max_steps.";
+const std::string microMaxStepText = "Override the default value of max_cycles.";
 const std::string cpuasm_input_file_text = "Input Pep/9 microcode source program for microassembler.";
 const std::string cpu_asm_log = "Override the name of the default error log file.";
 const std::string cpu_2byte = "Assemble the microcode program with a 2-byte data bus.";
 const std::string cpu_2byte_run = "Assemble and run the microcode program with a 2-byte data bus.";
 
 const std::string cpu_full_control = "Assemble the microprogram with the full control section (default is partial control section).";
+const std::string cpu_object_file_text = "Pep/9 object code program run by the microcode on top of the operating system.";
 
 const std::string cpu_preconditions = "Input Pep/9 microcode source program for microassembler.";
 const std::string cpu_run_log = "Override the name of the default error log file.";
+const std::string cpurun_input_file_text = "Input Pep/9 microcode source programs, or directories of them, to be tested.";
+const std::string cpurun_results_file_text = "File to which the outcome of each unit test is written.";
 
 struct command_line_values {
-    bool had_version{false}, had_about{false}, had_d2{false}, had_full_control{false}, had_echo_output{false};
-    std::string e{}, s{}, o{}, i{}, mc{}, p{};
+    bool had_version{false}, had_about{false}, had_d2{false}, had_full_control{false}, had_echo_output{false}, had_fast{false};
+    bool had_fuse{false};
+    std::string e{}, s{}, o{}, i{}, c{}, mc{}, p{}, d{};
+    // Object code file run by cpurun, which must not share s with the ISA level subcommands.
+    std::string x{};
+    std::vector<std::string> mcs{};
     uint64_t m{2500};
+    int j{0};
 };
 
 void handle_full_control(command_line_values&, bool use_full_control);
@@ -104,8 +151,10 @@ void handle_version(command_line_values&, int64_t);
 void handle_about(command_line_values&, int64_t);
 void handle_asm(command_line_values&, QRunnable**);
 void handle_run(command_line_values&, QRunnable**);
+void handle_batch(command_line_values&, QRunnable**);
 void handle_cpuasm(command_line_values&, QRunnable**);
 void handle_cpurun(command_line_values&, QRunnable**);
+void handle_lockstep(command_line_values&, QRunnable**);
 
 int main(int argc, char *argv[])
 {
@@ -181,6 +230,7 @@ int main(int argc, char *argv[])
     run_subcommand->add_option("-o", values.o, charout_file_text)->expected(1);
     parameter_formatting["run"]["o"] = "charout_file";
     run_subcommand->add_flag("--echo-output", values.had_echo_output, charout_echo_text);
+    run_subcommand->add_flag("--fast", values.had_fast, fast_exec_text);
     //run_subcommand->add_option("-e", obj_input_file_text);
     // Maximum number of instructions to be executed.
     std::string max_steps_text = isaMaxStepText;
@@ -193,6 +243,26 @@ int main(int argc, char *argv[])
     // Create a runnable application from command line arguments
     run_subcommand->callback(std::function<void()>([&](){handle_run(values, &run);}));
 
+    // Subcommands for BATCH
+    parameter_formatting.insert_or_assign("batch", std::map<std::string,std::string>());
+    auto batch_subcommand = parser.add_subcommand("batch", batch_description);
+    detailed_descriptions["batch"] = QString::fromStdString(batch_description_detailed).arg(BoundExecIsaCpu::getDefaultMaxSteps()).toStdString();
+    // File listing the programs to be run.
+    batch_subcommand->add_option("-s", values.s, manifest_file_text)->expected(1)->required(true);
+    parameter_formatting["batch"]["s"] = "manifest_file";
+    // File where the outcome of each program will be stored.
+    batch_subcommand->add_option("-o", values.o, results_file_text)->expected(1)->required(true);
+    parameter_formatting["batch"]["o"] = "results_file";
+    batch_subcommand->add_flag("--fast", values.had_fast, fast_exec_text);
+    // Maximum number of instructions to be executed by each program.
+    batch_subcommand->add_option("-m", values.m, max_steps_text)->expected(1)->check(CLI::PositiveNumber)
+            ->default_val(std::to_string(BoundExecIsaCpu::getDefaultMaxSteps()));
+    parameter_formatting["batch"]["m"] = "max_steps";
+    batch_subcommand->add_option("-j", values.j, thread_count_text)->expected(1)->check(CLI::PositiveNumber);
+    parameter_formatting["batch"]["j"] = "thread_count";
+    // Create a runnable application from command line arguments
+    batch_subcommand->callback(std::function<void()>([&](){handle_batch(values, &run);}));
+
     // Subcommands for CPUASM
     parameter_formatting.insert_or_assign("cpuasm", std::map<std::string,std::string>());
     auto cpuasm_subcommand = parser.add_subcommand("cpuasm", cpuasm_description);
@@ -214,27 +284,68 @@ int main(int argc, char *argv[])
     // Subcommands for CPURUN
     parameter_formatting.insert_or_assign("cpurun", std::map<std::string,std::string>());
     auto cpurun_subcommand = parser.add_subcommand("cpurun", cpurun_description);
-    detailed_descriptions["cpurun"] = cpurun_description_detailed;
+    detailed_descriptions["cpurun"] = QString::fromStdString(cpurun_description_detailed).arg(BoundExecMicroCpu::getDefaultMaxCycles()).toStdString();
     // File where errors will be written. By default, will be written to a file based on the mc name.
     cpurun_subcommand->add_option("-e", values.e, cpu_run_log)->expected(1);
     parameter_formatting["cpurun"]["e"] = "error_file";
     // Add flags to select 1-byte or 2-byte CPU data bus.
     auto cpurun_d2_flag = cpurun_subcommand->add_flag("--d2", [&](int64_t){handle_databus_size(values, true);}, cpu_2byte_run);
     // Allow full control section to be enabled iff 2-byte data bus is enabled.
-    //auto cpurun_full_ctrl_flag = cpurun_subcommand->add_flag("--full-control",[&](int64_t){handle_full_control(values, true);}, cpu_full_control);
-    //cpurun_full_ctrl_flag->needs(cpurun_d2_flag);
+    auto cpurun_full_ctrl_flag = cpurun_subcommand->add_flag("--full-control",[&](int64_t){handle_full_control(values, true);}, cpu_full_control);
+    cpurun_full_ctrl_flag->needs(cpurun_d2_flag);
     // Maximum number of cycles to be executed.
-    //std::string max_cycles_text = QString::fromStdString(microMaxStepText).arg(BoundExecMicroCpu::getDefaultMaxCycles()).toStdString();
-    //cpurun_subcommand->add_option("-m", values.m, max_cycles_text)->expected(1)->needs(cpurun_full_ctrl_flag)->check(CLI::PositiveNumber)
-            //->default_val(std::to_string(BoundExecMicroCpu::getDefaultMaxCycles()));
+    std::string max_cycles_text = microMaxStepText;
+    auto cpurun_max_cycles = cpurun_subcommand->add_option("-m", values.m, max_cycles_text)->expected(1)->needs(cpurun_full_ctrl_flag)->check(CLI::PositiveNumber)
+            ->default_val(std::to_string(BoundExecMicroCpu::getDefaultMaxCycles()));
+    parameter_formatting["cpurun"]["m"] = "max_cycles";
+    // Object code program to be run by the microcode on top of the operating system.
+    auto cpurun_object_file = cpurun_subcommand->add_option("-x", values.x, cpu_object_file_text)->expected(1)->needs(cpurun_full_ctrl_flag);
+    parameter_formatting["cpurun"]["x"] = "object_file";
+    cpurun_subcommand->add_option("-i", values.i, charin_file_text)->expected(1)->needs(cpurun_object_file);
+    parameter_formatting["cpurun"]["i"] = "charin_file";
+    cpurun_subcommand->add_option("-c", values.c, charout_file_text)->expected(1)->needs(cpurun_object_file);
+    parameter_formatting["cpurun"]["c"] = "charout_file";
+    cpurun_subcommand->add_flag("--echo-output", values.had_echo_output, charout_echo_text)->needs(cpurun_object_file);
     // Precondition input file.
     cpurun_subcommand->add_option("-p", values.p, cpu_preconditions)->expected(1);
     parameter_formatting["cpurun"]["p"] = "precondition_file";
     // Microcode input file.
-    cpurun_subcommand->add_option("-s", values.mc, cpuasm_input_file_text)->expected(1)->required(true);
+    cpurun_subcommand->add_option("-s", values.mcs, cpurun_input_file_text)->expected(1, -1)->required(true);
     parameter_formatting["cpurun"]["s"] = "microcode_file";
+    // File where the outcome of each unit test will be stored.
+    cpurun_subcommand->add_option("-o", values.o, cpurun_results_file_text)->expected(1);
+    parameter_formatting["cpurun"]["o"] = "results_file";
+    cpurun_subcommand->add_option("-j", values.j, thread_count_text)->expected(1)->check(CLI::PositiveNumber);
+    parameter_formatting["cpurun"]["j"] = "thread_count";
+    // Create a runnable application from command line arguments
+    cpurun_subcommand->callback(std::function<void()>([&](){
+        // The default value of max_steps is shared with the ISA level subcommands, so replace it.
+        if(cpurun_max_cycles->count() == 0) values.m = BoundExecMicroCpu::getDefaultMaxCycles();
+        handle_cpurun(values, &run);
+    }));
+
+    // Subcommands for LOCKSTEP
+    parameter_formatting.insert_or_assign("lockstep", std::map<std::string,std::string>());
+    auto lockstep_subcommand = parser.add_subcommand("lockstep", lockstep_description);
+    detailed_descriptions["lockstep"] = QString::fromStdString(lockstep_description_detailed).arg(BoundExecIsaCpu::getDefaultMaxSteps()).toStdString();
+    // Microprogram to be checked.
+    lockstep_subcommand->add_option("-s", values.mc, lockstep_microcode_text)->expected(1);
+    parameter_formatting["lockstep"]["s"] = "microcode_file";
+    // Directory of programs to be checked.
+    lockstep_subcommand->add_option("-d", values.d, corpus_dir_text)->expected(1);
+    parameter_formatting["lockstep"]["d"] = "corpus_dir";
+    // File where the outcome of each program will be stored.
+    lockstep_subcommand->add_option("-o", values.o, results_file_text)->expected(1)->required(true);
+    parameter_formatting["lockstep"]["o"] = "results_file";
+    lockstep_subcommand->add_flag("--fuse", values.had_fuse, lockstep_fuse_text);
+    // Maximum number of instructions to be checked for each program.
+    lockstep_subcommand->add_option("-m", values.m, max_steps_text)->expected(1)->check(CLI::PositiveNumber)
+            ->default_val(std::to_string(BoundExecIsaCpu::getDefaultMaxSteps()));
+    parameter_formatting["lockstep"]["m"] = "max_steps";
+    lockstep_subcommand->add_option("-j", values.j, thread_count_text)->expected(1)->check(CLI::PositiveNumber);
+    parameter_formatting["lockstep"]["j"] = "thread_count";
     // Create a runnable application from command line arguments
-    cpurun_subcommand->callback(std::function<void()>([&](){handle_cpurun(values, &run);}));
+    lockstep_subcommand->callback(std::function<void()>([&](){handle_lockstep(values, &run);}));
 
     // Require that one of the modes be used.
     parser.require_subcommand();
@@ -375,11 +486,52 @@ void handle_run(command_line_values &values, QRunnable **runnable)
     ASMRunHelper *helper = new ASMRunHelper(objText, stepMaxValue, textOutputFileName,
                                       textInputFileName, *AsmProgramManager::getInstance());
     helper->set_echo_charout(values.had_echo_output);
+    helper->set_fast_execution(values.had_fast);
     QObject::connect(helper, &ASMRunHelper::finished, QCoreApplication::instance(), &QCoreApplication::quit);
 
     (*runnable) = helper;
 }
 
+void handle_batch(command_line_values &values, QRunnable **runnable)
+{
+    // Needs a manifest to be well defined.
+    if(values.s.empty()) {
+        throw CLI::ValidationError("Must set manifest input (-s).", -1);
+    }
+    // Needs a results file.
+    else if(values.o.empty()) {
+        throw CLI::ValidationError("Must set results file (-o).", -1);
+    }
+
+    // File names associated with cli parameters.
+    QFileInfo manifestFileInfo(QString::fromStdString(values.s));
+    QFileInfo resultsFileInfo(QString::fromStdString(values.o));
+
+    // Load manifest from file if possible, else print error log.
+    QFile manifestFile(manifestFileInfo.absoluteFilePath());
+    if(!manifestFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        throw CLI::ValidationError(errLogOpenErr.arg(manifestFile.fileName()).toStdString(), -1);
+    }
+    QTextStream manifestStream(&manifestFile);
+    QString manifestText = manifestStream.readAll();
+    manifestFile.close();
+
+    QList<BatchRunHelper::Job> jobs;
+    QString errorMessage;
+    if(!BatchRunHelper::parseManifest(manifestText, manifestFileInfo.absoluteDir(),
+                                      resultsFileInfo, jobs, errorMessage)) {
+        throw CLI::ValidationError(errorMessage.toStdString(), -1);
+    }
+
+    BatchRunHelper *helper = new BatchRunHelper(jobs, resultsFileInfo, values.m,
+                                                *AsmProgramManager::getInstance());
+    helper->set_fast_execution(values.had_fast);
+    helper->set_thread_count(values.j);
+    QObject::connect(helper, &BatchRunHelper::finished, QCoreApplication::instance(), &QCoreApplication::quit);
+
+    (*runnable) = helper;
+}
+
 void handle_cpuasm(command_line_values &values, QRunnable **runnable)
 {
     // Needs a microcode source program to be well defined.
@@ -410,7 +562,7 @@ void handle_cpuasm(command_line_values &values, QRunnable **runnable)
     else {
         // Otherwise read the file.
         QTextStream sourceStream(&sourceFile);
-        // Must remove line numbers, on microassembler will raise spurious errors.
+        // Must remove line numbers, or microassembler will raise spurious errors.
         sourceText = Pep::removeCycleNumbers(sourceStream.readAll());
         sourceFile.close();
 
@@ -427,7 +579,7 @@ void handle_cpuasm(command_line_values &values, QRunnable **runnable)
 void handle_cpurun(command_line_values &values, QRunnable **run)
 {
     // Needs a microcode source program to be well defined.
-    if(values.mc.empty()) {
+    if(values.mcs.empty()) {
         //qDebug() << "Must set microcode input (--mc).";
         throw CLI::ValidationError("Must set microcode input (--mc).", -1);
     }
@@ -441,24 +593,10 @@ void handle_cpurun(command_line_values &values, QRunnable **run)
     // Enable or disable full control section features depending on passed flags.
     Pep::initMicroEnumMnemonMaps(type, values.had_full_control);
 
-    // Microcode input file and unit test output file.
-    QString microcodeFileName = QString::fromStdString(values.mc);
-
-    // Load object code string from file if possible, else print error log.
-    QFile microcodeFile(microcodeFileName);
-    if(!microcodeFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        //qDebug().noquote() << errLogOpenErr.arg(microcodeFile.fileName());
-        throw CLI::ValidationError(errLogOpenErr.arg(microcodeFile.fileName()).toStdString(), -1);
-    }
-
-    QTextStream microprogramStream(&microcodeFile);
-    QString microprogramText = Pep::removeCycleNumbers(microprogramStream.readAll());
-    microcodeFile.close();
-
     // Load overriding preconditions if present.
     QString preconditionText;
-    if(!values.mc.empty()) {
-        QString preconditionFileName = QString::fromStdString(values.mc);
+    if(!values.p.empty()) {
+        QString preconditionFileName = QString::fromStdString(values.p);
         QFile preconditionFile(preconditionFileName);
         // If passed precondition file that can't be opened, raise an error.
         if(!preconditionFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
@@ -471,6 +609,45 @@ void handle_cpurun(command_line_values &values, QRunnable **run)
         preconditionFile.close();
     }
 
+    // Test many programs at once, reporting to a results file instead of error logs.
+    if(values.mcs.size() > 1 || !values.o.empty() || QFileInfo(QString::fromStdString(values.mcs[0])).isDir()) {
+        if(!values.x.empty()) {
+            throw CLI::ValidationError("An object code program (-x) may only be run by a single microcode program.", -1);
+        }
+        if(values.o.empty()) {
+            throw CLI::ValidationError("Must set results file (-o) when testing multiple programs.", -1);
+        }
+        QStringList paths;
+        for(auto path : values.mcs) {
+            paths.append(QString::fromStdString(path));
+        }
+        auto jobs = CPUTestHelper::collectJobs(paths);
+        CPUTestHelper *helper = new CPUTestHelper(jobs, type, preconditionText,
+                                                  QFileInfo(QString::fromStdString(values.o)));
+        helper->set_thread_count(values.j);
+        if(values.had_full_control) {
+            helper->set_full_control(values.m);
+        }
+        QObject::connect(helper, &CPUTestHelper::finished, QCoreApplication::instance(), &QCoreApplication::quit);
+        (*run) = helper;
+        return;
+    }
+    values.mc = values.mcs[0];
+
+    // Microcode input file and unit test output file.
+    QString microcodeFileName = QString::fromStdString(values.mc);
+
+    // Load object code string from file if possible, else print error log.
+    QFile microcodeFile(microcodeFileName);
+    if(!microcodeFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        //qDebug().noquote() << errLogOpenErr.arg(microcodeFile.fileName());
+        throw CLI::ValidationError(errLogOpenErr.arg(microcodeFile.fileName()).toStdString(), -1);
+    }
+
+    QTextStream microprogramStream(&microcodeFile);
+    QString microprogramText = Pep::removeCycleNumbers(microprogramStream.readAll());
+    microcodeFile.close();
+
     // If not using the full control section, use the non-branch enabled CPU simulator.
     if(!values.had_full_control) {
         CPURunHelper *helper = new CPURunHelper(type, microprogramText,
@@ -496,8 +673,71 @@ void handle_cpurun(command_line_values &values, QRunnable **run)
             helper->set_error_file(QString::fromStdString(values.e));
         }
 
+        // Run an object code program on top of the operating system if present.
+        if(!values.x.empty()) {
+            QFile objectFile(QString::fromStdString(values.x));
+            if(!objectFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+                throw CLI::ValidationError(errLogOpenErr.arg(objectFile.fileName()).toStdString(), -1);
+            }
+            QTextStream objectStream(&objectFile);
+            helper->set_object_code(objectStream.readAll());
+            objectFile.close();
+            if(!values.i.empty()) {
+                helper->set_program_input(QFileInfo(QString::fromStdString(values.i)));
+            }
+            if(!values.c.empty()) {
+                helper->set_program_output(QFileInfo(QString::fromStdString(values.c)));
+            }
+            helper->set_echo_charout(values.had_echo_output);
+        }
+
         QObject::connect(helper, &MicroStepHelper::finished, QCoreApplication::instance(), &QCoreApplication::quit);
         (*run) = helper;
 
     }
 }
+
+void handle_lockstep(command_line_values &values, QRunnable **runnable)
+{
+    // Needs a results file.
+    if(values.o.empty()) {
+        throw CLI::ValidationError("Must set results file (-o).", -1);
+    }
+
+    // The instruction set is implemented by the full control section on a two byte data bus.
+    Pep::initMicroEnumMnemonMaps(Enu::CPUType::TwoByteDataBus, true);
+
+    // Default to the microprogram shipped with Pep9Micro.
+    QString microprogramText;
+    if(values.mc.empty()) {
+        microprogramText = Pep::resToString(":/help-micro/pep9micro.pepmicro", false);
+    }
+    else {
+        QFile microcodeFile(QString::fromStdString(values.mc));
+        if(!microcodeFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            throw CLI::ValidationError(errLogOpenErr.arg(microcodeFile.fileName()).toStdString(), -1);
+        }
+        QTextStream microprogramStream(&microcodeFile);
+        microprogramText = microprogramStream.readAll();
+        microcodeFile.close();
+    }
+    // Must remove line numbers, or microassembler will raise spurious errors.
+    microprogramText = Pep::removeCycleNumbers(microprogramText);
+
+    // Default to the object code figures shipped with Pep9.
+    QDir corpusDir(values.d.empty() ? ":/help-asm/figures" : QString::fromStdString(values.d));
+    if(!corpusDir.exists()) {
+        throw CLI::ValidationError(QString("Corpus directory %1 does not exist.")
+                                   .arg(corpusDir.path()).toStdString(), -1);
+    }
+    auto jobs = LockstepHelper::collectCorpus(corpusDir);
+
+    LockstepHelper *helper = new LockstepHelper(jobs, microprogramText,
+                                                QFileInfo(QString::fromStdString(values.o)),
+                                                values.m, *AsmProgramManager::getInstance());
+    helper->set_block_fusion(values.had_fuse);
+    helper->set_thread_count(values.j);
+    QObject::connect(helper, &LockstepHelper::finished, QCoreApplication::instance(), &QCoreApplication::quit);
+
+    (*runnable) = helper;
+}